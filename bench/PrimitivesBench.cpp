@@ -0,0 +1,370 @@
+/**
+ * @file PrimitivesBench.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 7:20:41 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: PrimitivesBench.cpp
+ * File Created: Saturday, 17th October 2026 7:20:41 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 7:20:41 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "OmegaUARTController/Capture.hpp"
+#include "OmegaUARTController/Checksum.hpp"
+#include "OmegaUARTController/Framing.hpp"
+#include "OmegaUARTController/SlotMap.hpp"
+#include "OmegaUARTController/TimerWheel.hpp"
+
+using namespace Omega::UART;
+
+namespace
+{
+    std::vector<u8> random_bytes(size_t in_size, u32 in_seed)
+    {
+        std::mt19937 rng{in_seed};
+        std::vector<u8> bytes(in_size);
+        for (auto &byte : bytes)
+        {
+            byte = static_cast<u8>(rng());
+        }
+        return bytes;
+    }
+
+    // 64 KiB worth of encoded frames carrying in_payload_size byte payloads
+    std::vector<u8> encoded_stream(const Framing::FrameEncoding &in_encoding, size_t in_payload_size)
+    {
+        auto payload = random_bytes(in_payload_size, 1);
+        if (Framing::FrameFormat::eDELIMITER == in_encoding.format)
+        {
+            std::replace(payload.begin(), payload.end(), in_encoding.delimiter, static_cast<u8>(in_encoding.delimiter + 1));
+        }
+        std::vector<u8> frame(Framing::max_encoded_size(in_encoding, payload.size()));
+        frame.resize(Framing::encode(in_encoding, payload.data(), payload.size(), frame.data()));
+        std::vector<u8> stream;
+        while (stream.size() < (64 << 10))
+        {
+            stream.insert(stream.end(), frame.begin(), frame.end());
+        }
+        return stream;
+    }
+} // namespace
+
+/* START: FRAMING */
+// Decoding a stream arriving in 256 byte reads, per format and payload size
+static void BM_FrameDecode(benchmark::State &io_state)
+{
+    const Framing::FrameEncoding encoding{.format = static_cast<Framing::FrameFormat>(io_state.range(0))};
+    const auto stream = encoded_stream(encoding, io_state.range(1));
+    size_t frames = 0;
+    auto decoder = Framing::make_decoder(encoding, 4096, [&frames](const u8 *, const size_t)
+                                         { frames++; });
+    for (auto _ : io_state)
+    {
+        for (size_t offset = 0; offset < stream.size(); offset += 256)
+        {
+            decoder->feed(stream.data() + offset, std::min<size_t>(256, stream.size() - offset));
+        }
+    }
+    benchmark::DoNotOptimize(frames);
+    io_state.SetBytesProcessed(io_state.iterations() * stream.size());
+}
+BENCHMARK(BM_FrameDecode)->ArgsProduct({{0, 1, 2, 3}, {16, 256, 2048}})->ArgNames({"format", "payload"});
+
+// The byte-at-a-time delimiter split the framing decoders replace, as the baseline for BM_FrameDecode/format:2
+static void BM_FrameDecodeBytewise(benchmark::State &io_state)
+{
+    const Framing::FrameEncoding encoding{.format = Framing::FrameFormat::eDELIMITER};
+    const auto stream = encoded_stream(encoding, io_state.range(0));
+    std::vector<u8> frame;
+    frame.reserve(4096);
+    size_t frames = 0;
+    for (auto _ : io_state)
+    {
+        for (const u8 byte : stream)
+        {
+            if (encoding.delimiter == byte)
+            {
+                frames++;
+                frame.clear();
+            }
+            else
+            {
+                frame.push_back(byte);
+            }
+        }
+    }
+    benchmark::DoNotOptimize(frames);
+    io_state.SetBytesProcessed(io_state.iterations() * stream.size());
+}
+BENCHMARK(BM_FrameDecodeBytewise)->Arg(16)->Arg(256)->Arg(2048)->ArgName("payload");
+/* END: FRAMING */
+
+/* START: CHECKSUM */
+static void BM_Crc(benchmark::State &io_state)
+{
+    const auto algorithm = static_cast<Checksum::Algorithm>(io_state.range(0));
+    const auto kernel = static_cast<Checksum::Kernel>(io_state.range(1));
+    if (!Checksum::is_supported(algorithm, kernel))
+    {
+        io_state.SkipWithError("kernel not supported for this algorithm or CPU");
+        return;
+    }
+    const auto data = random_bytes(io_state.range(2), 2);
+    Checksum::Crc crc{algorithm, kernel};
+    for (auto _ : io_state)
+    {
+        crc.update(data.data(), data.size());
+        benchmark::DoNotOptimize(crc.value());
+    }
+    io_state.SetBytesProcessed(io_state.iterations() * data.size());
+}
+BENCHMARK(BM_Crc)->ArgsProduct({{0, 1, 2, 3, 4}, {1, 2, 3}, {64, 4096}})->ArgNames({"algorithm", "kernel", "size"});
+/* END: CHECKSUM */
+
+/* START: HANDLE RESOLUTION */
+namespace
+{
+    struct alignas(64) FakePort
+    {
+        u64 m_value{0};
+    };
+    constexpr size_t RESOLVED_PORTS{64};
+} // namespace
+
+static void BM_HandlePin(benchmark::State &io_state)
+{
+    static SlotMap<FakePort> s_ports;
+    static std::vector<u64> s_handles;
+    if (0 == io_state.thread_index() && s_handles.empty())
+    {
+        for (size_t idx = 0; idx < RESOLVED_PORTS; ++idx)
+        {
+            s_handles.push_back(s_ports.emplace());
+        }
+    }
+    size_t next = 0;
+    for (auto _ : io_state)
+    {
+        auto pinned = s_ports.pin(s_handles[next++ % RESOLVED_PORTS]);
+        benchmark::DoNotOptimize(pinned->m_value);
+    }
+}
+BENCHMARK(BM_HandlePin)->ThreadRange(1, 8);
+
+// The mutex guarded hash map the slot map replaced
+static void BM_HandleHashMap(benchmark::State &io_state)
+{
+    static std::mutex s_mutex;
+    static std::unordered_map<u64, FakePort> s_ports;
+    if (0 == io_state.thread_index() && s_ports.empty())
+    {
+        for (u64 handle = 1; handle <= RESOLVED_PORTS; ++handle)
+        {
+            s_ports[handle];
+        }
+    }
+    size_t next = 0;
+    for (auto _ : io_state)
+    {
+        std::lock_guard lock{s_mutex};
+        benchmark::DoNotOptimize(s_ports.find(next++ % RESOLVED_PORTS + 1)->second.m_value);
+    }
+}
+BENCHMARK(BM_HandleHashMap)->ThreadRange(1, 8);
+/* END: HANDLE RESOLUTION */
+
+/* START: TIMERS */
+namespace
+{
+    // Operation timeouts between 1 ms and 1 s, on a 1 ms tick
+    constexpr u64 TIMEOUT_SPAN{1000};
+
+    struct FakeTimer : TimerHook
+    {
+        std::multimap<u64, FakeTimer *>::iterator m_entry;
+    };
+} // namespace
+
+// Arming and disarming one timeout while in_resident others are pending
+static void BM_TimerWheelSchedule(benchmark::State &io_state)
+{
+    TimerWheel<> wheel;
+    std::mt19937_64 rng{1};
+    std::vector<FakeTimer> resident(io_state.range(0));
+    for (auto &timer : resident)
+    {
+        wheel.schedule(timer, 1 + rng() % TIMEOUT_SPAN);
+    }
+    FakeTimer probe;
+    for (auto _ : io_state)
+    {
+        wheel.schedule(probe, 1 + rng() % TIMEOUT_SPAN);
+        wheel.cancel(probe);
+    }
+}
+BENCHMARK(BM_TimerWheelSchedule)->RangeMultiplier(10)->Range(100, 1000000)->ArgName("timers");
+
+// The ordered map the async loop kept its deadlines in before
+static void BM_TimerMultimapSchedule(benchmark::State &io_state)
+{
+    std::multimap<u64, FakeTimer *> deadlines;
+    std::mt19937_64 rng{1};
+    std::vector<FakeTimer> resident(io_state.range(0));
+    for (auto &timer : resident)
+    {
+        timer.m_entry = deadlines.emplace(1 + rng() % TIMEOUT_SPAN, &timer);
+    }
+    FakeTimer probe;
+    for (auto _ : io_state)
+    {
+        probe.m_entry = deadlines.emplace(1 + rng() % TIMEOUT_SPAN, &probe);
+        deadlines.erase(probe.m_entry);
+    }
+}
+BENCHMARK(BM_TimerMultimapSchedule)->RangeMultiplier(10)->Range(100, 1000000)->ArgName("timers");
+
+// One tick at a time with every timer re-armed as it expires, so items are expiries and their cost should not grow with
+// the number pending
+static void BM_TimerWheelExpire(benchmark::State &io_state)
+{
+    TimerWheel<> wheel;
+    std::mt19937_64 rng{1};
+    std::vector<FakeTimer> resident(io_state.range(0));
+    for (auto &timer : resident)
+    {
+        wheel.schedule(timer, 1 + rng() % TIMEOUT_SPAN);
+    }
+    size_t expired = 0;
+    for (auto _ : io_state)
+    {
+        expired += wheel.advance(wheel.now() + 1, [&wheel, &rng](TimerHook &io_timer)
+                                 { wheel.schedule(io_timer, wheel.now() + 1 + rng() % TIMEOUT_SPAN); });
+    }
+    io_state.SetItemsProcessed(expired);
+}
+BENCHMARK(BM_TimerWheelExpire)->RangeMultiplier(10)->Range(100, 1000000)->ArgName("timers");
+
+static void BM_TimerMultimapExpire(benchmark::State &io_state)
+{
+    std::multimap<u64, FakeTimer *> deadlines;
+    std::mt19937_64 rng{1};
+    std::vector<FakeTimer> resident(io_state.range(0));
+    for (auto &timer : resident)
+    {
+        timer.m_entry = deadlines.emplace(1 + rng() % TIMEOUT_SPAN, &timer);
+    }
+    u64 now = 0;
+    size_t expired = 0;
+    for (auto _ : io_state)
+    {
+        now++;
+        while (deadlines.begin()->first <= now)
+        {
+            auto *timer = deadlines.begin()->second;
+            deadlines.erase(deadlines.begin());
+            timer->m_entry = deadlines.emplace(now + 1 + rng() % TIMEOUT_SPAN, timer);
+            expired++;
+        }
+    }
+    io_state.SetItemsProcessed(expired);
+}
+BENCHMARK(BM_TimerMultimapExpire)->RangeMultiplier(10)->Range(100, 1000000)->ArgName("timers");
+/* END: TIMERS */
+
+/* START: CAPTURE */
+namespace
+{
+    std::string capture_path()
+    {
+        return (std::filesystem::temp_directory_path() / "OmegaUARTControllerBench.capture").string();
+    }
+} // namespace
+
+// Appending in_chunk byte RX chunks to a capture
+static void BM_CaptureAppend(benchmark::State &io_state)
+{
+    const auto chunk = random_bytes(io_state.range(0), 1);
+    const auto path = capture_path();
+    auto writer = Capture::Writer::create(path.c_str());
+    if (nullptr == writer)
+    {
+        io_state.SkipWithError("could not create the capture");
+        return;
+    }
+    const u16 port = writer->add_port("bench");
+    u64 timestamp_us = 0;
+    for (auto _ : io_state)
+    {
+        (void)writer->append(port, Capture::Direction::eRX, chunk.data(), chunk.size(), ++timestamp_us);
+    }
+    io_state.SetBytesProcessed(io_state.iterations() * chunk.size());
+    writer.reset();
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_CaptureAppend)->Arg(16)->Arg(256)->Arg(4096)->ArgName("chunk");
+
+// Replaying a capture of 16 MiB of delimited frames, read 256 bytes at a time, into a decoder as fast as possible: the
+// decoder's throughput with the capture's overhead on top
+static void BM_CaptureReplayDecode(benchmark::State &io_state)
+{
+    const Framing::FrameEncoding encoding{.format = Framing::FrameFormat::eDELIMITER};
+    const auto stream = encoded_stream(encoding, io_state.range(0));
+    const auto path = capture_path();
+    {
+        auto writer = Capture::Writer::create(path.c_str());
+        if (nullptr == writer)
+        {
+            io_state.SkipWithError("could not create the capture");
+            return;
+        }
+        const u16 port = writer->add_port("bench");
+        u64 timestamp_us = 0;
+        for (size_t repeat = 0; repeat < 256; ++repeat)
+        {
+            for (size_t offset = 0; offset < stream.size(); offset += 256)
+            {
+                (void)writer->append(port, Capture::Direction::eRX, stream.data() + offset, std::min<size_t>(256, stream.size() - offset), ++timestamp_us);
+            }
+        }
+    }
+    auto reader = Capture::Reader::open(path.c_str());
+    size_t frames = 0;
+    auto decoder = Framing::make_decoder(encoding, 4096, [&frames](const u8 *, const size_t)
+                                         { frames++; });
+    Capture::Replayer replayer{*reader};
+    replayer.add_on_read_callback(0, 0, [&decoder](const Handle, const u8 *in_data, const size_t in_size)
+                                  { decoder->feed(in_data, in_size); });
+    u64 bytes = 0;
+    for (auto _ : io_state)
+    {
+        reader->rewind();
+        bytes += replayer.run().bytes;
+    }
+    benchmark::DoNotOptimize(frames);
+    io_state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    reader.reset();
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_CaptureReplayDecode)->Arg(16)->Arg(256)->Arg(2048)->ArgName("payload");
+/* END: CAPTURE */
@@ -0,0 +1,158 @@
+/**
+ * @file PtyLoopback.hpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 7:20:41 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: PtyLoopback.hpp
+ * File Created: Saturday, 17th October 2026 7:20:41 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 7:20:41 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace Bench
+        {
+            // A pty pair standing in for a serial link: the library opens the slave by name, the benchmark drives the master.
+            // The slave stays open here as well so the pair survives the library closing and reopening it
+            class PtyLoopback
+            {
+            public:
+                PtyLoopback()
+                {
+                    if (-1 == openpty(&m_master, &m_slave, m_name, nullptr, nullptr))
+                    {
+                        return;
+                    }
+                    termios termios_config{};
+                    tcgetattr(m_master, &termios_config);
+                    cfmakeraw(&termios_config);
+                    tcsetattr(m_master, TCSANOW, &termios_config);
+                    fcntl(m_master, F_SETFL, fcntl(m_master, F_GETFL) | O_NONBLOCK);
+                }
+                ~PtyLoopback()
+                {
+                    if (-1 != m_master)
+                    {
+                        close(m_master);
+                        close(m_slave);
+                    }
+                }
+                PtyLoopback(const PtyLoopback &) = delete;
+                PtyLoopback &operator=(const PtyLoopback &) = delete;
+
+                bool valid() const { return -1 != m_master; }
+                const char *name() const { return m_name; }
+                int master() const { return m_master; }
+
+                // Pushes all of in_data into the master side, waiting for room when the slave's input buffer is full
+                bool send(const u8 *in_data, size_t in_size) const
+                {
+                    while (0 < in_size)
+                    {
+                        if (const ssize_t written = ::write(m_master, in_data, in_size); 0 < written)
+                        {
+                            in_data += written;
+                            in_size -= written;
+                        }
+                        else if (!wait(POLLOUT))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                // Collects exactly in_size bytes written by the library
+                bool receive(u8 *out_data, size_t in_size) const
+                {
+                    while (0 < in_size)
+                    {
+                        if (const ssize_t read_bytes = ::read(m_master, out_data, in_size); 0 < read_bytes)
+                        {
+                            out_data += read_bytes;
+                            in_size -= read_bytes;
+                        }
+                        else if (!wait(POLLIN))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                // Throws away whatever the library wrote so far
+                void drain() const
+                {
+                    u8 discard[4096];
+                    while (0 < ::read(m_master, discard, sizeof(discard)))
+                    {
+                    }
+                }
+
+            private:
+                bool wait(short in_events) const
+                {
+                    pollfd poll_fd{.fd = m_master, .events = in_events, .revents = 0};
+                    return 0 < poll(&poll_fd, 1, 1000);
+                }
+
+                int m_master{-1};
+                int m_slave{-1};
+                char m_name[64]{0};
+            };
+
+            // Runs in_body on a background thread until the owner goes out of scope
+            class BackgroundLoop
+            {
+            public:
+                template <typename Body>
+                explicit BackgroundLoop(Body in_body)
+                    : m_thread{[this, in_body]
+                               {
+                                   while (m_running.load(std::memory_order_relaxed))
+                                   {
+                                       in_body();
+                                   }
+                               }}
+                {
+                }
+                ~BackgroundLoop()
+                {
+                    m_running.store(false, std::memory_order_relaxed);
+                    m_thread.join();
+                }
+
+            private:
+                std::atomic<bool> m_running{true};
+                std::thread m_thread;
+            };
+        } // namespace Bench
+    } // namespace UART
+} // namespace Omega
@@ -0,0 +1,1023 @@
+/**
+ * @file UARTBench.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 7:20:41 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: UARTBench.cpp
+ * File Created: Saturday, 17th October 2026 7:20:41 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 7:20:41 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+
+#include <benchmark/benchmark.h>
+
+#include "OmegaUARTController/Aggregator.hpp"
+#include "OmegaUARTController/Async.hpp"
+#include "OmegaUARTController/Checksum.hpp"
+#include "OmegaUARTController/Dispatch.hpp"
+#include "OmegaUARTController/Modbus.hpp"
+#include "OmegaUARTController/Transaction.hpp"
+#include "OmegaUARTController/UARTController.hpp"
+
+#include "PtyLoopback.hpp"
+
+using namespace Omega::UART;
+using Omega::UART::Bench::BackgroundLoop;
+using Omega::UART::Bench::PtyLoopback;
+
+namespace
+{
+    constexpr u32 TIMEOUT_MS{1000};
+
+    // A pty pair with the library's handle on its slave side
+    struct LoopbackPort
+    {
+        PtyLoopback pty;
+        Handle handle{0};
+
+        LoopbackPort() : handle{pty.valid() ? init(pty.name(), 115200) : 0} {}
+        ~LoopbackPort()
+        {
+            if (0 != handle)
+            {
+                (void)deinit(handle);
+            }
+        }
+    };
+
+    std::vector<std::unique_ptr<LoopbackPort>> open_ports(benchmark::State &io_state, size_t in_count)
+    {
+        std::vector<std::unique_ptr<LoopbackPort>> ports;
+        for (size_t idx = 0; idx < in_count; ++idx)
+        {
+            auto &port = ports.emplace_back(std::make_unique<LoopbackPort>());
+            if (0 == port->handle)
+            {
+                io_state.SkipWithError("could not open a pty loopback");
+                ports.clear();
+                break;
+            }
+        }
+        return ports;
+    }
+
+    bool use_io_model(benchmark::State &io_state, IOModel in_io_model)
+    {
+        if (eSUCCESS != set_io_model(in_io_model) || in_io_model != get_io_model())
+        {
+            io_state.SkipWithError("IO model not available in this build or kernel");
+            return false;
+        }
+        return true;
+    }
+
+    void spin_until(const std::atomic<u64> &in_counter, u64 in_target)
+    {
+        while (in_counter.load(std::memory_order_acquire) < in_target)
+        {
+        }
+    }
+
+#if CONFIG_OMEGA_UART_CONTROLLER_PROFILE
+    void report_syscalls(benchmark::State &io_state, const std::vector<std::unique_ptr<LoopbackPort>> &in_ports)
+    {
+        u64 rx_syscalls = 0;
+        u64 tx_syscalls = 0;
+        for (const auto &port : in_ports)
+        {
+            const auto profile = get_profile(port->handle);
+            rx_syscalls += profile.rx_syscalls;
+            tx_syscalls += profile.tx_syscalls;
+        }
+        io_state.counters["rx_syscalls"] = benchmark::Counter(static_cast<double>(rx_syscalls), benchmark::Counter::kAvgIterations);
+        io_state.counters["tx_syscalls"] = benchmark::Counter(static_cast<double>(tx_syscalls), benchmark::Counter::kAvgIterations);
+    }
+#else
+    void report_syscalls(benchmark::State &, const std::vector<std::unique_ptr<LoopbackPort>> &) {}
+#endif
+} // namespace
+
+/* START: BLOCKING IO */
+// write() of one chunk while a background thread keeps the master drained
+static void BM_Write(benchmark::State &io_state)
+{
+    LoopbackPort port;
+    if (0 == port.handle)
+    {
+        io_state.SkipWithError("could not open a pty loopback");
+        return;
+    }
+    const size_t chunk_size = io_state.range(0);
+    std::vector<u8> chunk(chunk_size, 0x5A);
+    BackgroundLoop drainer{[&port]
+                           {
+                               port.pty.drain();
+                               std::this_thread::yield();
+                           }};
+    for (auto _ : io_state)
+    {
+        const auto response = write(port.handle, chunk.data(), chunk.size(), TIMEOUT_MS);
+        if (eSUCCESS != response.status || chunk_size != response.size)
+        {
+            io_state.SkipWithError("write() failed");
+            break;
+        }
+    }
+    io_state.SetBytesProcessed(io_state.iterations() * chunk_size);
+}
+BENCHMARK(BM_Write)->RangeMultiplier(4)->Range(1, 16 << 10)->UseRealTime();
+
+// read() of one chunk while a background thread keeps the master topped up
+static void BM_Read(benchmark::State &io_state)
+{
+    LoopbackPort port;
+    if (0 == port.handle)
+    {
+        io_state.SkipWithError("could not open a pty loopback");
+        return;
+    }
+    const size_t chunk_size = io_state.range(0);
+    std::vector<u8> chunk(chunk_size);
+    const std::vector<u8> feed(1024, 0xA5);
+    BackgroundLoop feeder{[&port, &feed]
+                          { (void)port.pty.send(feed.data(), feed.size()); }};
+    for (auto _ : io_state)
+    {
+        const auto response = read(port.handle, chunk.data(), chunk.size(), TIMEOUT_MS);
+        if (eSUCCESS != response.status || chunk_size != response.size)
+        {
+            io_state.SkipWithError("read() failed");
+            break;
+        }
+    }
+    io_state.SetBytesProcessed(io_state.iterations() * chunk_size);
+}
+BENCHMARK(BM_Read)->RangeMultiplier(4)->Range(1, 16 << 10)->UseRealTime();
+
+// write() a chunk, echo it back from the master and read() it again. Arg 1 turns on enable_low_latency(), which a pty
+// reports as skipped, so on a pty the two rows show the tuning costs nothing; on a USB adapter they show what it buys
+static void BM_RoundTrip(benchmark::State &io_state)
+{
+    LoopbackPort port;
+    if (0 == port.handle)
+    {
+        io_state.SkipWithError("could not open a pty loopback");
+        return;
+    }
+    if (0 != io_state.range(1))
+    {
+        (void)enable_low_latency(port.handle);
+    }
+    const size_t chunk_size = io_state.range(0);
+    std::vector<u8> chunk(chunk_size, 0x3C);
+    std::vector<u8> echo(chunk_size);
+    for (auto _ : io_state)
+    {
+        if (eSUCCESS != write(port.handle, chunk.data(), chunk.size(), TIMEOUT_MS).status ||
+            !port.pty.receive(echo.data(), echo.size()) ||
+            !port.pty.send(echo.data(), echo.size()) ||
+            chunk_size != read(port.handle, chunk.data(), chunk.size(), TIMEOUT_MS).size)
+        {
+            io_state.SkipWithError("round trip failed");
+            break;
+        }
+    }
+    io_state.SetBytesProcessed(io_state.iterations() * chunk_size);
+}
+BENCHMARK(BM_RoundTrip)->ArgsProduct({{1, 64, 1024}, {0, 1}})->ArgNames({"chunk", "low_latency"})->UseRealTime();
+/* END: BLOCKING IO */
+
+/* START: CALLBACK DELIVERY */
+// Time from a byte entering the master to the read callback seeing it, with in_ports handles started and the byte sent
+// to each of them in turn
+static void BM_CallbackLatency(benchmark::State &io_state)
+{
+    if (!use_io_model(io_state, static_cast<IOModel>(io_state.range(0))))
+    {
+        return;
+    }
+    auto ports = open_ports(io_state, io_state.range(1));
+    std::atomic<u64> delivered{0};
+    for (const auto &port : ports)
+    {
+        (void)add_on_read_callback(port->handle, [&delivered](const Handle, const u8 *, const size_t in_size)
+                                   { delivered.fetch_add(in_size, std::memory_order_release); });
+        if (eSUCCESS != start(port->handle))
+        {
+            io_state.SkipWithError("start() failed");
+            return;
+        }
+    }
+    const u8 byte{0x55};
+    size_t next_port = 0;
+    u64 expected = 0;
+    for (auto _ : io_state)
+    {
+        if (!ports[next_port]->pty.send(&byte, 1))
+        {
+            io_state.SkipWithError("send failed");
+            break;
+        }
+        spin_until(delivered, ++expected);
+        next_port = (next_port + 1) % ports.size();
+    }
+    for (const auto &port : ports)
+    {
+        (void)stop(port->handle);
+    }
+}
+BENCHMARK(BM_CallbackLatency)->ArgsProduct({{0, 1, 2}, {1, 16, 64}})->ArgNames({"model", "ports"})->UseRealTime();
+
+// Sustained receive across in_ports started handles. Process CPU time covers the delivery threads, so cpu/MB compares
+// the IO models; with OMEGA_UART_CONTROLLER_PROFILE the syscall counters are reported per iteration too
+static void BM_ReceiveThroughput(benchmark::State &io_state)
+{
+    if (!use_io_model(io_state, static_cast<IOModel>(io_state.range(0))))
+    {
+        return;
+    }
+    auto ports = open_ports(io_state, io_state.range(1));
+    std::atomic<u64> delivered{0};
+    for (const auto &port : ports)
+    {
+        (void)set_rx_delivery_policy(port->handle, RxDeliveryPolicy{.buffer_size = 4096, .min_bytes = 1, .max_latency_us = 0});
+        (void)add_on_read_callback(port->handle, [&delivered](const Handle, const u8 *, const size_t in_size)
+                                   { delivered.fetch_add(in_size, std::memory_order_release); });
+        if (eSUCCESS != start(port->handle))
+        {
+            io_state.SkipWithError("start() failed");
+            return;
+        }
+    }
+    const std::vector<u8> chunk(1024, 0x77);
+    u64 expected = 0;
+    for (auto _ : io_state)
+    {
+        for (const auto &port : ports)
+        {
+            (void)port->pty.send(chunk.data(), chunk.size());
+        }
+        expected += chunk.size() * ports.size();
+        spin_until(delivered, expected);
+    }
+    io_state.SetBytesProcessed(expected);
+    report_syscalls(io_state, ports);
+    for (const auto &port : ports)
+    {
+        (void)stop(port->handle);
+    }
+}
+BENCHMARK(BM_ReceiveThroughput)->ArgsProduct({{0, 1, 2}, {1, 8, 32}})->ArgNames({"model", "ports"})->MeasureProcessCPUTime()->UseRealTime();
+
+// The same 64 byte bursts through the three delivery paths: 0 read callback, 1 read buffer callback, 2 RX ring
+static void BM_DeliveryPath(benchmark::State &io_state)
+{
+    if (!use_io_model(io_state, IOModel::eTHREAD_PER_PORT))
+    {
+        return;
+    }
+    LoopbackPort port;
+    if (0 == port.handle)
+    {
+        io_state.SkipWithError("could not open a pty loopback");
+        return;
+    }
+    std::atomic<u64> delivered{0};
+    const i64 path = io_state.range(0);
+    if (0 == path)
+    {
+        (void)add_on_read_callback(port.handle, [&delivered](const Handle, const u8 *, const size_t in_size)
+                                   { delivered.fetch_add(in_size, std::memory_order_release); });
+    }
+    else if (1 == path)
+    {
+        (void)add_on_read_buffer_callback(port.handle, [&delivered](const Handle, const RxBuffer &in_buffer)
+                                          { delivered.fetch_add(in_buffer.size(), std::memory_order_release); });
+    }
+    else
+    {
+        (void)set_rx_ring(port.handle, 64 << 10);
+    }
+    if (eSUCCESS != start(port.handle))
+    {
+        io_state.SkipWithError("start() failed");
+        return;
+    }
+    const std::vector<u8> burst(64, 0x11);
+    u64 expected = 0;
+    u64 consumed = 0;
+    for (auto _ : io_state)
+    {
+        (void)port.pty.send(burst.data(), burst.size());
+        expected += burst.size();
+        if (2 == path)
+        {
+            while (consumed < expected)
+            {
+                const auto pending = rx_peek(port.handle);
+                (void)rx_commit(port.handle, pending.size());
+                consumed += pending.size();
+            }
+        }
+        else
+        {
+            spin_until(delivered, expected);
+        }
+    }
+    io_state.SetBytesProcessed(expected);
+    (void)stop(port.handle);
+}
+BENCHMARK(BM_DeliveryPath)->DenseRange(0, 2)->ArgName("path")->UseRealTime();
+
+// Delivery policy matrix: callbacks per 1 KiB of 64 byte bursts, against how long each burst takes to be delivered
+static void BM_DeliveryPolicy(benchmark::State &io_state)
+{
+    if (!use_io_model(io_state, IOModel::eTHREAD_PER_PORT))
+    {
+        return;
+    }
+    LoopbackPort port;
+    if (0 == port.handle)
+    {
+        io_state.SkipWithError("could not open a pty loopback");
+        return;
+    }
+    std::atomic<u64> delivered{0};
+    u64 callbacks = 0;
+    (void)set_rx_delivery_policy(port.handle, RxDeliveryPolicy{.buffer_size = 1024,
+                                                               .min_bytes = static_cast<size_t>(io_state.range(0)),
+                                                               .max_latency_us = static_cast<u32>(io_state.range(1))});
+    (void)add_on_read_callback(port.handle, [&delivered, &callbacks](const Handle, const u8 *, const size_t in_size)
+                               {
+                                   callbacks++;
+                                   delivered.fetch_add(in_size, std::memory_order_release); });
+    if (eSUCCESS != start(port.handle))
+    {
+        io_state.SkipWithError("start() failed");
+        return;
+    }
+    // Without a latency bound the policy may hold up to min_bytes - 1 bytes back, and the tty up to VMIN - 1 more
+    const size_t min_bytes = io_state.range(0);
+    const u64 held_back = 0 == io_state.range(1) ? (min_bytes - 1) + (std::min<size_t>(min_bytes, 255) - 1) : 0;
+    const std::vector<u8> burst(64, 0x22);
+    u64 expected = 0;
+    for (auto _ : io_state)
+    {
+        for (size_t idx = 0; idx < 16; ++idx)
+        {
+            (void)port.pty.send(burst.data(), burst.size());
+        }
+        expected += 16 * burst.size();
+        spin_until(delivered, expected - std::min(expected, held_back));
+    }
+    (void)stop(port.handle);
+    io_state.SetBytesProcessed(expected);
+    io_state.counters["callbacks_per_KiB"] = benchmark::Counter(static_cast<double>(callbacks), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_DeliveryPolicy)->ArgsProduct({{1, 256, 1024}, {0, 100, 1000}})->ArgNames({"min_bytes", "max_latency_us"})->UseRealTime();
+/* END: CALLBACK DELIVERY */
+
+/* START: FAN IN */
+namespace
+{
+    // Sends 64 bytes on every port each millisecond, as sensors streaming side by side
+    BackgroundLoop sensor_traffic(const std::vector<std::unique_ptr<LoopbackPort>> &in_ports)
+    {
+        return BackgroundLoop{[&in_ports]
+                              {
+                                  const u8 chunk[64]{0x33};
+                                  for (const auto &port : in_ports)
+                                  {
+                                      (void)port->pty.send(chunk, sizeof(chunk));
+                                  }
+                                  std::this_thread::sleep_for(std::chrono::milliseconds{1});
+                              }};
+    }
+} // namespace
+
+// in_ports streaming handles merged into one timestamp-ordered stream by a FanIn::Aggregator holding chunks for at most
+// in_latency_us, taken off it in batches. An iteration is one batch; latency_us is from RX timestamp to dequeue
+static void BM_FanIn(benchmark::State &io_state)
+{
+    auto ports = open_ports(io_state, io_state.range(0));
+    if (ports.empty())
+    {
+        return;
+    }
+    FanIn::Aggregator aggregator{FanIn::AggregatorConfiguration{.max_sources = ports.size(), .max_latency_us = static_cast<u32>(io_state.range(1))}};
+    for (const auto &port : ports)
+    {
+        (void)aggregator.subscribe(port->handle);
+        if (eSUCCESS != start(port->handle))
+        {
+            io_state.SkipWithError("start() failed");
+            return;
+        }
+    }
+    auto traffic = sensor_traffic(ports);
+    FanIn::Event events[64];
+    u64 bytes = 0;
+    u64 chunks = 0;
+    u64 latency_us = 0;
+    for (auto _ : io_state)
+    {
+        const size_t count = aggregator.dequeue(events, std::size(events), TIMEOUT_MS);
+        const u64 now_us = Timers::now();
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            bytes += events[idx].size;
+            latency_us += now_us - events[idx].timestamp_us;
+        }
+        chunks += count;
+    }
+    io_state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    io_state.counters["latency_us"] = benchmark::Counter(0 == chunks ? 0.0 : static_cast<double>(latency_us) / chunks);
+    u64 late = 0;
+    for (const auto &source : aggregator.statistics())
+    {
+        late += source.late;
+    }
+    io_state.counters["late"] = benchmark::Counter(static_cast<double>(late));
+    for (const auto &port : ports)
+    {
+        (void)stop(port->handle);
+    }
+}
+BENCHMARK(BM_FanIn)->ArgsProduct({{8, 32}, {250, 1000}})->ArgNames({"ports", "latency_us"})->MeasureProcessCPUTime()->UseRealTime();
+
+// BM_FanIn's traffic merged the way the aggregator replaces: read callbacks stamp their chunks and append them to a
+// shared vector under a mutex, which the consumer swaps out and sorts. Only orders within a batch
+static void BM_FanInMutexSort(benchmark::State &io_state)
+{
+    auto ports = open_ports(io_state, io_state.range(0));
+    if (ports.empty())
+    {
+        return;
+    }
+    struct Stamped
+    {
+        u64 timestamp_us;
+        std::vector<u8> data;
+    };
+    std::mutex mutex;
+    std::vector<Stamped> merged;
+    for (const auto &port : ports)
+    {
+        (void)add_on_read_callback(port->handle, [&mutex, &merged](const Handle, const u8 *in_data, const size_t in_size)
+                                   {
+                                       const u64 timestamp_us = Timers::now();
+                                       std::lock_guard lock{mutex};
+                                       merged.push_back({timestamp_us, {in_data, in_data + in_size}}); });
+        if (eSUCCESS != start(port->handle))
+        {
+            io_state.SkipWithError("start() failed");
+            return;
+        }
+    }
+    auto traffic = sensor_traffic(ports);
+    std::vector<Stamped> batch;
+    u64 bytes = 0;
+    u64 chunks = 0;
+    u64 latency_us = 0;
+    for (auto _ : io_state)
+    {
+        batch.clear();
+        {
+            std::lock_guard lock{mutex};
+            batch.swap(merged);
+        }
+        std::sort(batch.begin(), batch.end(), [](const Stamped &in_left, const Stamped &in_right)
+                  { return in_left.timestamp_us < in_right.timestamp_us; });
+        const u64 now_us = Timers::now();
+        for (const auto &stamped : batch)
+        {
+            bytes += stamped.data.size();
+            latency_us += now_us - stamped.timestamp_us;
+        }
+        chunks += batch.size();
+        if (batch.empty())
+        {
+            std::this_thread::yield();
+        }
+    }
+    io_state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    io_state.counters["latency_us"] = benchmark::Counter(0 == chunks ? 0.0 : static_cast<double>(latency_us) / chunks);
+    for (const auto &port : ports)
+    {
+        (void)stop(port->handle);
+    }
+}
+BENCHMARK(BM_FanInMutexSort)->Arg(8)->Arg(32)->ArgName("ports")->MeasureProcessCPUTime()->UseRealTime();
+/* END: FAN IN */
+
+/* START: DISPATCH */
+namespace
+{
+    // Stands in for a CPU-heavy protocol decoder: 16 CRC passes over every chunk
+    u32 heavy_decode(const u8 *in_data, size_t in_size)
+    {
+        Checksum::Crc crc{Checksum::Algorithm::eCRC16_MODBUS, Checksum::Kernel::eSLICING_BY_8};
+        for (size_t pass = 0; pass < 16; ++pass)
+        {
+            crc.update(in_data, in_size);
+        }
+        return crc.value();
+    }
+} // namespace
+
+// in_ports handles each receiving 4 KiB per iteration and running heavy_decode() on it, either inline on the I/O thread
+// (dispatched:0) or on a Dispatch::Pool with one lane per port (dispatched:1). Times until every port is decoded
+static void BM_DispatchDecode(benchmark::State &io_state)
+{
+    auto ports = open_ports(io_state, io_state.range(0));
+    if (ports.empty())
+    {
+        return;
+    }
+    const bool dispatched = 0 != io_state.range(1);
+    Dispatch::Pool pool{Dispatch::PoolConfiguration{.max_lanes = ports.size()}};
+    std::atomic<u64> decoded{0};
+    std::atomic<u32> digest{0};
+    const auto decode = [&decoded, &digest](const Handle, const RxBuffer &in_buffer)
+    {
+        digest.fetch_xor(heavy_decode(in_buffer.data(), in_buffer.size()), std::memory_order_relaxed);
+        decoded.fetch_add(in_buffer.size(), std::memory_order_release);
+    };
+    for (const auto &port : ports)
+    {
+        // Lanes hold on to their buffers until decoded, so the RX pool has to cover a whole iteration
+        const bool subscribed = dispatched ? eSUCCESS == set_rx_buffer_pool(port->handle, 4096, 256) && Dispatch::INVALID_LANE != pool.subscribe(port->handle, decode)
+                                           : eSUCCESS == add_on_read_buffer_callback(port->handle, decode);
+        if (!subscribed || eSUCCESS != start(port->handle))
+        {
+            io_state.SkipWithError("start() failed");
+            return;
+        }
+    }
+    const std::vector<u8> burst(512, 0x44);
+    u64 expected = 0;
+    for (auto _ : io_state)
+    {
+        for (size_t idx = 0; idx < 8; ++idx)
+        {
+            for (const auto &port : ports)
+            {
+                (void)port->pty.send(burst.data(), burst.size());
+            }
+        }
+        expected += 8 * burst.size() * ports.size();
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{TIMEOUT_MS};
+        while (decoded.load(std::memory_order_acquire) < expected)
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                io_state.SkipWithError("bytes were dropped");
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+    for (const auto &port : ports)
+    {
+        (void)stop(port->handle);
+    }
+    pool.drain();
+    benchmark::DoNotOptimize(digest.load());
+    io_state.SetBytesProcessed(static_cast<int64_t>(decoded.load()));
+    io_state.counters["workers"] = benchmark::Counter(dispatched ? static_cast<double>(pool.workers()) : 0.0);
+    u64 steals = 0;
+    for (const auto &lane : pool.statistics())
+    {
+        steals += lane.steals;
+    }
+    io_state.counters["steals"] = benchmark::Counter(static_cast<double>(steals));
+}
+BENCHMARK(BM_DispatchDecode)->ArgsProduct({{1, 8, 32}, {0, 1}})->ArgNames({"ports", "dispatched"})->UseRealTime();
+/* END: DISPATCH */
+
+/* START: REQUEST RESPONSE */
+namespace
+{
+    constexpr u8 REQUEST[] = "status?.......\n";
+    constexpr size_t REQUEST_SIZE{sizeof(REQUEST) - 1};
+
+    // Plays the devices: whatever the library writes to a port comes straight back
+    BackgroundLoop echo_devices(const std::vector<std::unique_ptr<LoopbackPort>> &in_ports)
+    {
+        return BackgroundLoop{[&in_ports]
+                              {
+                                  std::vector<pollfd> poll_fds;
+                                  for (const auto &port : in_ports)
+                                  {
+                                      poll_fds.push_back({.fd = port->pty.master(), .events = POLLIN, .revents = 0});
+                                  }
+                                  if (0 >= poll(poll_fds.data(), poll_fds.size(), 10))
+                                  {
+                                      return;
+                                  }
+                                  u8 echoed[4096];
+                                  for (size_t idx = 0; idx < poll_fds.size(); ++idx)
+                                  {
+                                      if (0 == poll_fds[idx].revents)
+                                      {
+                                          continue;
+                                      }
+                                      if (const ssize_t size = ::read(poll_fds[idx].fd, echoed, sizeof(echoed)); 0 < size)
+                                      {
+                                          (void)in_ports[idx]->pty.send(echoed, size);
+                                      }
+                                  }
+                              }};
+    }
+
+    Async::Task<void> converse(Handle in_handle, const std::atomic<bool> &in_running, std::atomic<u64> &io_completed, std::atomic<u64> &io_finished)
+    {
+        u8 response[REQUEST_SIZE];
+        while (in_running.load(std::memory_order_relaxed))
+        {
+            if (const auto sent = co_await Async::async_write(in_handle, REQUEST, REQUEST_SIZE, TIMEOUT_MS); eSUCCESS != sent.status || sent.timed_out)
+            {
+                break;
+            }
+            if (const auto received = co_await Async::async_read_until(in_handle, response, sizeof(response), '\n', TIMEOUT_MS); eSUCCESS != received.status || received.timed_out)
+            {
+                break;
+            }
+            io_completed.fetch_add(1, std::memory_order_release);
+        }
+        io_finished.fetch_add(1, std::memory_order_release);
+    }
+} // namespace
+
+// in_ports concurrent conversations, each a coroutine writing a request and awaiting its echo in a loop. An iteration is
+// one round trip per port
+static void BM_CoroutineRequestResponse(benchmark::State &io_state)
+{
+    auto ports = open_ports(io_state, io_state.range(0));
+    if (ports.empty())
+    {
+        return;
+    }
+    auto echo = echo_devices(ports);
+    std::atomic<bool> running{true};
+    std::atomic<u64> completed{0};
+    std::atomic<u64> finished{0};
+    for (const auto &port : ports)
+    {
+        Async::spawn(converse(port->handle, running, completed, finished));
+    }
+    u64 expected = 0;
+    for (auto _ : io_state)
+    {
+        spin_until(completed, expected += ports.size());
+    }
+    running.store(false, std::memory_order_relaxed);
+    spin_until(finished, ports.size());
+    io_state.SetItemsProcessed(io_state.iterations() * ports.size());
+}
+BENCHMARK(BM_CoroutineRequestResponse)->Arg(1)->Arg(16)->Arg(64)->ArgName("ports")->MeasureProcessCPUTime()->UseRealTime();
+
+// The same conversations driven by read callbacks, which send the next request once the echo is complete
+static void BM_CallbackRequestResponse(benchmark::State &io_state)
+{
+    if (!use_io_model(io_state, static_cast<IOModel>(io_state.range(0))))
+    {
+        return;
+    }
+    auto ports = open_ports(io_state, io_state.range(1));
+    if (ports.empty())
+    {
+        return;
+    }
+    auto echo = echo_devices(ports);
+    std::atomic<bool> running{true};
+    std::atomic<u64> completed{0};
+    std::vector<size_t> received(ports.size(), 0);
+    for (size_t idx = 0; idx < ports.size(); ++idx)
+    {
+        (void)add_on_read_callback(ports[idx]->handle, [&, idx](const Handle in_handle, const u8 *, const size_t in_size)
+                                   {
+                                       received[idx] += in_size;
+                                       if (REQUEST_SIZE > received[idx])
+                                       {
+                                           return;
+                                       }
+                                       received[idx] -= REQUEST_SIZE;
+                                       completed.fetch_add(1, std::memory_order_release);
+                                       if (running.load(std::memory_order_relaxed))
+                                       {
+                                           (void)write(in_handle, REQUEST, REQUEST_SIZE, TIMEOUT_MS);
+                                       } });
+        if (eSUCCESS != start(ports[idx]->handle))
+        {
+            io_state.SkipWithError("start() failed");
+            return;
+        }
+    }
+    for (const auto &port : ports)
+    {
+        (void)write(port->handle, REQUEST, REQUEST_SIZE, TIMEOUT_MS);
+    }
+    u64 expected = 0;
+    for (auto _ : io_state)
+    {
+        spin_until(completed, expected += ports.size());
+    }
+    running.store(false, std::memory_order_relaxed);
+    for (const auto &port : ports)
+    {
+        (void)stop(port->handle);
+    }
+    io_state.SetItemsProcessed(io_state.iterations() * ports.size());
+}
+BENCHMARK(BM_CallbackRequestResponse)->ArgsProduct({{0, 1}, {1, 16, 64}})->ArgNames({"model", "ports"})->MeasureProcessCPUTime()->UseRealTime();
+
+namespace
+{
+    constexpr size_t KEY_DIGITS{16};
+
+    struct PipelinedDevice
+    {
+        std::deque<std::pair<std::chrono::steady_clock::time_point, std::vector<u8>>> m_pending;
+        std::vector<u8> m_line;
+    };
+
+    // Plays a device that answers every line in_think_time after it arrived, working on any number of them at once
+    BackgroundLoop pipelined_device(const LoopbackPort &in_port, std::chrono::microseconds in_think_time, PipelinedDevice &io_device)
+    {
+        return BackgroundLoop{[&in_port, in_think_time, &io_device]
+                              {
+                                  auto now = std::chrono::steady_clock::now();
+                                  for (; !io_device.m_pending.empty() && io_device.m_pending.front().first <= now; io_device.m_pending.pop_front())
+                                  {
+                                      (void)in_port.pty.send(io_device.m_pending.front().second.data(), io_device.m_pending.front().second.size());
+                                  }
+                                  const auto wait = io_device.m_pending.empty() ? std::chrono::nanoseconds{std::chrono::milliseconds{10}} : io_device.m_pending.front().first - now;
+                                  const timespec timeout{.tv_sec = 0, .tv_nsec = static_cast<long>(wait.count())};
+                                  pollfd poll_fd{.fd = in_port.pty.master(), .events = POLLIN, .revents = 0};
+                                  if (0 >= ppoll(&poll_fd, 1, &timeout, nullptr))
+                                  {
+                                      return;
+                                  }
+                                  u8 received[4096];
+                                  const ssize_t size = ::read(poll_fd.fd, received, sizeof(received));
+                                  now = std::chrono::steady_clock::now();
+                                  for (ssize_t idx = 0; idx < size; ++idx)
+                                  {
+                                      io_device.m_line.push_back(received[idx]);
+                                      if ('\n' == received[idx])
+                                      {
+                                          io_device.m_pending.emplace_back(now + in_think_time, std::move(io_device.m_line));
+                                          io_device.m_line.clear();
+                                      }
+                                  }
+                              }};
+    }
+} // namespace
+
+// One port whose device takes in_think_us per request but accepts new ones meanwhile, driven by a Transaction::Engine
+// keeping in_window requests keyed by sequence number outstanding. An iteration is one transaction
+static void BM_PipelinedTransactions(benchmark::State &io_state)
+{
+    auto ports = open_ports(io_state, 1);
+    if (ports.empty())
+    {
+        return;
+    }
+    PipelinedDevice device;
+    auto device_loop = pipelined_device(*ports[0], std::chrono::microseconds{io_state.range(1)}, device);
+    const Transaction::EngineConfiguration configuration{.encoding = {.format = Framing::FrameFormat::eDELIMITER}, .window = static_cast<size_t>(io_state.range(0)), .timeout_ms = TIMEOUT_MS};
+    Transaction::Engine engine{ports[0]->handle, configuration, [](const u8 *in_frame, const size_t in_size, u64 &out_key)
+                               {
+                                   char digits[KEY_DIGITS + 1]{0};
+                                   if (KEY_DIGITS != in_size)
+                                   {
+                                       return false;
+                                   }
+                                   std::copy(in_frame, in_frame + KEY_DIGITS, digits);
+                                   out_key = std::strtoull(digits, nullptr, 16);
+                                   return true;
+                               }};
+    (void)add_on_read_callback(ports[0]->handle, engine.read_callback());
+    if (eSUCCESS != start(ports[0]->handle))
+    {
+        io_state.SkipWithError("start() failed");
+        return;
+    }
+    std::atomic<bool> running{true};
+    std::atomic<u64> completed{0};
+    std::atomic<u64> next_key{0};
+    std::function<void()> submit_next = [&]
+    {
+        const u64 key = next_key.fetch_add(1, std::memory_order_relaxed);
+        char request[KEY_DIGITS + 1]{0};
+        (void)snprintf(request, sizeof(request), "%016llx", static_cast<unsigned long long>(key));
+        (void)engine.submit(key, reinterpret_cast<const u8 *>(request), KEY_DIGITS, [&](const Transaction::Result &in_result)
+                            {
+                                if (eSUCCESS == in_result.status)
+                                {
+                                    completed.fetch_add(1, std::memory_order_release);
+                                }
+                                if (running.load(std::memory_order_relaxed))
+                                {
+                                    submit_next();
+                                } });
+    };
+    for (int64_t idx = 0; idx < io_state.range(0); ++idx)
+    {
+        submit_next();
+    }
+    u64 expected = 0;
+    for (auto _ : io_state)
+    {
+        spin_until(completed, ++expected);
+    }
+    running.store(false, std::memory_order_relaxed);
+    while (0 != engine.outstanding())
+    {
+    }
+    (void)stop(ports[0]->handle);
+    io_state.SetItemsProcessed(io_state.iterations());
+}
+BENCHMARK(BM_PipelinedTransactions)->ArgsProduct({{1, 4, 16}, {0, 1000}})->ArgNames({"window", "think_us"})->UseRealTime();
+namespace
+{
+    struct ModbusBus
+    {
+        std::deque<std::pair<u64, std::vector<u8>>> m_pending;
+    };
+
+    // Plays the slaves of a Modbus RTU line: io_detector splits the requests and queues the answers on io_bus, which are
+    // sent once due
+    BackgroundLoop modbus_bus(const LoopbackPort &in_port, ModbusBus &io_bus, Modbus::FrameDetector &io_detector)
+    {
+        return BackgroundLoop{[&in_port, &io_bus, &io_detector]
+                              {
+                                  u64 now = Timers::now();
+                                  for (; !io_bus.m_pending.empty() && io_bus.m_pending.front().first <= now; io_bus.m_pending.pop_front())
+                                  {
+                                      (void)in_port.pty.send(io_bus.m_pending.front().second.data(), io_bus.m_pending.front().second.size());
+                                  }
+                                  const u64 wait_us = io_bus.m_pending.empty() ? 10000 : io_bus.m_pending.front().first - now;
+                                  const timespec timeout{.tv_sec = 0, .tv_nsec = static_cast<long>(wait_us * 1000)};
+                                  pollfd poll_fd{.fd = in_port.pty.master(), .events = POLLIN, .revents = 0};
+                                  if (0 >= ppoll(&poll_fd, 1, &timeout, nullptr))
+                                  {
+                                      return;
+                                  }
+                                  u8 received[Modbus::MAX_ADU_SIZE];
+                                  if (const ssize_t size = ::read(poll_fd.fd, received, sizeof(received)); 0 < size)
+                                  {
+                                      io_detector.feed(received, static_cast<size_t>(size), Timers::now());
+                                  }
+                              }};
+    }
+} // namespace
+
+// Polls holding registers of in_slaves slaves every millisecond, more than the line can carry, so the master runs
+// back to back and an iteration is one completed poll
+static void BM_ModbusPoll(benchmark::State &io_state)
+{
+    auto ports = open_ports(io_state, 1);
+    if (ports.empty())
+    {
+        return;
+    }
+    const u8 slaves = static_cast<u8>(io_state.range(0));
+    const auto timing = Modbus::timing(get_configuration(ports[0]->handle));
+    ModbusBus bus;
+    // Slaves at addresses 1 to in_slaves answer a read of holding registers t3.5 after the request ended
+    Modbus::FrameDetector detector{timing, Modbus::Direction::eREQUESTS, [&bus, &timing, slaves](const u8 *in_frame, const size_t, const u64 in_arrival_us)
+                                   {
+                                       if (0 == in_frame[0] || slaves < in_frame[0])
+                                       {
+                                           return;
+                                       }
+                                       const u8 registers[] = {8, 0, 1, 0, 2, 0, 3, 0, 4};
+                                       std::vector<u8> response(Modbus::MAX_ADU_SIZE);
+                                       response.resize(Modbus::encode(in_frame[0], in_frame[1], registers, sizeof(registers), response.data()));
+                                       bus.m_pending.emplace_back(in_arrival_us + timing.t3_5_us, std::move(response));
+                                   }};
+    auto bus_loop = modbus_bus(*ports[0], bus, detector);
+    Modbus::Master master{ports[0]->handle, Modbus::MasterConfiguration{.response_timeout_ms = TIMEOUT_MS}};
+    (void)add_on_read_chunk_callback(ports[0]->handle, master.chunk_callback());
+    if (eSUCCESS != start(ports[0]->handle))
+    {
+        io_state.SkipWithError("start() failed");
+        return;
+    }
+    std::atomic<u64> completed{0};
+    std::vector<u64> polls;
+    for (u8 address = 1; address <= slaves; ++address)
+    {
+        polls.push_back(master.add_poll(Modbus::Request{address, static_cast<u8>(Modbus::FunctionCode::eREAD_HOLDING_REGISTERS), {0, 0, 0, 4}}, 1, [&completed](const Modbus::Result &in_result)
+                                        {
+                                            if (eSUCCESS == in_result.status)
+                                            {
+                                                completed.fetch_add(1, std::memory_order_release);
+                                            } }));
+    }
+    u64 expected = 0;
+    for (auto _ : io_state)
+    {
+        spin_until(completed, ++expected);
+    }
+    for (const u64 poll : polls)
+    {
+        (void)master.remove_poll(poll);
+    }
+    (void)stop(ports[0]->handle);
+    const auto statistics = master.statistics();
+    io_state.counters["timeouts"] = benchmark::Counter(static_cast<double>(statistics.timeouts));
+    io_state.counters["t3_5_us"] = benchmark::Counter(static_cast<double>(timing.t3_5_us));
+    io_state.SetItemsProcessed(io_state.iterations());
+}
+BENCHMARK(BM_ModbusPoll)->Arg(1)->Arg(8)->Arg(32)->ArgName("slaves")->UseRealTime();
+/* END: REQUEST RESPONSE */
+
+/* START: LIFECYCLE */
+static void BM_InitDeinit(benchmark::State &io_state)
+{
+    PtyLoopback pty;
+    if (!pty.valid())
+    {
+        io_state.SkipWithError("could not open a pty loopback");
+        return;
+    }
+    for (auto _ : io_state)
+    {
+        const Handle handle = init(pty.name(), 115200);
+        if (0 == handle || eSUCCESS != deinit(handle))
+        {
+            io_state.SkipWithError("init()/deinit() failed");
+            break;
+        }
+    }
+}
+BENCHMARK(BM_InitDeinit)->UseRealTime();
+
+// start()/stop() of one handle while in_ports other handles stay started
+static void BM_StartStop(benchmark::State &io_state)
+{
+    if (!use_io_model(io_state, static_cast<IOModel>(io_state.range(0))))
+    {
+        return;
+    }
+    auto ports = open_ports(io_state, io_state.range(1) + 1);
+    for (const auto &port : ports)
+    {
+        (void)add_on_read_callback(port->handle, [](const Handle, const u8 *, const size_t) {});
+    }
+    for (size_t idx = 1; idx < ports.size(); ++idx)
+    {
+        (void)start(ports[idx]->handle);
+    }
+    for (auto _ : io_state)
+    {
+        if (eSUCCESS != start(ports[0]->handle) || eSUCCESS != stop(ports[0]->handle))
+        {
+            io_state.SkipWithError("start()/stop() failed");
+            break;
+        }
+    }
+    for (const auto &port : ports)
+    {
+        (void)stop(port->handle);
+    }
+}
+BENCHMARK(BM_StartStop)->ArgsProduct({{0, 1, 2}, {0, 16}})->ArgNames({"model", "ports"})->UseRealTime();
+
+static void BM_GetAvailablePorts(benchmark::State &io_state)
+{
+    for (auto _ : io_state)
+    {
+        benchmark::DoNotOptimize(get_available_ports());
+    }
+}
+BENCHMARK(BM_GetAvailablePorts)->UseRealTime();
+/* END: LIFECYCLE */
@@ -16,7 +16,18 @@ FetchContent_Declare(
 )
 FetchContent_MakeAvailable(OmegaUtilityDriver)
 
-add_library(OmegaUARTController STATIC ${PROJ_ROOT_DIR}/src/platform/macosx/UARTController.cpp)
+add_library(OmegaUARTController STATIC
+    ${PROJ_ROOT_DIR}/src/platform/macosx/UARTController.cpp
+    ${PROJ_ROOT_DIR}/src/BufferPool.cpp
+    ${PROJ_ROOT_DIR}/src/Framing.cpp
+    ${PROJ_ROOT_DIR}/src/Timers.cpp
+    ${PROJ_ROOT_DIR}/src/Transaction.cpp
+    ${PROJ_ROOT_DIR}/src/Modbus.cpp
+    ${PROJ_ROOT_DIR}/src/Aggregator.cpp
+    ${PROJ_ROOT_DIR}/src/Dispatch.cpp
+    ${PROJ_ROOT_DIR}/src/Capture.cpp
+    ${PROJ_ROOT_DIR}/src/Checksum.cpp
+)
 target_include_directories(OmegaUARTController PUBLIC ${PROJ_ROOT_DIR}/inc)
 target_link_libraries(OmegaUARTController PUBLIC 
     OmegaUtilityDriver Threads::Threads
@@ -1,4 +1,13 @@
-set(PROJ_SOURCES ${PROJ_ROOT_DIR}/src/platform/esp32/UARTController.cpp)
+set(PROJ_SOURCES
+    ${PROJ_ROOT_DIR}/src/platform/esp32/UARTController.cpp
+    ${PROJ_ROOT_DIR}/src/Framing.cpp
+    ${PROJ_ROOT_DIR}/src/Timers.cpp
+    ${PROJ_ROOT_DIR}/src/Transaction.cpp
+    ${PROJ_ROOT_DIR}/src/Modbus.cpp
+    ${PROJ_ROOT_DIR}/src/Aggregator.cpp
+    ${PROJ_ROOT_DIR}/src/Dispatch.cpp
+    ${PROJ_ROOT_DIR}/src/Checksum.cpp
+)
 idf_component_register(
     INCLUDE_DIRS        ${PROJ_ROOT_DIR}/inc
     SRCS                ${PROJ_SOURCES}
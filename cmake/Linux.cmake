@@ -12,7 +12,18 @@ FetchContent_Declare(
 )
 FetchContent_MakeAvailable(OmegaUtilityDriver)
 
-add_library(OmegaUARTController STATIC ${PROJ_ROOT_DIR}/src/platform/linux/UARTController.cpp)
+add_library(OmegaUARTController STATIC
+    ${PROJ_ROOT_DIR}/src/platform/linux/UARTController.cpp
+    ${PROJ_ROOT_DIR}/src/BufferPool.cpp
+    ${PROJ_ROOT_DIR}/src/Framing.cpp
+    ${PROJ_ROOT_DIR}/src/Timers.cpp
+    ${PROJ_ROOT_DIR}/src/Transaction.cpp
+    ${PROJ_ROOT_DIR}/src/Modbus.cpp
+    ${PROJ_ROOT_DIR}/src/Aggregator.cpp
+    ${PROJ_ROOT_DIR}/src/Dispatch.cpp
+    ${PROJ_ROOT_DIR}/src/Capture.cpp
+    ${PROJ_ROOT_DIR}/src/Checksum.cpp
+)
 target_include_directories(OmegaUARTController PUBLIC ${PROJ_ROOT_DIR}/inc)
 target_link_libraries(OmegaUARTController PUBLIC 
     OmegaUtilityDriver Threads::Threads
@@ -20,4 +31,73 @@ target_link_libraries(OmegaUARTController PUBLIC
 target_compile_definitions(OmegaUARTController PUBLIC 
     CONFIG_OMEGA_LOGGING=1
     LINUX_UART
-)
\ No newline at end of file
+)
+option(OMEGA_UART_CONTROLLER_IO_URING "Build the io_uring IO model, which falls back to epoll when the running kernel lacks io_uring" OFF)
+if(OMEGA_UART_CONTROLLER_IO_URING)
+    target_compile_definitions(OmegaUARTController PUBLIC 
+        CONFIG_OMEGA_UART_CONTROLLER_IO_URING=1
+    )
+endif()
+option(OMEGA_UART_CONTROLLER_PROFILE "Compile in per-port traffic counters and histograms, read back with get_profile()" OFF)
+if(OMEGA_UART_CONTROLLER_PROFILE)
+    target_compile_definitions(OmegaUARTController PUBLIC 
+        CONFIG_OMEGA_UART_CONTROLLER_PROFILE=1
+    )
+endif()
+set(OMEGA_UART_CONTROLLER_SANITIZE "" CACHE STRING "Sanitizers to build the library and everything linking it with, e.g. thread or address,undefined")
+if(OMEGA_UART_CONTROLLER_SANITIZE)
+    target_compile_options(OmegaUARTController PUBLIC -fsanitize=${OMEGA_UART_CONTROLLER_SANITIZE} -fno-omit-frame-pointer)
+    target_link_options(OmegaUARTController PUBLIC -fsanitize=${OMEGA_UART_CONTROLLER_SANITIZE})
+endif()
+option(OMEGA_UART_CONTROLLER_BUILD_BENCH "Build the OmegaUARTController_bench microbenchmarks, which run over pseudo-terminal loopbacks" OFF)
+if(OMEGA_UART_CONTROLLER_BUILD_BENCH)
+    find_package(benchmark QUIET)
+    if(NOT benchmark_FOUND)
+        set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+        set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+        set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+        FetchContent_Declare(
+            benchmark
+            GIT_REPOSITORY https://github.com/google/benchmark.git
+            GIT_TAG v1.8.3
+            GIT_SHALLOW TRUE
+        )
+        FetchContent_MakeAvailable(benchmark)
+    endif()
+    add_executable(OmegaUARTController_bench
+        ${PROJ_ROOT_DIR}/bench/UARTBench.cpp
+        ${PROJ_ROOT_DIR}/bench/PrimitivesBench.cpp
+    )
+    target_link_libraries(OmegaUARTController_bench PRIVATE 
+        OmegaUARTController benchmark::benchmark_main util
+    )
+endif()
+option(OMEGA_UART_CONTROLLER_BUILD_TESTS "Build the OmegaUARTController_tests suite, which runs over pseudo-terminal loopbacks, and register it with CTest" OFF)
+if(OMEGA_UART_CONTROLLER_BUILD_TESTS)
+    find_package(GTest QUIET)
+    if(NOT GTest_FOUND)
+        set(INSTALL_GTEST OFF CACHE BOOL "" FORCE)
+        FetchContent_Declare(
+            googletest
+            GIT_REPOSITORY https://github.com/google/googletest.git
+            GIT_TAG v1.14.0
+            GIT_SHALLOW TRUE
+        )
+        FetchContent_MakeAvailable(googletest)
+    endif()
+    enable_testing()
+    add_executable(OmegaUARTController_tests
+        ${PROJ_ROOT_DIR}/tests/ChecksumTest.cpp
+        ${PROJ_ROOT_DIR}/tests/ConcurrencyStressTest.cpp
+        ${PROJ_ROOT_DIR}/tests/FramingTest.cpp
+        ${PROJ_ROOT_DIR}/tests/IOModelTest.cpp
+        ${PROJ_ROOT_DIR}/tests/ModbusTest.cpp
+    )
+    target_include_directories(OmegaUARTController_tests PRIVATE ${PROJ_ROOT_DIR}/bench)
+    target_link_libraries(OmegaUARTController_tests PRIVATE 
+        OmegaUARTController GTest::gtest_main util
+    )
+    add_test(NAME OmegaUARTController_tests COMMAND OmegaUARTController_tests --gtest_filter=-*Stress*)
+    add_test(NAME OmegaUARTController_stress COMMAND OmegaUARTController_tests --gtest_filter=*Stress*)
+    set_tests_properties(OmegaUARTController_tests OmegaUARTController_stress PROPERTIES TIMEOUT 300)
+endif()
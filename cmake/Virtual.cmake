@@ -0,0 +1,33 @@
+project(OmegaUARTController LANGUAGES C CXX)
+
+include(FetchContent)
+find_package(Threads REQUIRED)
+
+
+FetchContent_Declare(
+    OmegaUtilityDriver
+    GIT_REPOSITORY https://github.com/Omegaki113r/OmegaUtilityDriver.git
+    GIT_TAG origin/main
+    GIT_SHALLOW TRUE
+)
+FetchContent_MakeAvailable(OmegaUtilityDriver)
+
+add_library(OmegaUARTController STATIC
+    ${PROJ_ROOT_DIR}/src/platform/virtual/UARTController.cpp
+    ${PROJ_ROOT_DIR}/src/BufferPool.cpp
+    ${PROJ_ROOT_DIR}/src/Framing.cpp
+    ${PROJ_ROOT_DIR}/src/Timers.cpp
+    ${PROJ_ROOT_DIR}/src/Transaction.cpp
+    ${PROJ_ROOT_DIR}/src/Modbus.cpp
+    ${PROJ_ROOT_DIR}/src/Aggregator.cpp
+    ${PROJ_ROOT_DIR}/src/Dispatch.cpp
+    ${PROJ_ROOT_DIR}/src/Checksum.cpp
+)
+target_include_directories(OmegaUARTController PUBLIC ${PROJ_ROOT_DIR}/inc)
+target_link_libraries(OmegaUARTController PUBLIC 
+    OmegaUtilityDriver Threads::Threads
+)
+target_compile_definitions(OmegaUARTController PUBLIC 
+    CONFIG_OMEGA_LOGGING=1
+    VIRTUAL_UART
+)
@@ -12,7 +12,16 @@ FetchContent_Declare(
 )
 FetchContent_MakeAvailable(OmegaUtilityDriver)
 
-add_library(OmegaUARTController STATIC ${PROJ_ROOT_DIR}/src/platform/windows/UARTController.cpp)
+add_library(OmegaUARTController STATIC
+    ${PROJ_ROOT_DIR}/src/platform/windows/UARTController.cpp
+    ${PROJ_ROOT_DIR}/src/Framing.cpp
+    ${PROJ_ROOT_DIR}/src/Timers.cpp
+    ${PROJ_ROOT_DIR}/src/Transaction.cpp
+    ${PROJ_ROOT_DIR}/src/Modbus.cpp
+    ${PROJ_ROOT_DIR}/src/Aggregator.cpp
+    ${PROJ_ROOT_DIR}/src/Dispatch.cpp
+    ${PROJ_ROOT_DIR}/src/Checksum.cpp
+)
 target_include_directories(OmegaUARTController PUBLIC ${PROJ_ROOT_DIR}/inc)
 target_link_libraries(OmegaUARTController PUBLIC 
     OmegaUtilityDriver Threads::Threads setupapi
@@ -0,0 +1,155 @@
+/**
+ * @file Aggregator.hpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 4:02:17 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Aggregator.hpp
+ * File Created: Saturday, 17th October 2026 4:02:17 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 4:02:17 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+
+#include "OmegaUARTController/RingBuffer.hpp"
+#include "OmegaUARTController/UARTController.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace FanIn
+        {
+            constexpr u32 INVALID_SOURCE{UINT32_MAX};
+
+            struct AggregatorConfiguration
+            {
+                size_t max_sources{32};
+                // Chunks a source can hold before the merge takes them. Rounded up to a power of two
+                size_t queue_depth{1024};
+                // Longer chunks take several slots and come out as consecutive events
+                size_t slot_size{256};
+                // How long a chunk waits for sources with nothing queued before it is released without them. Chunks
+                // delivered later than this behind their timestamp can come out of order
+                u32 max_latency_us{1000};
+            };
+
+            struct Event
+            {
+                Handle handle;
+                u32 source;
+                // On the Timers clock, as RxChunk::timestamp_us
+                u64 timestamp_us;
+                // Valid until the next dequeue()
+                const u8 *data;
+                size_t size;
+            };
+
+            struct SourceStatistics
+            {
+                u64 chunks;
+                // Chunks dropped for a full queue
+                u64 dropped;
+                // Chunks stamped before events already released, which went out of order
+                u64 late;
+                // Times the merge had to wait for this source, and for how long in total
+                u64 stalls;
+                u64 stalled_us;
+                // How far the source's newest chunk trails the clock
+                u64 lag_us;
+            };
+
+            // Merges the chunks of several sources into one stream in timestamp order. Every source has its own lock-free
+            // single-producer queue, so the read threads never contend, and the merge releases the earliest queued chunk
+            // once every source has something queued or it is max_latency_us old
+            class Aggregator
+            {
+            public:
+                explicit Aggregator(const AggregatorConfiguration &in_configuration);
+                Aggregator(const Aggregator &) = delete;
+                Aggregator &operator=(const Aggregator &) = delete;
+
+                // May be called while other sources are fed and dequeued, but not concurrently with itself. Returns the
+                // source id, INVALID_SOURCE past max_sources
+                u32 add_source(Handle in_handle);
+#if defined(LINUX_UART)
+                // Adds in_handle as a source fed by a chunk callback. Must be called before start(in_handle)
+                OmegaStatus subscribe(Handle in_handle);
+#endif
+                // Called by in_source's one producer. in_timestamp_us must not go backwards within a source
+                OmegaStatus push(u32 in_source, const u8 *in_data, size_t in_size, u64 in_timestamp_us);
+                // Fills out_events with up to in_max events in timestamp order, waiting up to in_timeout_ms for the first.
+                // Called by one consumer at a time. Returns the count, which is 0 on a timeout
+                size_t dequeue(Event *out_events, size_t in_max, u32 in_timeout_ms);
+
+                size_t sources() const { return m_source_count.load(std::memory_order_acquire); }
+                std::vector<SourceStatistics> statistics() const;
+
+            private:
+                struct Slot
+                {
+                    u64 m_timestamp_us;
+                    size_t m_size;
+                };
+
+                struct Source
+                {
+                    Source(Handle in_handle, size_t in_depth, size_t in_slot_size);
+
+                    const Handle m_handle;
+                    const size_t m_mask;
+                    const std::unique_ptr<Slot[]> m_slots;
+                    const std::unique_ptr<u8[]> m_data;
+                    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head{0};
+                    size_t m_cached_tail{0};
+                    std::atomic<u64> m_chunks{0};
+                    std::atomic<u64> m_dropped{0};
+                    std::atomic<u64> m_newest_us{0};
+                    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail{0};
+                    // Slots handed out by the last dequeue(), given back by the next one
+                    size_t m_released{0};
+                    std::atomic<u64> m_late{0};
+                    std::atomic<u64> m_stalls{0};
+                    std::atomic<u64> m_stalled_us{0};
+                };
+
+                bool readable(const Source &in_source) const;
+                bool refill(u32 in_source);
+                void wait(u64 in_now_us, u64 in_until_us);
+
+                const AggregatorConfiguration m_configuration;
+                const std::unique_ptr<std::unique_ptr<Source>[]> m_sources;
+                std::atomic<u32> m_source_count{0};
+                // Sources the merge has taken in so far
+                u32 m_merged_sources{0};
+                // (timestamp, source) of the sources with a chunk at the head of their queue
+                std::priority_queue<std::pair<u64, u32>, std::vector<std::pair<u64, u32>>, std::greater<>> m_heads;
+                std::vector<u32> m_empty;
+                u64 m_released_until_us{0};
+                std::mutex m_wakeup_mutex;
+                std::condition_variable m_wakeup;
+                std::atomic<bool> m_sleeping{false};
+            };
+        } // namespace FanIn
+    } // namespace UART
+} // namespace Omega
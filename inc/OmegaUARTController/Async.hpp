@@ -0,0 +1,245 @@
+/**
+ * @file Async.hpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 9:02:37 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Async.hpp
+ * File Created: Saturday, 17th October 2026 9:02:37 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 9:02:37 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stop_token>
+#include <utility>
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+
+#include "OmegaUARTController/TimerWheel.hpp"
+#include "OmegaUARTController/UARTController.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace Async
+        {
+            /* START: TASK */
+            template <typename T>
+            class Task;
+
+            template <typename T>
+            struct TaskPromiseBase
+            {
+                struct FinalAwaiter
+                {
+                    bool await_ready() noexcept { return false; }
+                    template <typename Promise>
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> in_handle) noexcept { return in_handle.promise().m_continuation; }
+                    void await_resume() noexcept {}
+                };
+
+                std::suspend_always initial_suspend() noexcept { return {}; }
+                FinalAwaiter final_suspend() noexcept { return {}; }
+                // The library reports failures through OmegaStatus, so an exception escaping a task is a bug
+                void unhandled_exception() noexcept { std::terminate(); }
+
+                std::coroutine_handle<> m_continuation{std::noop_coroutine()};
+            };
+
+            template <typename T>
+            struct TaskPromise : TaskPromiseBase<T>
+            {
+                Task<T> get_return_object() noexcept;
+                void return_value(T in_value) { m_value.emplace(std::move(in_value)); }
+
+                std::optional<T> m_value;
+            };
+
+            template <>
+            struct TaskPromise<void> : TaskPromiseBase<void>
+            {
+                Task<void> get_return_object() noexcept;
+                void return_void() noexcept {}
+            };
+
+            // A lazily started coroutine: its body runs once it is co_awaited, and the awaiter resumes when it finishes.
+            // Resumption happens on whichever thread completed the task's last operation, usually the async IO loop
+            template <typename T = void>
+            class [[nodiscard]] Task
+            {
+            public:
+                using promise_type = TaskPromise<T>;
+
+                explicit Task(std::coroutine_handle<promise_type> in_handle) : m_handle{in_handle} {}
+                Task(Task &&in_other) noexcept : m_handle{std::exchange(in_other.m_handle, nullptr)} {}
+                Task &operator=(Task &&in_other) noexcept
+                {
+                    if (this != &in_other)
+                    {
+                        if (m_handle)
+                        {
+                            m_handle.destroy();
+                        }
+                        m_handle = std::exchange(in_other.m_handle, nullptr);
+                    }
+                    return *this;
+                }
+                Task(const Task &) = delete;
+                Task &operator=(const Task &) = delete;
+                ~Task()
+                {
+                    if (m_handle)
+                    {
+                        m_handle.destroy();
+                    }
+                }
+
+                bool await_ready() const noexcept { return !m_handle || m_handle.done(); }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> in_continuation) noexcept
+                {
+                    m_handle.promise().m_continuation = in_continuation;
+                    return m_handle;
+                }
+                T await_resume()
+                {
+                    if constexpr (!std::is_void_v<T>)
+                    {
+                        return std::move(*m_handle.promise().m_value);
+                    }
+                }
+
+            private:
+                std::coroutine_handle<promise_type> m_handle;
+            };
+
+            template <typename T>
+            Task<T> TaskPromise<T>::get_return_object() noexcept
+            {
+                return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+            }
+
+            inline Task<void> TaskPromise<void>::get_return_object() noexcept
+            {
+                return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+            }
+
+            // Owns itself and frees its frame once the spawned task finished
+            struct Detached
+            {
+                struct promise_type
+                {
+                    Detached get_return_object() noexcept { return {}; }
+                    std::suspend_never initial_suspend() noexcept { return {}; }
+                    std::suspend_never final_suspend() noexcept { return {}; }
+                    void return_void() noexcept {}
+                    void unhandled_exception() noexcept { std::terminate(); }
+                };
+            };
+
+            // Runs in_task on the calling thread up to its first suspension and lets it finish on its own
+            inline void spawn(Task<void> in_task)
+            {
+                [](Task<void> in_owned) -> Detached
+                { co_await in_owned; }(std::move(in_task));
+            }
+            /* END: TASK */
+
+            /* START: OPERATIONS */
+            enum class OperationKind
+            {
+                eREAD,
+                eWRITE,
+                eREAD_UNTIL,
+                eSLEEP,
+            };
+
+            class Operation;
+
+            struct Canceller
+            {
+                Operation *m_operation;
+                void operator()() const noexcept;
+            };
+
+            // One read, write or read-until on a port, awaited in place inside the calling coroutine's frame. It first tries
+            // to complete without suspending; otherwise the async IO loop finishes it and resumes the coroutine on its own
+            // thread. A port runs one reading and one writing operation at a time. Not for handles that are start()ed.
+            // Its deadline sits on the loop's timer wheel. Implemented by the Linux backend
+            class [[nodiscard]] Operation : public TimerHook
+            {
+            public:
+                Operation(OperationKind in_kind, Handle in_handle, u8 *io_buffer, size_t in_size, u8 in_delimiter, u32 in_timeout_ms, std::stop_token in_stop_token)
+                    : m_kind{in_kind}, m_handle{in_handle}, m_buffer{io_buffer}, m_size{in_size}, m_delimiter{in_delimiter}, m_timeout_ms{in_timeout_ms}, m_stop_token{std::move(in_stop_token)}
+                {
+                }
+                Operation(const Operation &) = delete;
+                Operation &operator=(const Operation &) = delete;
+
+                bool await_ready();
+                bool await_suspend(std::coroutine_handle<> in_continuation);
+                Response await_resume() const { return m_response; }
+
+                // The rest is the backend's bookkeeping, guarded by the async IO loop's lock while the operation is pending
+                const OperationKind m_kind;
+                const Handle m_handle;
+                u8 *const m_buffer;
+                const size_t m_size;
+                const u8 m_delimiter;
+                const u32 m_timeout_ms;
+                std::stop_token m_stop_token;
+                std::optional<std::stop_callback<Canceller>> m_stop_callback;
+                std::coroutine_handle<> m_continuation;
+                std::chrono::steady_clock::time_point m_deadline{std::chrono::steady_clock::time_point::max()};
+                size_t m_done{0};
+                bool m_armed{false};
+                bool m_cancel_requested{false};
+                bool m_closed{false};
+                Response m_response{eSUCCESS, 0};
+            };
+
+            // Completes once in_size bytes arrived, with the same timeout semantics as read()
+            inline Operation async_read(Handle in_handle, u8 *out_buffer, size_t in_size, u32 in_timeout_ms, std::stop_token in_stop_token = {})
+            {
+                return {OperationKind::eREAD, in_handle, out_buffer, in_size, 0, in_timeout_ms, std::move(in_stop_token)};
+            }
+
+            // Completes once all of in_buffer is written, with the same timeout semantics as write()
+            inline Operation async_write(Handle in_handle, const u8 *in_buffer, size_t in_size, u32 in_timeout_ms, std::stop_token in_stop_token = {})
+            {
+                return {OperationKind::eWRITE, in_handle, const_cast<u8 *>(in_buffer), in_size, 0, in_timeout_ms, std::move(in_stop_token)};
+            }
+
+            // Completes once in_delimiter arrived, with size counting it, or once in_capacity bytes arrived without one.
+            // Bytes that came in behind the delimiter are kept for the port's next async_read()/async_read_until()
+            inline Operation async_read_until(Handle in_handle, u8 *out_buffer, size_t in_capacity, u8 in_delimiter, u32 in_timeout_ms, std::stop_token in_stop_token = {})
+            {
+                return {OperationKind::eREAD_UNTIL, in_handle, out_buffer, in_capacity, in_delimiter, in_timeout_ms, std::move(in_stop_token)};
+            }
+
+            // Completes after in_duration_ms, or with cancelled set once in_stop_token is triggered. For retry backoffs and
+            // protocol timers that need no port
+            inline Operation async_sleep(u32 in_duration_ms, std::stop_token in_stop_token = {})
+            {
+                return {OperationKind::eSLEEP, 0, nullptr, 0, 0, in_duration_ms, std::move(in_stop_token)};
+            }
+            /* END: OPERATIONS */
+        } // namespace Async
+    } // namespace UART
+} // namespace Omega
@@ -0,0 +1,94 @@
+/**
+ * @file BufferPool.hpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 11:02:18 am
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: BufferPool.hpp
+ * File Created: Saturday, 17th October 2026 11:02:18 am
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 11:02:18 am
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#pragma once
+
+#include <atomic>
+#include <span>
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        class BufferPool;
+
+        // Refcounted view of one pool block. Copies share the block, which returns to its pool when the last copy goes away.
+        // Safe to keep past the callback and to hand to other threads
+        class RxBuffer
+        {
+        public:
+            RxBuffer() = default;
+            RxBuffer(const RxBuffer &in_other);
+            RxBuffer(RxBuffer &&in_other) noexcept;
+            RxBuffer &operator=(const RxBuffer &in_other);
+            RxBuffer &operator=(RxBuffer &&in_other) noexcept;
+            ~RxBuffer();
+
+            const u8 *data() const;
+            size_t size() const;
+            std::span<const u8> span() const { return {data(), size()}; }
+            explicit operator bool() const { return nullptr != m_block; }
+            void reset();
+
+        private:
+            friend class BufferPool;
+            struct Block;
+            explicit RxBuffer(Block *in_block) : m_block{in_block} {}
+            Block *m_block{nullptr};
+        };
+
+        // Fixed-size blocks carved out of a single allocation made at creation. acquire() and release are lock-free
+        class BufferPool
+        {
+        public:
+            static BufferPool *create(size_t in_block_size, size_t in_block_count);
+            // Drops the owner's reference. The pool is freed once every outstanding RxBuffer is released as well
+            void retire();
+
+            // Claims a free block for the producer to fill through writable_data()/set_size(). Empty when exhausted
+            RxBuffer acquire();
+            static u8 *writable_data(RxBuffer &in_buffer);
+            static void set_size(RxBuffer &in_buffer, size_t in_size);
+
+            size_t block_size() const { return m_block_size; }
+            size_t block_count() const { return m_block_count; }
+            u64 exhausted_count() const { return m_exhausted_count.load(std::memory_order_relaxed); }
+
+        private:
+            friend class RxBuffer;
+            BufferPool(size_t in_block_size, size_t in_block_count, u8 *in_storage);
+            ~BufferPool() = default;
+            void release(RxBuffer::Block *in_block);
+            void unreference();
+
+            const size_t m_block_size;
+            const size_t m_block_count;
+            RxBuffer::Block *m_blocks;
+            // low 32 bits: index + 1 of the first free block, high 32 bits: ABA tag
+            std::atomic<u64> m_free_list{0};
+            std::atomic<size_t> m_references{1};
+            std::atomic<u64> m_exhausted_count{0};
+        };
+    } // namespace UART
+} // namespace Omega
@@ -0,0 +1,210 @@
+/**
+ * @file Capture.hpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 2:14:52 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Capture.hpp
+ * File Created: Saturday, 17th October 2026 2:14:52 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 2:14:52 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+
+#include "OmegaUARTController/UARTController.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        // Binary capture of port traffic into a memory-mapped, append-only file, and replay of it into read callbacks.
+        // POSIX hosts only
+        namespace Capture
+        {
+            enum class Direction : u8
+            {
+                eRX,
+                eTX,
+            };
+
+            struct Record
+            {
+                u64 timestamp_us;
+                u16 port;
+                Direction direction;
+                // As RxChunk::gap and RxChunk::gap_us for RX chunks captured through chunk_callback()
+                bool gap;
+                u32 gap_us;
+                // Points into the mapping and stays valid for as long as the Reader
+                const u8 *data;
+                u32 size;
+            };
+
+            struct WriterConfiguration
+            {
+                // Address space reserved up front so appends never remap. Records past it are dropped
+                u64 max_size{u64{256} << 30};
+                // The file grows by this much at a time
+                u64 grow_size{u64{64} << 20};
+                // Bytes of records between two index entries
+                u64 index_interval{u64{64} << 10};
+            };
+
+            // Appends are serialised on a mutex and cost a memcpy into the mapping. The index and port table are written
+            // when the writer is destroyed; a file whose writer never got there is still read, by scanning it
+            class Writer
+            {
+            public:
+                // Truncates in_path. Returns nullptr when it cannot be created or mapped
+                static std::unique_ptr<Writer> create(const char *in_path, const WriterConfiguration &in_configuration = {});
+                ~Writer();
+                Writer(const Writer &) = delete;
+                Writer &operator=(const Writer &) = delete;
+
+                // Names a port in the file. Returns the id to append its records under
+                u16 add_port(const char *in_name);
+                OmegaStatus append(u16 in_port, Direction in_direction, const u8 *in_data, size_t in_size, u64 in_timestamp_us, u32 in_gap_us = 0, bool in_gap = false);
+#if defined(LINUX_UART)
+                // Adapter for add_on_read_chunk_callback() recording in_port's RX chunks with their timestamps
+                std::function<void(const Handle, const RxChunk &)> chunk_callback(u16 in_port);
+#endif
+                // Starts writing back what was appended so far without waiting for it
+                void flush();
+                // Bytes in the file so far
+                u64 size() const;
+                // Records dropped for want of space
+                u64 dropped() const;
+
+            private:
+                struct IndexEntry
+                {
+                    u64 m_timestamp_us;
+                    u64 m_offset;
+                };
+
+                Writer(int in_file, u8 *in_mapping, const WriterConfiguration &in_configuration);
+                bool reserve(u64 in_end);
+                void put(u16 in_port, u8 in_kind, const u8 *in_data, size_t in_size, u64 in_timestamp_us, u32 in_gap_us, bool in_gap);
+
+                const int m_file;
+                u8 *const m_mapping;
+                const WriterConfiguration m_configuration;
+                mutable std::mutex m_mutex;
+                u64 m_file_size{0};
+                u64 m_end{0};
+                u64 m_next_index_at{0};
+                u64 m_dropped{0};
+                std::vector<IndexEntry> m_index;
+                std::vector<std::string> m_ports;
+            };
+
+            // Walks a capture in file order, which is timestamp order within a port
+            class Reader
+            {
+            public:
+                // Returns nullptr when in_path is not a capture
+                static std::unique_ptr<Reader> open(const char *in_path);
+                ~Reader();
+                Reader(const Reader &) = delete;
+                Reader &operator=(const Reader &) = delete;
+
+                // Reads the record at the cursor and moves past it. False at the end
+                bool next(Record &out_record);
+                // Moves the cursor to the first record stamped in_timestamp_us or later, through the index
+                void seek(u64 in_timestamp_us);
+                void rewind();
+
+                const std::vector<std::string> &ports() const { return m_ports; }
+                u64 first_timestamp_us() const { return m_first_timestamp_us; }
+                u64 last_timestamp_us() const { return m_last_timestamp_us; }
+                // False when the writer did not finish and the index was rebuilt by scanning the file
+                bool indexed() const { return m_indexed; }
+
+            private:
+                struct IndexEntry
+                {
+                    u64 m_timestamp_us;
+                    u64 m_offset;
+                };
+
+                Reader(const u8 *in_mapping, size_t in_mapping_size);
+                bool load_footer();
+                void scan();
+                void bounds();
+                // Returns the offset after the record at in_offset, 0 when there is no whole record there
+                u64 read(u64 in_offset, Record &out_record, u8 &out_kind) const;
+
+                const u8 *const m_mapping;
+                const size_t m_mapping_size;
+                u64 m_data_end{0};
+                u64 m_cursor{0};
+                u64 m_first_timestamp_us{0};
+                u64 m_last_timestamp_us{0};
+                bool m_indexed{false};
+                std::vector<IndexEntry> m_index;
+                std::vector<std::string> m_ports;
+            };
+
+            struct ReplayStatistics
+            {
+                u64 records;
+                u64 bytes;
+                // How far delivery fell behind the requested timing at worst
+                u64 max_lateness_us;
+            };
+
+            // Feeds the RX records of a capture back into read callbacks, as if the ports were started
+            class Replayer
+            {
+            public:
+                explicit Replayer(Reader &io_reader);
+
+                // Records of in_port are delivered as coming from in_handle
+                void add_on_read_callback(u16 in_port, Handle in_handle, std::function<void(const Handle, const u8 *, const size_t)> in_callback);
+#if defined(LINUX_UART)
+                // Delivered with the captured timestamps and gaps, not the replay's
+                void add_on_read_chunk_callback(u16 in_port, Handle in_handle, std::function<void(const Handle, const RxChunk &)> in_callback);
+#endif
+                // Replays from the reader's cursor on the calling thread. in_speed 1 keeps the captured timing, 2 halves every
+                // delay and 0 delivers as fast as possible
+                ReplayStatistics run(double in_speed = 0, std::stop_token in_stop_token = {});
+
+            private:
+                struct Route
+                {
+                    bool m_routed{false};
+                    Handle m_handle{0};
+                    std::vector<std::function<void(const Handle, const u8 *, const size_t)>> m_read_callbacks;
+#if defined(LINUX_UART)
+                    std::vector<std::function<void(const Handle, const RxChunk &)>> m_read_chunk_callbacks;
+#endif
+                };
+
+                Route &route(u16 in_port, Handle in_handle);
+
+                Reader &m_reader;
+                std::vector<Route> m_routes;
+            };
+        } // namespace Capture
+    } // namespace UART
+} // namespace Omega
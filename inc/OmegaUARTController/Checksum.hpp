@@ -0,0 +1,72 @@
+/**
+ * @file Checksum.hpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 2:41:37 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Checksum.hpp
+ * File Created: Saturday, 17th October 2026 2:41:37 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 2:41:37 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#pragma once
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace Checksum
+        {
+            enum class Algorithm
+            {
+                eCRC8,          // poly 0x07, init 0x00 (CRC-8/SMBUS)
+                eCRC16_CCITT,   // poly 0x1021, init 0xFFFF, not reflected (CRC-16/CCITT-FALSE)
+                eCRC16_MODBUS,  // poly 0x8005, init 0xFFFF, reflected
+                eCRC32,         // poly 0x04C11DB7, reflected, init/xorout 0xFFFFFFFF (IEEE 802.3)
+                eCRC32C,        // poly 0x1EDC6F41, reflected, init/xorout 0xFFFFFFFF (Castagnoli)
+            };
+
+            enum class Kernel
+            {
+                eAUTO,         // fastest kernel the CPU supports for the algorithm
+                eSLICING_BY_8, // portable, 8 table lookups per 8 bytes
+                ePCLMULQDQ,    // carry-less multiply folding, CRC-32 on x86
+                eSSE42,        // crc32 instruction, CRC-32C on x86
+            };
+
+            bool is_supported(Algorithm in_algorithm, Kernel in_kernel);
+
+            // Streaming CRC. update() may be called once per received chunk, value() is valid at any point
+            class Crc
+            {
+            public:
+                explicit Crc(Algorithm in_algorithm, Kernel in_kernel = Kernel::eAUTO);
+
+                void update(const u8 *in_data, size_t in_size);
+                u32 value() const;
+                void reset();
+                Kernel kernel() const { return m_kernel; }
+
+            private:
+                Algorithm m_algorithm;
+                Kernel m_kernel;
+                u32 m_state;
+            };
+
+            u32 compute(Algorithm in_algorithm, const u8 *in_data, size_t in_size);
+        } // namespace Checksum
+    } // namespace UART
+} // namespace Omega
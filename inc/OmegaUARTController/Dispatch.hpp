@@ -0,0 +1,153 @@
+/**
+ * @file Dispatch.hpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 5:41:09 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Dispatch.hpp
+ * File Created: Saturday, 17th October 2026 5:41:09 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 5:41:09 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+
+#include "OmegaUARTController/BufferPool.hpp"
+#include "OmegaUARTController/RingBuffer.hpp"
+#include "OmegaUARTController/UARTController.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace Dispatch
+        {
+            using Lane = u32;
+            constexpr Lane INVALID_LANE{UINT32_MAX};
+
+            struct PoolConfiguration
+            {
+                // 0 starts one worker per core
+                size_t workers{0};
+                size_t max_lanes{64};
+                // Work a lane can hold before post() starts dropping. 0 does not limit it
+                size_t lane_depth{4096};
+            };
+
+            struct LaneStatistics
+            {
+                u64 executed;
+                u64 dropped;
+                // Work waiting right now, and the most that ever waited
+                u64 queued;
+                u64 max_queued;
+                // Times the lane ran on a worker other than the one it was queued to
+                u64 steals;
+            };
+
+            // Runs work off the I/O threads on a set of workers. Work is posted to a lane and the work of one lane runs one at
+            // a time, in the order it was posted, while different lanes run in parallel. A lane with work is queued to one
+            // worker and idle workers steal queued lanes from busy ones
+            class Pool
+            {
+            public:
+                explicit Pool(const PoolConfiguration &in_configuration);
+                // Runs the work already posted, then stops the workers. Subscribed handles must be deinitialised first
+                ~Pool();
+                Pool(const Pool &) = delete;
+                Pool &operator=(const Pool &) = delete;
+
+                // May be called while other lanes are in use, but not concurrently with itself. INVALID_LANE past max_lanes
+                Lane add_lane();
+                OmegaStatus post(Lane in_lane, std::function<void()> in_work);
+#if defined(MACOSX_UART) || defined(LINUX_UART) || defined(VIRTUAL_UART)
+                // Gives in_handle a lane and runs in_callback there with every buffer it receives. The read thread only takes
+                // a reference to the buffer, so a lane that falls behind holds on to RX pool blocks and the port drops reads
+                // once they run out: size the pool with set_rx_buffer_pool() for the backlog to absorb. Must be called
+                // before start(in_handle)
+                Lane subscribe(Handle in_handle, std::function<void(const Handle, const RxBuffer &)> in_callback);
+#endif
+                // Waits until every lane ran the work posted to it so far. Not to be called from the pool's own work
+                void drain();
+
+                size_t workers() const { return m_workers.size(); }
+                size_t lanes() const { return m_lane_count.load(std::memory_order_acquire); }
+                std::vector<LaneStatistics> statistics() const;
+
+            private:
+                // Either a closure or a buffer for the lane's subscriber, so receiving does not allocate
+                struct Work
+                {
+                    std::function<void()> m_function;
+                    RxBuffer m_buffer;
+                };
+
+                struct LaneState
+                {
+                    std::mutex m_mutex;
+                    std::vector<Work> m_queue;
+                    // Whether the lane sits in a worker's deque or is running. Guarded by m_mutex
+                    bool m_scheduled{false};
+                    // The worker that ran it last, so it stays where its data is cached
+                    std::atomic<u32> m_worker{0};
+                    // Owned by the worker running the lane
+                    std::vector<Work> m_running;
+                    Handle m_handle{0};
+                    std::function<void(const Handle, const RxBuffer &)> m_subscriber;
+                    std::atomic<u64> m_executed{0};
+                    std::atomic<u64> m_dropped{0};
+                    std::atomic<u64> m_max_queued{0};
+                    std::atomic<u64> m_steals{0};
+                };
+
+                struct Worker
+                {
+                    alignas(CACHE_LINE_SIZE) std::mutex m_mutex;
+                    std::deque<u32> m_lanes;
+                    std::thread m_thread;
+                };
+
+                OmegaStatus enqueue(u32 in_lane, Work &&in_work);
+                void schedule(u32 in_lane, u32 in_worker);
+                bool take(u32 in_worker, u32 &out_lane);
+                void run(u32 in_worker, u32 in_lane);
+                void work(u32 in_worker);
+
+                const PoolConfiguration m_configuration;
+                const std::unique_ptr<std::unique_ptr<LaneState>[]> m_lanes;
+                std::atomic<u32> m_lane_count{0};
+                std::vector<std::unique_ptr<Worker>> m_workers;
+                // Lanes sitting in the deques, and work posted but not run yet
+                alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_runnable{0};
+                std::atomic<size_t> m_outstanding{0};
+                alignas(CACHE_LINE_SIZE) std::mutex m_wakeup_mutex;
+                std::condition_variable m_wakeup;
+                std::condition_variable m_drained;
+                std::atomic<u32> m_sleeping{0};
+                std::atomic<u32> m_draining{0};
+                bool m_stopping{false};
+            };
+        } // namespace Dispatch
+    } // namespace UART
+} // namespace Omega
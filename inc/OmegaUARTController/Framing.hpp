@@ -0,0 +1,162 @@
+/**
+ * @file Framing.hpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 1:20:05 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Framing.hpp
+ * File Created: Saturday, 17th October 2026 1:20:05 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 1:20:05 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+
+#include "OmegaUARTController/UARTController.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace Framing
+        {
+            enum class FrameFormat
+            {
+                eCOBS,            // 0x00 terminated Consistent Overhead Byte Stuffing
+                eSLIP,            // RFC 1055
+                eDELIMITER,       // payload followed by a delimiter byte, no escaping
+                eLENGTH_PREFIXED, // 1 to 4 byte payload length followed by the payload
+            };
+
+            struct FrameEncoding
+            {
+                FrameFormat format;
+                u8 delimiter{'\n'};
+                u8 length_size{2};
+                bool big_endian{true};
+            };
+
+            /* START: SCANNING */
+            // Position of the first in_value in [in_begin, in_end), in_end when absent. SSE2/AVX2/NEON with a scalar fallback
+            const u8 *find_byte(const u8 *in_begin, const u8 *in_end, u8 in_value);
+            // Position of the first in_first or in_second in [in_begin, in_end), in_end when absent
+            const u8 *find_either(const u8 *in_begin, const u8 *in_end, u8 in_first, u8 in_second);
+            /* END: SCANNING */
+
+            /* START: ENCODERS */
+            size_t max_encoded_size(const FrameEncoding &in_encoding, size_t in_size);
+            // Writes one complete frame to out_buffer, which must hold max_encoded_size() bytes. Returns the encoded size, 0 on error
+            size_t encode(const FrameEncoding &in_encoding, const u8 *in_payload, size_t in_size, u8 *out_buffer);
+            Response write_frame(Handle in_handle, const FrameEncoding &in_encoding, const u8 *in_payload, size_t in_size, u32 in_timeout_ms);
+            /* END: ENCODERS */
+
+            /* START: DECODERS */
+            // Frames that arrived whole inside one chunk point straight into that chunk unless the format needs unescaping.
+            // The pointer is only valid for the duration of the call
+            typedef std::function<void(const u8 *, const size_t)> FrameCallback;
+
+            struct DecoderStatistics
+            {
+                u64 frames;
+                u64 oversized; // frames dropped because they exceeded max_frame_size
+                u64 malformed; // frames dropped because they could not be decoded
+            };
+
+            class Decoder
+            {
+            public:
+                Decoder(size_t in_max_frame_size, FrameCallback in_on_frame);
+                virtual ~Decoder() = default;
+                Decoder(const Decoder &) = delete;
+                Decoder &operator=(const Decoder &) = delete;
+
+                virtual void feed(const u8 *in_data, size_t in_size) = 0;
+                virtual void reset();
+                // Adapter for add_on_read_callback()/start()
+                std::function<void(const Handle, const u8 *, const size_t)> read_callback();
+                DecoderStatistics statistics() const { return m_statistics; }
+
+            protected:
+                void append(const u8 *in_data, size_t in_size);
+                void emit(const u8 *in_frame, size_t in_size);
+                void complete_buffered();
+
+                const size_t m_max_frame_size;
+                const std::unique_ptr<u8[]> m_buffer;
+                size_t m_size{0};
+                bool m_oversized{false};
+                FrameCallback m_on_frame;
+                DecoderStatistics m_statistics{};
+            };
+
+            class DelimiterDecoder : public Decoder
+            {
+            public:
+                DelimiterDecoder(u8 in_delimiter, size_t in_max_frame_size, FrameCallback in_on_frame);
+                void feed(const u8 *in_data, size_t in_size) override;
+
+            private:
+                const u8 m_delimiter;
+            };
+
+            class SlipDecoder : public Decoder
+            {
+            public:
+                SlipDecoder(size_t in_max_frame_size, FrameCallback in_on_frame);
+                void feed(const u8 *in_data, size_t in_size) override;
+                void reset() override;
+
+            private:
+                bool m_escaped{false};
+            };
+
+            class CobsDecoder : public Decoder
+            {
+            public:
+                CobsDecoder(size_t in_max_frame_size, FrameCallback in_on_frame);
+                void feed(const u8 *in_data, size_t in_size) override;
+
+            private:
+                void decode_and_emit(const u8 *in_encoded, size_t in_size);
+
+                // m_max_frame_size bounds the encoded frame, this the payload it decodes to
+                const size_t m_max_decoded_size;
+            };
+
+            class LengthPrefixedDecoder : public Decoder
+            {
+            public:
+                LengthPrefixedDecoder(u8 in_length_size, bool in_big_endian, size_t in_max_frame_size, FrameCallback in_on_frame);
+                void feed(const u8 *in_data, size_t in_size) override;
+                void reset() override;
+
+            private:
+                const u8 m_length_size;
+                const bool m_big_endian;
+                u8 m_header[4]{0};
+                u8 m_header_size{0};
+                size_t m_length{0};
+                size_t m_skip{0};
+            };
+
+            // nullptr for an encoding encode() rejects
+            std::unique_ptr<Decoder> make_decoder(const FrameEncoding &in_encoding, size_t in_max_frame_size, FrameCallback in_on_frame);
+            /* END: DECODERS */
+        } // namespace Framing
+    } // namespace UART
+} // namespace Omega
@@ -0,0 +1,300 @@
+/**
+ * @file Modbus.hpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 11:57:26 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Modbus.hpp
+ * File Created: Saturday, 17th October 2026 11:57:26 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 11:57:26 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+
+#include "OmegaUARTController/Timers.hpp"
+#include "OmegaUARTController/UARTController.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace Modbus
+        {
+            constexpr size_t MAX_ADU_SIZE{256};
+            constexpr u8 BROADCAST_ADDRESS{0};
+            constexpr u8 EXCEPTION_FLAG{0x80};
+
+            enum class FunctionCode : u8
+            {
+                eREAD_COILS = 0x01,
+                eREAD_DISCRETE_INPUTS = 0x02,
+                eREAD_HOLDING_REGISTERS = 0x03,
+                eREAD_INPUT_REGISTERS = 0x04,
+                eWRITE_SINGLE_COIL = 0x05,
+                eWRITE_SINGLE_REGISTER = 0x06,
+                eWRITE_MULTIPLE_COILS = 0x0F,
+                eWRITE_MULTIPLE_REGISTERS = 0x10,
+            };
+
+            enum class ExceptionCode : u8
+            {
+                eILLEGAL_FUNCTION = 0x01,
+                eILLEGAL_DATA_ADDRESS = 0x02,
+                eILLEGAL_DATA_VALUE = 0x03,
+                eSERVER_DEVICE_FAILURE = 0x04,
+            };
+
+            /* START: FRAMING */
+            // Silent intervals of a character format. Above 19200 baud the fixed 750 us and 1750 us the specification recommends
+            struct Timing
+            {
+                u32 character_us;
+                u32 t1_5_us;
+                u32 t3_5_us;
+            };
+
+            Timing timing(const Configuration &in_configuration);
+
+            // Appends the CRC. Returns the ADU size, 0 when in_size does not fit MAX_ADU_SIZE
+            size_t encode(u8 in_address, u8 in_function, const u8 *in_data, size_t in_size, u8 *out_adu);
+
+            struct Statistics
+            {
+                u64 frames;     // frames received with a valid CRC
+                u64 crc_errors; // frames dropped for a bad CRC, or too short to carry one
+                u64 gap_errors; // frames dropped for a silence longer than t1.5 inside them
+                u64 overruns;   // frames dropped for exceeding MAX_ADU_SIZE
+                u64 timeouts;   // requests whose last attempt went unanswered
+                u64 exceptions; // exception responses received by a master or sent by a slave
+                u64 unexpected; // frames answering no outstanding request
+            };
+
+            // Which side's frames a detector sees, which decides how it tells their length
+            enum class Direction
+            {
+                eREQUESTS,
+                eRESPONSES,
+            };
+
+            // The ADU without its CRC, and when its last byte arrived
+            typedef std::function<void(const u8 *, const size_t, const u64)> FrameCallback;
+
+            // Splits timestamped chunks into frames at silences of t3.5 and drops frames broken by a silence of t1.5 or a bad
+            // CRC. Frames of the standard function codes end as soon as their length is complete and the CRC matches; others
+            // end once poll() finds t3.5 passed since their last byte
+            class FrameDetector
+            {
+            public:
+                FrameDetector(const Timing &in_timing, Direction in_direction, FrameCallback in_on_frame);
+
+                // in_arrival_us is when the last byte of the chunk arrived, on the Timers clock
+                void feed(const u8 *in_data, size_t in_size, u64 in_arrival_us);
+                // Returns the tick to call again at, NEVER when no frame is open
+                u64 poll(u64 in_now_us);
+                void reset();
+                Statistics statistics() const { return m_statistics; }
+
+            private:
+                size_t expected_size() const;
+                void close();
+
+                const Timing m_timing;
+                const Direction m_direction;
+                const FrameCallback m_on_frame;
+                u8 m_buffer[MAX_ADU_SIZE]{0};
+                size_t m_size{0};
+                u64 m_last_arrival_us{0};
+                bool m_broken{false};
+                Statistics m_statistics{};
+            };
+            /* END: FRAMING */
+
+            /* START: MASTER */
+            struct Request
+            {
+                u8 address;
+                u8 function;
+                // The PDU after the function code
+                std::vector<u8> data;
+            };
+
+            struct Result
+            {
+                // eFAILED for timeouts, exception responses and failed writes
+                OmegaStatus status;
+                bool timed_out{false};
+                // Set when the slave answered with an exception response
+                u8 exception{0};
+                u32 attempts{0};
+                // The response PDU after the function code
+                std::vector<u8> data;
+            };
+
+            typedef std::function<void(const Result &)> Completion;
+
+            struct MasterConfiguration
+            {
+                // Counted from the end of the request's transmission
+                u32 response_timeout_ms{100};
+                u32 retries{0};
+                // Silence after a broadcast, which gets no response, so the slaves can act on it
+                u32 turnaround_delay_ms{100};
+                // Polls of a slave that missed this many responses in a row are pushed back, twice as far each further miss
+                u32 backoff_after{3};
+                u32 max_backoff_ms{10000};
+            };
+
+            // Runs one transaction at a time on a bus, as RTU requires, and starts the next one t3.5 after the last byte of the
+            // previous response as measured from RX timestamps, so the line is never left idle longer than that. Submitted
+            // requests go ahead of polls, and polls go in order of their due time. Responses are fed in through
+            // read_callback(), which must be removed before the master is destroyed
+            class Master
+            {
+            public:
+                Master(Handle in_handle, const MasterConfiguration &in_configuration);
+                // Fails every request still outstanding
+                ~Master();
+                Master(const Master &) = delete;
+                Master &operator=(const Master &) = delete;
+
+                // in_on_complete runs on the thread that settled the request: a read callback or the timer thread
+                OmegaStatus submit(const Request &in_request, Completion in_on_complete);
+                std::future<Result> submit(const Request &in_request);
+                // Repeats in_request every in_period_ms, from now on. Returns the id to remove it with, 0 on error
+                [[nodiscard]] u64 add_poll(const Request &in_request, u32 in_period_ms, Completion in_on_complete);
+                // A poll already on the wire still completes
+                OmegaStatus remove_poll(u64 in_poll_id);
+
+                void feed(const u8 *in_data, size_t in_size, u64 in_arrival_us);
+                // Adapter for add_on_read_callback()/start(), which timestamps each chunk on arrival
+                std::function<void(const Handle, const u8 *, const size_t)> read_callback();
+#if defined(LINUX_UART)
+                // Adapter for add_on_read_chunk_callback(), which uses the timestamps taken at read() return instead
+                std::function<void(const Handle, const RxChunk &)> chunk_callback();
+#endif
+
+                Timing timing() const { return m_timing; }
+                Statistics statistics() const;
+
+            private:
+                struct Transaction
+                {
+                    u64 m_poll_id{0};
+                    u8 m_adu[MAX_ADU_SIZE]{0};
+                    size_t m_size{0};
+                    Completion m_on_complete;
+                    u32 m_attempts{0};
+                };
+
+                struct Poll
+                {
+                    std::shared_ptr<Transaction> m_template;
+                    u64 m_period_us;
+                    u64 m_due;
+                };
+
+                struct Completed
+                {
+                    Completion m_on_complete;
+                    Result m_result;
+                };
+
+                std::shared_ptr<Transaction> make_transaction(const Request &in_request, Completion in_on_complete);
+                void on_frame(const u8 *in_frame, size_t in_size, u64 in_arrival_us);
+                void complete(Result in_result);
+                void pump(u64 in_now_us);
+                void settle();
+
+                const Handle m_handle;
+                const MasterConfiguration m_configuration;
+                const Timing m_timing;
+                mutable std::mutex m_mutex;
+                FrameDetector m_detector;
+                std::deque<std::shared_ptr<Transaction>> m_queue;
+                std::unordered_map<u64, Poll> m_polls;
+                // (due, poll id), earliest first
+                std::set<std::pair<u64, u64>> m_poll_order;
+                // Consecutive misses per slave address
+                std::unordered_map<u8, u32> m_missed;
+                std::shared_ptr<Transaction> m_current;
+                u64 m_response_deadline{0};
+                // When the line has been silent for t3.5, or the turnaround delay after a broadcast
+                u64 m_line_free_at{0};
+                u64 m_next_poll_id{1};
+                // Filled under m_mutex by pump(), drained by settle()
+                std::shared_ptr<Transaction> m_to_send;
+                std::vector<Completed> m_completed;
+                bool m_closing{false};
+                Statistics m_statistics{};
+                Timers::Timer m_timer;
+            };
+            /* END: MASTER */
+
+            /* START: SLAVE */
+            // Returns 0 with out_data filled to answer with it as the PDU after the function code, an exception code to answer
+            // with that, or NO_RESPONSE to stay silent as a slave that is not addressed does. Broadcasts are never answered
+            typedef std::function<u8(u8 in_address, u8 in_function, const u8 *in_data, size_t in_size, std::vector<u8> &out_data)> RequestHandler;
+            constexpr u8 NO_RESPONSE{0xFF};
+
+            // Answers requests for any number of unit addresses on one handle, t3.5 after the request's last byte
+            class Slave
+            {
+            public:
+                Slave(Handle in_handle, RequestHandler in_on_request);
+                ~Slave();
+                Slave(const Slave &) = delete;
+                Slave &operator=(const Slave &) = delete;
+
+                void feed(const u8 *in_data, size_t in_size, u64 in_arrival_us);
+                // Adapter for add_on_read_callback()/start(), which timestamps each chunk on arrival
+                std::function<void(const Handle, const u8 *, const size_t)> read_callback();
+#if defined(LINUX_UART)
+                // Adapter for add_on_read_chunk_callback(), which uses the timestamps taken at read() return instead
+                std::function<void(const Handle, const RxChunk &)> chunk_callback();
+#endif
+
+                Statistics statistics() const;
+
+            private:
+                void on_timer();
+                void respond(std::vector<std::pair<std::vector<u8>, u64>> &io_requests);
+                void transmit(u64 in_now_us);
+
+                const Handle m_handle;
+                const RequestHandler m_on_request;
+                const Timing m_timing;
+                mutable std::mutex m_mutex;
+                FrameDetector m_detector;
+                // Filled by the detector under m_mutex, answered outside it
+                std::vector<std::pair<std::vector<u8>, u64>> m_requests;
+                std::vector<u8> m_response;
+                u64 m_response_at{0};
+                Statistics m_statistics{};
+                Timers::Timer m_timer;
+            };
+            /* END: SLAVE */
+        } // namespace Modbus
+    } // namespace UART
+} // namespace Omega
@@ -0,0 +1,188 @@
+/**
+ * @file Profile.hpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 6:05:12 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Profile.hpp
+ * File Created: Saturday, 17th October 2026 6:05:12 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 6:05:12 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+
+#include "OmegaUARTController/RingBuffer.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        // Power-of-two buckets: bucket 0 counts zeros, bucket n values in [2^(n-1), 2^n), the last one everything larger
+        struct Histogram
+        {
+            static constexpr size_t BUCKET_COUNT{32};
+            u64 buckets[BUCKET_COUNT];
+            u64 count;
+            u64 sum;
+        };
+
+        struct ProfileSnapshot
+        {
+            u64 rx_bytes;
+            u64 rx_syscalls; // read() calls, or reaped io_uring reads
+            u64 tx_bytes;
+            u64 tx_syscalls; // write() calls, or reaped io_uring writes
+            u64 rx_overrun_bytes;
+            u64 rx_overrun_events;
+            Histogram read_size;      // bytes returned by each read that returned any
+            Histogram callback_ns;    // time spent in the read callbacks per delivered batch
+            Histogram write_block_ns; // time write() spent waiting for the tty to take more bytes
+        };
+
+#if CONFIG_OMEGA_UART_CONTROLLER_PROFILE
+        // Per-port counters. Every field is a relaxed atomic, so snapshot() reads each of them whole while traffic keeps
+        // flowing, but two fields of one snapshot may be a few updates apart
+        class PortProfile
+        {
+        public:
+            using TimePoint = std::chrono::steady_clock::time_point;
+
+            PortProfile() = default;
+            PortProfile(const PortProfile &) = delete;
+            PortProfile &operator=(const PortProfile &) = delete;
+
+            static TimePoint now() { return std::chrono::steady_clock::now(); }
+
+            void record_rx(i64 in_result)
+            {
+                m_rx.m_syscalls.fetch_add(1, std::memory_order_relaxed);
+                if (0 < in_result)
+                {
+                    m_rx.m_bytes.fetch_add(in_result, std::memory_order_relaxed);
+                    m_rx.m_read_size.record(in_result);
+                }
+            }
+
+            void record_tx(i64 in_result)
+            {
+                m_tx.m_syscalls.fetch_add(1, std::memory_order_relaxed);
+                if (0 < in_result)
+                {
+                    m_tx.m_bytes.fetch_add(in_result, std::memory_order_relaxed);
+                }
+            }
+
+            void record_overrun(size_t in_bytes)
+            {
+                m_rx.m_overrun_bytes.fetch_add(in_bytes, std::memory_order_relaxed);
+                m_rx.m_overrun_events.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void record_callbacks(TimePoint in_started) { m_rx.m_callback_ns.record(elapsed_ns(in_started)); }
+            void record_write_block(TimePoint in_started) { m_tx.m_write_block_ns.record(elapsed_ns(in_started)); }
+
+            ProfileSnapshot snapshot() const
+            {
+                ProfileSnapshot snapshot{};
+                snapshot.rx_bytes = m_rx.m_bytes.load(std::memory_order_relaxed);
+                snapshot.rx_syscalls = m_rx.m_syscalls.load(std::memory_order_relaxed);
+                snapshot.tx_bytes = m_tx.m_bytes.load(std::memory_order_relaxed);
+                snapshot.tx_syscalls = m_tx.m_syscalls.load(std::memory_order_relaxed);
+                snapshot.rx_overrun_bytes = m_rx.m_overrun_bytes.load(std::memory_order_relaxed);
+                snapshot.rx_overrun_events = m_rx.m_overrun_events.load(std::memory_order_relaxed);
+                m_rx.m_read_size.copy_to(snapshot.read_size);
+                m_rx.m_callback_ns.copy_to(snapshot.callback_ns);
+                m_tx.m_write_block_ns.copy_to(snapshot.write_block_ns);
+                return snapshot;
+            }
+
+        private:
+            class AtomicHistogram
+            {
+            public:
+                void record(u64 in_value)
+                {
+                    const size_t bucket = std::min<size_t>(std::bit_width(in_value), Histogram::BUCKET_COUNT - 1);
+                    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+                    m_count.fetch_add(1, std::memory_order_relaxed);
+                    m_sum.fetch_add(in_value, std::memory_order_relaxed);
+                }
+
+                void copy_to(Histogram &out_histogram) const
+                {
+                    for (size_t idx = 0; idx < Histogram::BUCKET_COUNT; ++idx)
+                    {
+                        out_histogram.buckets[idx] = m_buckets[idx].load(std::memory_order_relaxed);
+                    }
+                    out_histogram.count = m_count.load(std::memory_order_relaxed);
+                    out_histogram.sum = m_sum.load(std::memory_order_relaxed);
+                }
+
+            private:
+                std::atomic<u64> m_buckets[Histogram::BUCKET_COUNT]{};
+                std::atomic<u64> m_count{0};
+                std::atomic<u64> m_sum{0};
+            };
+
+            static u64 elapsed_ns(TimePoint in_started)
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(now() - in_started).count();
+            }
+
+            // RX is updated by the delivery thread, TX by the writers; separate lines keep them from bouncing
+            struct alignas(CACHE_LINE_SIZE) RxCounters
+            {
+                std::atomic<u64> m_bytes{0};
+                std::atomic<u64> m_syscalls{0};
+                std::atomic<u64> m_overrun_bytes{0};
+                std::atomic<u64> m_overrun_events{0};
+                AtomicHistogram m_read_size;
+                AtomicHistogram m_callback_ns;
+            };
+            struct alignas(CACHE_LINE_SIZE) TxCounters
+            {
+                std::atomic<u64> m_bytes{0};
+                std::atomic<u64> m_syscalls{0};
+                AtomicHistogram m_write_block_ns;
+            };
+
+            RxCounters m_rx;
+            TxCounters m_tx;
+        };
+#else
+        // Stand-in with the same surface that compiles away, so the data path carries no profiling cost
+        class PortProfile
+        {
+        public:
+            struct TimePoint
+            {
+            };
+
+            static TimePoint now() { return {}; }
+            void record_rx(i64) {}
+            void record_tx(i64) {}
+            void record_overrun(size_t) {}
+            void record_callbacks(TimePoint) {}
+            void record_write_block(TimePoint) {}
+        };
+#endif
+    } // namespace UART
+} // namespace Omega
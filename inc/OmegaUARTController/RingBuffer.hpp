@@ -0,0 +1,145 @@
+/**
+ * @file RingBuffer.hpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 10:12:40 am
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: RingBuffer.hpp
+ * File Created: Saturday, 17th October 2026 10:12:40 am
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 10:12:40 am
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <span>
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        constexpr size_t CACHE_LINE_SIZE{64};
+
+        // Lock-free single-producer/single-consumer byte ring.
+        // The RX thread is the only producer, the application is the only consumer.
+        class RingBuffer
+        {
+        public:
+            // in_capacity is rounded up to the next power of two
+            explicit RingBuffer(size_t in_capacity)
+                : m_capacity{std::bit_ceil(in_capacity < 2 ? size_t{2} : in_capacity)},
+                  m_buffer{std::make_unique<u8[]>(m_capacity)}
+            {
+            }
+            RingBuffer(const RingBuffer &) = delete;
+            RingBuffer &operator=(const RingBuffer &) = delete;
+
+            size_t capacity() const { return m_capacity; }
+
+            size_t size() const
+            {
+                return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+            }
+
+            /* START: PRODUCER */
+            // Largest contiguous free region. Fill it and hand the filled count to publish()
+            std::span<u8> write_span()
+            {
+                const size_t head = m_head.load(std::memory_order_relaxed);
+                if (m_capacity == head - m_cached_tail)
+                {
+                    m_cached_tail = m_tail.load(std::memory_order_acquire);
+                }
+                const size_t free_bytes = m_capacity - (head - m_cached_tail);
+                const size_t offset = head & (m_capacity - 1);
+                return {m_buffer.get() + offset, std::min(free_bytes, m_capacity - offset)};
+            }
+
+            void publish(size_t in_size)
+            {
+                m_head.store(m_head.load(std::memory_order_relaxed) + in_size, std::memory_order_release);
+            }
+
+            // Copies as much of in_data as fits. Whatever does not fit is counted as an overrun
+            size_t push(const u8 *in_data, size_t in_size)
+            {
+                size_t pushed = 0;
+                while (pushed < in_size)
+                {
+                    const auto span = write_span();
+                    if (span.empty())
+                    {
+                        break;
+                    }
+                    const size_t chunk = std::min(span.size(), in_size - pushed);
+                    std::memcpy(span.data(), in_data + pushed, chunk);
+                    publish(chunk);
+                    pushed += chunk;
+                }
+                if (pushed < in_size)
+                {
+                    record_overrun(in_size - pushed);
+                }
+                return pushed;
+            }
+
+            void record_overrun(size_t in_dropped_bytes)
+            {
+                m_overrun_bytes.fetch_add(in_dropped_bytes, std::memory_order_relaxed);
+                m_overrun_events.fetch_add(1, std::memory_order_relaxed);
+            }
+            /* END: PRODUCER */
+
+            /* START: CONSUMER */
+            // Largest contiguous readable region. Hand the consumed count to commit()
+            std::span<const u8> peek()
+            {
+                const size_t tail = m_tail.load(std::memory_order_relaxed);
+                if (tail == m_cached_head)
+                {
+                    m_cached_head = m_head.load(std::memory_order_acquire);
+                }
+                const size_t offset = tail & (m_capacity - 1);
+                return {m_buffer.get() + offset, std::min(m_cached_head - tail, m_capacity - offset)};
+            }
+
+            void commit(size_t in_size)
+            {
+                m_tail.store(m_tail.load(std::memory_order_relaxed) + in_size, std::memory_order_release);
+            }
+            /* END: CONSUMER */
+
+            u64 overrun_bytes() const { return m_overrun_bytes.load(std::memory_order_relaxed); }
+            u64 overrun_events() const { return m_overrun_events.load(std::memory_order_relaxed); }
+
+        private:
+            const size_t m_capacity;
+            const std::unique_ptr<u8[]> m_buffer;
+
+            alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head{0};
+            size_t m_cached_tail{0};
+            std::atomic<u64> m_overrun_bytes{0};
+            std::atomic<u64> m_overrun_events{0};
+
+            alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail{0};
+            size_t m_cached_head{0};
+        };
+    } // namespace UART
+} // namespace Omega
@@ -0,0 +1,266 @@
+/**
+ * @file SlotMap.hpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 4:12:50 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: SlotMap.hpp
+ * File Created: Saturday, 17th October 2026 4:12:50 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 4:12:50 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+
+#include "OmegaUARTController/RingBuffer.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        // Generational slot map behind the Handle values handed out by init().
+        // A handle is the slot index + 1 in bits 0-31 and the slot's generation in bits 32-61, so 0 is never a valid handle and
+        // bits 62-63 are always clear for callers to tag event data with. A slot's generation is odd while it is occupied and
+        // moves on when the slot is erased, which makes handles to an erased port fail to resolve even after the slot is reused.
+        // Slots are allocated in chunks that are never moved or freed before the map itself, so pin() needs no lock;
+        // emplace() and erase() serialise on an internal mutex.
+        // Every slot counts its users, the map itself being one of them while the slot is occupied. erase() only drops the
+        // map's reference, and whoever drops the last one destroys the value, so a Pin keeps its value alive across a
+        // concurrent erase()
+        template <typename T, size_t ChunkSize = 64, size_t MaxChunks = 64>
+        class SlotMap
+        {
+            struct Slot;
+
+        public:
+            static constexpr u32 GENERATION_BITS{30};
+            static constexpr u64 GENERATION_MASK{(u64{1} << GENERATION_BITS) - 1};
+            static constexpr size_t CAPACITY{ChunkSize * MaxChunks};
+
+            class Pin
+            {
+            public:
+                Pin() = default;
+                Pin(const Pin &) = delete;
+                Pin &operator=(const Pin &) = delete;
+                Pin(Pin &&in_other) noexcept : m_map{in_other.m_map}, m_slot{std::exchange(in_other.m_slot, nullptr)} {}
+                Pin &operator=(Pin &&in_other) noexcept
+                {
+                    if (this != &in_other)
+                    {
+                        reset();
+                        m_map = in_other.m_map;
+                        m_slot = std::exchange(in_other.m_slot, nullptr);
+                    }
+                    return *this;
+                }
+                ~Pin() { reset(); }
+
+                explicit operator bool() const { return nullptr != m_slot; }
+                T *get() const { return nullptr == m_slot ? nullptr : m_slot->value(); }
+                T &operator*() const { return *m_slot->value(); }
+                T *operator->() const { return m_slot->value(); }
+
+                void reset()
+                {
+                    if (nullptr != m_slot)
+                    {
+                        m_map->release(*std::exchange(m_slot, nullptr));
+                    }
+                }
+
+            private:
+                friend class SlotMap;
+                Pin(SlotMap *in_map, Slot *in_slot) : m_map{in_map}, m_slot{in_slot} {}
+
+                SlotMap *m_map{nullptr};
+                Slot *m_slot{nullptr};
+            };
+
+            SlotMap() = default;
+            SlotMap(const SlotMap &) = delete;
+            SlotMap &operator=(const SlotMap &) = delete;
+
+            ~SlotMap()
+            {
+                for (auto &chunk : m_chunks)
+                {
+                    auto *slots = chunk.load(std::memory_order_relaxed);
+                    if (nullptr == slots)
+                    {
+                        continue;
+                    }
+                    for (size_t idx = 0; idx < ChunkSize; ++idx)
+                    {
+                        if (0 != slots[idx].m_references.load(std::memory_order_relaxed))
+                        {
+                            slots[idx].value()->~T();
+                        }
+                    }
+                    delete[] slots;
+                }
+            }
+
+            // Returns 0 when every slot is taken
+            template <typename... Args>
+            u64 emplace(Args &&...in_args)
+            {
+                std::lock_guard lock{m_mutex};
+                u32 index;
+                if (!m_free_indices.empty())
+                {
+                    index = m_free_indices.back();
+                    m_free_indices.pop_back();
+                }
+                else if (m_used_indices < CAPACITY)
+                {
+                    if (0 == m_used_indices % ChunkSize)
+                    {
+                        m_chunks[m_used_indices / ChunkSize].store(new Slot[ChunkSize], std::memory_order_release);
+                    }
+                    index = static_cast<u32>(m_used_indices++);
+                }
+                else
+                {
+                    return 0;
+                }
+                auto &slot = slot_at(index);
+                new (slot.m_storage) T(std::forward<Args>(in_args)...);
+                slot.m_index = index;
+                slot.m_references.store(1, std::memory_order_relaxed);
+                const u32 generation = static_cast<u32>((slot.m_generation.load(std::memory_order_relaxed) + 1) & GENERATION_MASK);
+                slot.m_generation.store(generation, std::memory_order_release);
+                m_size++;
+                return make_handle(index, generation);
+            }
+
+            // Lock-free. An empty Pin means the handle is unknown or was erased
+            Pin pin(u64 in_handle)
+            {
+                auto *slot = slot_for(in_handle);
+                if (nullptr == slot)
+                {
+                    return {};
+                }
+                // a slot without references holds no value, so it must not be revived
+                u32 references = slot->m_references.load(std::memory_order_relaxed);
+                do
+                {
+                    if (0 == references)
+                    {
+                        return {};
+                    }
+                } while (!slot->m_references.compare_exchange_weak(references, references + 1, std::memory_order_acquire, std::memory_order_relaxed));
+                Pin pinned{this, slot};
+                // comparing all 32 upper bits also rejects handles that still carry a caller's tag bits
+                if (static_cast<u32>(in_handle >> 32) != slot->m_generation.load(std::memory_order_acquire))
+                {
+                    return {};
+                }
+                return pinned;
+            }
+
+            bool erase(u64 in_handle)
+            {
+                Slot *slot = nullptr;
+                {
+                    std::lock_guard lock{m_mutex};
+                    // generations only change under the lock, so a match here means the map still holds its reference
+                    slot = slot_for(in_handle);
+                    if (nullptr == slot || static_cast<u32>(in_handle >> 32) != slot->m_generation.load(std::memory_order_relaxed))
+                    {
+                        return false;
+                    }
+                    slot->m_generation.store(static_cast<u32>((handle_generation(in_handle) + 1) & GENERATION_MASK), std::memory_order_release);
+                    m_size--;
+                }
+                // dropping the last reference takes the lock again
+                release(*slot);
+                return true;
+            }
+
+            // Visits every occupied slot as (handle, value) while holding the map's lock
+            template <typename Visitor>
+            void for_each(Visitor &&in_visitor)
+            {
+                std::lock_guard lock{m_mutex};
+                for (size_t index = 0; index < m_used_indices; ++index)
+                {
+                    auto &slot = slot_at(static_cast<u32>(index));
+                    if (const u32 generation = slot.m_generation.load(std::memory_order_relaxed); is_occupied(generation))
+                    {
+                        in_visitor(make_handle(static_cast<u32>(index), generation), *slot.value());
+                    }
+                }
+            }
+
+            size_t size() const
+            {
+                std::lock_guard lock{m_mutex};
+                return m_size;
+            }
+
+        private:
+            struct alignas(CACHE_LINE_SIZE) Slot
+            {
+                std::atomic<u32> m_generation{0};
+                std::atomic<u32> m_references{0};
+                u32 m_index{0};
+                alignas(T) unsigned char m_storage[sizeof(T)];
+
+                T *value() { return std::launder(reinterpret_cast<T *>(m_storage)); }
+            };
+
+            static bool is_occupied(u32 in_generation) { return 0 != (in_generation & 1); }
+            static u32 handle_generation(u64 in_handle) { return static_cast<u32>((in_handle >> 32) & GENERATION_MASK); }
+            static u64 make_handle(u32 in_index, u32 in_generation) { return static_cast<u64>(in_generation) << 32 | (static_cast<u64>(in_index) + 1); }
+
+            void release(Slot &in_slot)
+            {
+                if (1 == in_slot.m_references.fetch_sub(1, std::memory_order_acq_rel))
+                {
+                    in_slot.value()->~T();
+                    std::lock_guard lock{m_mutex};
+                    m_free_indices.push_back(in_slot.m_index);
+                }
+            }
+
+            Slot *slot_for(u64 in_handle)
+            {
+                const u32 index = static_cast<u32>(in_handle) - 1;
+                if (index >= CAPACITY)
+                {
+                    return nullptr;
+                }
+                auto *slots = m_chunks[index / ChunkSize].load(std::memory_order_acquire);
+                return nullptr == slots ? nullptr : &slots[index % ChunkSize];
+            }
+
+            Slot &slot_at(u32 in_index) { return m_chunks[in_index / ChunkSize].load(std::memory_order_relaxed)[in_index % ChunkSize]; }
+
+            std::atomic<Slot *> m_chunks[MaxChunks]{};
+            mutable std::mutex m_mutex;
+            std::vector<u32> m_free_indices;
+            size_t m_used_indices{0};
+            size_t m_size{0};
+        };
+    } // namespace UART
+} // namespace Omega
@@ -0,0 +1,229 @@
+/**
+ * @file TimerWheel.hpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 10:14:52 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: TimerWheel.hpp
+ * File Created: Saturday, 17th October 2026 10:14:52 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 10:14:52 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        // The link a TimerWheel threads its timers through. Derive from it, or embed it, in whatever owns the deadline; the
+        // wheel never allocates
+        struct TimerHook
+        {
+            static constexpr u32 UNSCHEDULED{UINT32_MAX};
+
+            bool is_scheduled() const { return UNSCHEDULED != m_slot; }
+
+            TimerHook *m_next{nullptr};
+            TimerHook *m_prev{nullptr};
+            u64 m_expiry{0};
+            u32 m_slot{UNSCHEDULED};
+        };
+
+        // Hierarchical timing wheel over abstract u64 ticks: Levels wheels of 2^LevelBits slots, each slot of a level spanning
+        // a whole turn of the level below. schedule() and cancel() are O(1), and advance() skips idle stretches through
+        // per-level occupancy bitmaps, so a tickless loop only has to wake at next_expiry(). Timers further out than the
+        // wheel reaches park in its top level and get placed again every time it turns. Not thread safe
+        template <u32 LevelBits = 8, u32 Levels = 4>
+        class TimerWheel
+        {
+            static_assert(6 <= LevelBits && LevelBits * Levels < 64, "a level needs at least one whole bitmap word");
+
+        public:
+            static constexpr u32 SLOTS{1u << LevelBits};
+            static constexpr u64 NEVER{UINT64_MAX};
+
+            explicit TimerWheel(u64 in_now = 0) : m_now{in_now} {}
+            TimerWheel(const TimerWheel &) = delete;
+            TimerWheel &operator=(const TimerWheel &) = delete;
+
+            u64 now() const { return m_now; }
+            size_t size() const { return m_size; }
+
+            // Reschedules io_timer if it is already pending. A timer due at or before now() fires on the next advance()
+            void schedule(TimerHook &io_timer, u64 in_expiry)
+            {
+                cancel(io_timer);
+                io_timer.m_expiry = in_expiry;
+                place(io_timer, m_now + 1);
+                m_size++;
+            }
+
+            void cancel(TimerHook &io_timer)
+            {
+                if (io_timer.is_scheduled())
+                {
+                    unlink(io_timer);
+                    m_size--;
+                }
+            }
+
+            // Moves the wheel to in_now, calling in_on_expired(TimerHook &) for every timer due on the way, tick by tick.
+            // The callback may schedule and cancel any timer, including the one it was called for
+            template <typename OnExpired>
+            size_t advance(u64 in_now, OnExpired &&in_on_expired)
+            {
+                size_t expired = 0;
+                while (m_now < in_now)
+                {
+                    const u64 next = next_event();
+                    if (next > in_now)
+                    {
+                        m_now = in_now;
+                        break;
+                    }
+                    m_now = next;
+                    for (u32 level = Levels - 1; 0 < level; --level)
+                    {
+                        if (0 == (m_now & ((u64{1} << (level * LevelBits)) - 1)))
+                        {
+                            cascade(level, digit(m_now, level));
+                        }
+                    }
+                    while (TimerHook *timer = m_heads[digit(m_now, 0)])
+                    {
+                        unlink(*timer);
+                        m_size--;
+                        expired++;
+                        in_on_expired(*timer);
+                    }
+                }
+                return expired;
+            }
+
+            // The next tick advance() has work at, either an expiry or a turn of an upper level. NEVER when nothing is scheduled
+            u64 next_expiry() const { return 0 == m_size ? NEVER : next_event(); }
+
+        private:
+            static constexpr u32 MASK{SLOTS - 1};
+            static constexpr u32 TOP{Levels - 1};
+
+            static u32 digit(u64 in_tick, u32 in_level) { return static_cast<u32>(in_tick >> (in_level * LevelBits)) & MASK; }
+
+            // The lowest level whose current turn still reaches the expiry. The top level counts whole turns instead and
+            // parks anything out of reach in the slot it will visit last
+            void place(TimerHook &io_timer, u64 in_earliest)
+            {
+                const u64 expiry = std::max(io_timer.m_expiry, in_earliest);
+                u32 level = 0;
+                while (TOP > level && 0 != ((expiry ^ m_now) >> ((level + 1) * LevelBits)))
+                {
+                    level++;
+                }
+                u32 index = digit(expiry, level);
+                if (TOP == level && SLOTS <= (expiry >> (TOP * LevelBits)) - (m_now >> (TOP * LevelBits)))
+                {
+                    index = (digit(m_now, TOP) + MASK) & MASK;
+                }
+                link(io_timer, level * SLOTS + index);
+            }
+
+            void cascade(u32 in_level, u32 in_index)
+            {
+                const u32 slot = in_level * SLOTS + in_index;
+                TimerHook *timer = m_heads[slot];
+                m_heads[slot] = nullptr;
+                m_occupied[slot / 64] &= ~(u64{1} << (slot % 64));
+                while (nullptr != timer)
+                {
+                    TimerHook *next = timer->m_next;
+                    place(*timer, m_now);
+                    timer = next;
+                }
+            }
+
+            u64 next_event() const
+            {
+                u64 next = NEVER;
+                for (u32 level = 0; level < Levels; ++level)
+                {
+                    if (const u32 distance = next_occupied(level, digit(m_now, level)); 0 != distance)
+                    {
+                        next = std::min(next, ((m_now >> (level * LevelBits)) + distance) << (level * LevelBits));
+                    }
+                }
+                return next;
+            }
+
+            // Slots from in_current to the next occupied slot of in_level, going forward and wrapping round to in_current
+            // itself last. 0 when the level is empty
+            u32 next_occupied(u32 in_level, u32 in_current) const
+            {
+                const u32 first = (in_current + 1) & MASK;
+                for (u32 scanned = 0; scanned < SLOTS;)
+                {
+                    const u32 index = (first + scanned) & MASK;
+                    const u32 slot = in_level * SLOTS + index;
+                    if (const u64 word = m_occupied[slot / 64] >> (slot % 64); 0 != word)
+                    {
+                        return scanned + std::countr_zero(word) + 1;
+                    }
+                    scanned += 64 - index % 64;
+                }
+                return 0;
+            }
+
+            void link(TimerHook &io_timer, u32 in_slot)
+            {
+                io_timer.m_slot = in_slot;
+                io_timer.m_prev = nullptr;
+                io_timer.m_next = m_heads[in_slot];
+                if (nullptr != io_timer.m_next)
+                {
+                    io_timer.m_next->m_prev = &io_timer;
+                }
+                m_heads[in_slot] = &io_timer;
+                m_occupied[in_slot / 64] |= u64{1} << (in_slot % 64);
+            }
+
+            void unlink(TimerHook &io_timer)
+            {
+                const u32 slot = io_timer.m_slot;
+                (nullptr != io_timer.m_prev ? io_timer.m_prev->m_next : m_heads[slot]) = io_timer.m_next;
+                if (nullptr != io_timer.m_next)
+                {
+                    io_timer.m_next->m_prev = io_timer.m_prev;
+                }
+                if (nullptr == m_heads[slot])
+                {
+                    m_occupied[slot / 64] &= ~(u64{1} << (slot % 64));
+                }
+                io_timer.m_next = nullptr;
+                io_timer.m_prev = nullptr;
+                io_timer.m_slot = TimerHook::UNSCHEDULED;
+            }
+
+            std::array<TimerHook *, Levels * SLOTS> m_heads{};
+            std::array<u64, Levels * SLOTS / 64> m_occupied{};
+            u64 m_now;
+            size_t m_size{0};
+        };
+    } // namespace UART
+} // namespace Omega
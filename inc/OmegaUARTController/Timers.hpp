@@ -0,0 +1,73 @@
+/**
+ * @file Timers.hpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 11:48:10 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Timers.hpp
+ * File Created: Saturday, 17th October 2026 11:48:10 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 11:48:10 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#pragma once
+
+#include <functional>
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+
+#include "OmegaUARTController/TimerWheel.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace Timers
+        {
+            // Microseconds on the steady clock since the timer thread's epoch, the unit every deadline is given in
+            u64 now();
+            // The earliest tick at least in_delay_us from now
+            u64 after(u64 in_delay_us);
+
+            // One deadline on the library's shared timer thread, which sleeps until the earliest armed timer. in_on_expired
+            // runs on that thread with nothing locked, so it should only hand work off or do a little of it
+            class Timer
+            {
+            public:
+                explicit Timer(std::function<void()> in_on_expired);
+                // Disarms and waits for an in_on_expired in progress on the timer thread
+                ~Timer();
+                Timer(const Timer &) = delete;
+                Timer &operator=(const Timer &) = delete;
+
+                // Arms the timer for in_tick, or moves it there when already armed. A tick already past fires at once
+                void arm(u64 in_tick);
+                // Returns without waiting for an in_on_expired in progress, so it may be called with locks that callback takes
+                void disarm();
+                // Waits until an in_on_expired in progress elsewhere has returned. A no-op on the timer thread itself
+                void synchronize();
+
+            private:
+                friend struct TimerThread;
+
+                struct Hook : TimerHook
+                {
+                    Timer *m_timer;
+                };
+
+                Hook m_hook;
+                const std::function<void()> m_on_expired;
+            };
+        } // namespace Timers
+    } // namespace UART
+} // namespace Omega
@@ -0,0 +1,148 @@
+/**
+ * @file Transaction.hpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 11:02:37 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Transaction.hpp
+ * File Created: Saturday, 17th October 2026 11:02:37 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 11:02:37 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+
+#include "OmegaUARTController/Framing.hpp"
+#include "OmegaUARTController/TimerWheel.hpp"
+#include "OmegaUARTController/Timers.hpp"
+#include "OmegaUARTController/UARTController.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace Transaction
+        {
+            // Pulls the key of the request a response frame answers. Returns false for frames that answer none
+            typedef std::function<bool(const u8 *, const size_t, u64 &)> KeyExtractor;
+
+            struct EngineConfiguration
+            {
+                // Requests are framed and responses decoded with this
+                Framing::FrameEncoding encoding;
+                size_t max_frame_size{256};
+                // Requests on the wire at once. Further ones queue in submission order
+                size_t window{1};
+                // Per attempt, counted from when the request is handed to write()
+                u32 timeout_ms{1000};
+                // Times an unanswered request is sent again before it fails
+                u32 retries{0};
+                u32 write_timeout_ms{1000};
+            };
+
+            struct Result
+            {
+                OmegaStatus status;
+                // Set when the last attempt went unanswered
+                bool timed_out{false};
+                u32 attempts{0};
+                // The decoded response frame
+                std::vector<u8> response;
+            };
+
+            typedef std::function<void(const Result &)> Completion;
+
+            struct EngineStatistics
+            {
+                u64 submitted;
+                u64 completed;
+                u64 timeouts;  // requests failed after their last attempt went unanswered
+                u64 retries;   // attempts sent again
+                u64 unmatched; // frames without a key, or with one no request on the wire has
+            };
+
+            // Keeps a window of requests outstanding on a handle and matches responses to them by key, so a device that
+            // pipelines is never left idle waiting for the next request. Responses are fed in through read_callback(), which
+            // must be removed before the engine is destroyed. Each engine keeps its requests' deadlines on a wheel of its own and
+            // only has the earliest of them armed on the shared timer thread
+            class Engine
+            {
+            public:
+                Engine(Handle in_handle, const EngineConfiguration &in_configuration, KeyExtractor in_key_extractor);
+                // Fails every request still outstanding
+                ~Engine();
+                Engine(const Engine &) = delete;
+                Engine &operator=(const Engine &) = delete;
+
+                // in_key is what the extractor returns for the response and must be unique among outstanding requests.
+                // in_on_complete runs on the thread that settled the request: a read callback, the timer thread, or a
+                // thread whose write() failed. Returns eFAILED without calling it when the request was not accepted
+                OmegaStatus submit(u64 in_key, const u8 *in_request, size_t in_size, Completion in_on_complete);
+                std::future<Result> submit(u64 in_key, const u8 *in_request, size_t in_size);
+
+                void feed(const u8 *in_data, size_t in_size);
+                // Adapter for add_on_read_callback()/start()
+                std::function<void(const Handle, const u8 *, const size_t)> read_callback();
+
+                size_t outstanding() const;
+                EngineStatistics statistics() const;
+
+            private:
+                struct Request : TimerHook
+                {
+                    u64 m_key;
+                    std::vector<u8> m_frame;
+                    Completion m_on_complete;
+                    u32 m_attempts{0};
+                };
+
+                typedef std::vector<std::shared_ptr<Request>> Requests;
+
+                void on_frame(const u8 *in_frame, size_t in_size);
+                void on_deadline();
+                Requests admit();
+                void transmit(const Requests &in_requests);
+                void fail(const std::shared_ptr<Request> &in_request);
+                void retire(const std::shared_ptr<Request> &in_request);
+
+                const Handle m_handle;
+                const EngineConfiguration m_configuration;
+                const KeyExtractor m_key_extractor;
+                const std::unique_ptr<Framing::Decoder> m_decoder;
+                mutable std::mutex m_mutex;
+                // Keeps frames whole on the wire when several threads transmit
+                std::mutex m_write_mutex;
+                // Every outstanding request, whether queued or on the wire
+                std::unordered_map<u64, std::shared_ptr<Request>> m_requests;
+                std::deque<std::shared_ptr<Request>> m_queue;
+                size_t m_in_flight{0};
+                // Ticks are Timers::now() microseconds
+                TimerWheel<> m_deadlines;
+                Timers::Timer m_timer;
+                u64 m_armed_tick{TimerWheel<>::NEVER};
+                bool m_closing{false};
+                EngineStatistics m_statistics{};
+            };
+        } // namespace Transaction
+    } // namespace UART
+} // namespace Omega
@@ -24,10 +24,14 @@
 
 #include <cstdint>
 #include <functional>
+#include <span>
 #include <vector>
 
 #include "OmegaUtilityDriver/UtilityDriver.hpp"
 
+#include "OmegaUARTController/BufferPool.hpp"
+#include "OmegaUARTController/Profile.hpp"
+
 #if defined(WINDOWS_UART)
 
 #include <windows.h>
@@ -70,7 +74,7 @@
 
 #include <driver/uart.h>
 
-#elif defined(LINUX_UART)
+#elif defined(LINUX_UART) || defined(VIRTUAL_UART)
 
 #define UART_DATA_5_BITS 5
 #define UART_DATA_6_BITS 6
@@ -96,17 +100,32 @@ namespace Omega
                 constexpr size_t PORT_NAME_SIZE{32};
 #elif defined(MACOSX_UART)
                 constexpr size_t PORT_NAME_SIZE{256};
-#elif defined(LINUX_UART)
+#elif defined(LINUX_UART) || defined(VIRTUAL_UART)
                 constexpr size_t PORT_NAME_SIZE{256};
 #endif
 
                 constexpr size_t INVALID_UART_HANDLE{0};
 
+#if defined(LINUX_UART)
+                constexpr size_t USB_STRING_SIZE{128};
+#endif
+
                 struct EnumeratedUARTPort
                 {
                         char m_friendly_portname[FRIENDLY_PORT_NAME_SIZE + 1]{0};
 #if !defined(ESP32XX_UART)
                         char m_port_name[PORT_NAME_SIZE + 1]{0};
+#endif
+#if defined(LINUX_UART)
+                        // Read from sysfs. Ports that are not behind USB keep the zero vid/pid, -1 and empty strings
+                        u16 m_vid{0};
+                        u16 m_pid{0};
+                        int m_interface_number{-1};
+                        char m_serial_number[USB_STRING_SIZE + 1]{0};
+                        char m_manufacturer[USB_STRING_SIZE + 1]{0};
+                        char m_product[USB_STRING_SIZE + 1]{0};
+                        // The /dev/serial/by-id link, empty until udev has made it
+                        char m_by_id_path[PORT_NAME_SIZE + 1]{0};
 #endif
                 };
 
@@ -147,17 +166,22 @@ namespace Omega
                 {
                         OmegaStatus status;
                         size_t size;
+                        // Set when in_timeout_ms elapsed before the request completed. size holds the partial count
+                        bool timed_out{false};
+                        // Set when an async operation's stop token was triggered first. size holds the partial count
+                        bool cancelled{false};
                 };
 
 #if defined(ESP32XX_UART)
                 [[nodiscard]] Handle init(uart_port_t in_port, OmegaGPIO in_tx, OmegaGPIO in_rx, Baudrate in_baudrate = 115200, DataBits in_databits = DataBits::eDATA_BITS_8, Parity in_parity = Parity::ePARITY_DISABLE, StopBits in_stopbits = StopBits::eSTOP_BITS_1);
-#elif defined(WINDOWS_UART) || defined(MACOSX_UART) || defined(LINUX_UART)
+#elif defined(WINDOWS_UART) || defined(MACOSX_UART) || defined(LINUX_UART) || defined(VIRTUAL_UART)
                 [[nodiscard]] std::vector<EnumeratedUARTPort> get_available_ports();
                 [[nodiscard]] Handle init(const char *in_port, Baudrate in_baudrate = 115200, DataBits in_databits = DataBits::eDATA_BITS_8, Parity in_parity = Parity::ePARITY_DISABLE, StopBits in_stopbits = StopBits::eSTOP_BITS_1);
 #endif
                 OmegaStatus connect(Handle in_handle);
                 bool is_connected(Handle in_handle);
                 OmegaStatus start(Handle in_handle, const std::function<void(const Handle, const u8 *, const size_t)> in_callback);
+                // A zero in_timeout_ms makes read() return whatever is already buffered and write() wait without a deadline
                 [[nodiscard]] Response read(Handle in_handle, u8 *out_buffer, const size_t in_read_bytes, u32 in_timeout_ms);
                 [[nodiscard]] Response write(Handle in_handle, const u8 *in_buffer, const size_t in_write_bytes, u32 in_timeout_ms);
                 Handle change_baudrate(Handle in_handle, Baudrate baudrate);
@@ -167,12 +191,168 @@ namespace Omega
 
                 OmegaStatus stop(Handle in_handle);
                 OmegaStatus disconnect(Handle in_handle);
+                // On Linux any thread may call deinit(), even while others are inside read()/write() on the handle or from one
+                // of its read callbacks. Calls blocked on the port return eFAILED and the tty is closed after the last of them
                 OmegaStatus deinit(const Handle);
 #if defined(ESP32XX_UART)
                 __attribute__((weak)) void on_data(const Omega::UART::Handle, const u8 *, const size_t);
-#elif defined(WINDOWS_UART) || defined(MACOSX_UART) || defined(LINUX_UART)
+#elif defined(WINDOWS_UART) || defined(MACOSX_UART) || defined(LINUX_UART) || defined(VIRTUAL_UART)
                 OmegaStatus add_on_connected_callback(Handle in_handle, std::function<void()> in_callback);
                 OmegaStatus add_on_disconnected_callback(Handle in_handle, std::function<void()> in_callback);
+#endif
+#if defined(MACOSX_UART) || defined(LINUX_UART) || defined(VIRTUAL_UART)
+                // Receives the pool block the bytes were read into. Keep a copy of the RxBuffer to hold on to the data.
+                // Read callbacks must be added before start()
+                OmegaStatus add_on_read_buffer_callback(Handle in_handle, std::function<void(const Handle, const RxBuffer &)> in_callback);
+                // Sizes the per-port RX block pool. Must be called before start()
+                OmegaStatus set_rx_buffer_pool(Handle in_handle, size_t in_block_size, size_t in_block_count);
+#endif
+#if defined(LINUX_UART)
+                struct RxDeliveryPolicy
+                {
+                        // Largest chunk handed to the read callbacks in one call
+                        size_t buffer_size{100};
+                        // Bytes to collect before the read callbacks are called
+                        size_t min_bytes{1};
+                        // Deliver a batch short of min_bytes once its first byte is this old. 0 waits for min_bytes indefinitely
+                        u32 max_latency_us{0};
+                        // Flag chunks that follow a silence longer than this many character times of the port's frame format.
+                        // 0 flags none
+                        float gap_characters{0};
+                };
+
+                // One delivery as seen by the chunk callbacks
+                struct RxChunk
+                {
+                        const u8 *data;
+                        size_t size;
+                        // Timers::now() right after the read() that completed the chunk returned
+                        u64 timestamp_us;
+                        // Silence on the line before the chunk's first byte, taking its bytes to have arrived back to back. The
+                        // first chunk counts from start(). Silences inside a batch held back by min_bytes are not seen
+                        u64 gap_us;
+                        // gap_us exceeded RxDeliveryPolicy::gap_characters
+                        bool gap;
+                };
+
+                enum class IOModel
+                {
+                        eTHREAD_PER_PORT, // one blocking reader thread per started handle
+                        eREACTOR,         // a single epoll thread serving every started handle
+                        eIO_URING,        // reads kept posted on one io_uring, reaped in bulk by a single thread
+                };
+
+                // Must be called while no handle is started. eIO_URING needs OMEGA_UART_CONTROLLER_IO_URING at build time and
+                // falls back to eREACTOR when the kernel does not offer it; get_io_model() reports the model in effect
+                OmegaStatus set_io_model(IOModel in_io_model);
+                IOModel get_io_model();
+                OmegaStatus add_on_read_callback(Handle in_handle, std::function<void(const Handle, const u8 *, const size_t)> in_callback);
+                // Like add_on_read_callback() with the chunk's RX timestamp and the silence before it. Must be added before start()
+                OmegaStatus add_on_read_chunk_callback(Handle in_handle, std::function<void(const Handle, const RxChunk &)> in_callback);
+                OmegaStatus start(Handle in_handle);
+                // Must be called before start(). Replaces a pool set with a different block size
+                OmegaStatus set_rx_delivery_policy(Handle in_handle, const RxDeliveryPolicy &in_policy);
+                RxDeliveryPolicy get_rx_delivery_policy(Handle in_handle);
+
+                struct WriteRequest
+                {
+                        Handle handle;
+                        const u8 *buffer;
+                        size_t size;
+                        Response response; // filled in by write_batch()
+                };
+
+                // With eIO_URING the writes to every started handle go out in one submission; requests for the same handle are
+                // written in order. Otherwise they fall back to write() one by one. in_timeout_ms bounds the whole batch
+                OmegaStatus write_batch(std::span<WriteRequest> io_requests, u32 in_timeout_ms);
+
+                enum class TuningResult
+                {
+                        eAPPLIED,
+                        eSKIPPED, // the device does not offer this knob
+                        eFAILED,
+                };
+                struct LowLatencyReport
+                {
+                        TuningResult async_low_latency; // ASYNC_LOW_LATENCY through TIOCSSERIAL
+                        TuningResult latency_timer;     // <device>/latency_timer in sysfs (FTDI and similar)
+                };
+
+                // Opt-in driver tuning for USB-serial adapters. Call right after init()
+                LowLatencyReport enable_low_latency(Handle in_handle, u8 in_latency_timer_ms = 1);
+
+                struct RxRingStatistics
+                {
+                        size_t capacity;
+                        size_t buffered;
+                        u64 overrun_bytes;
+                        u64 overrun_events;
+                };
+
+                // Routes received bytes into a per-port SPSC ring instead of the read callbacks. 0 disables it.
+                // Must be called before start(). rx_peek()/rx_commit() must be called from a single consumer thread
+                OmegaStatus set_rx_ring(Handle in_handle, size_t in_capacity);
+                std::span<const u8> rx_peek(Handle in_handle);
+                OmegaStatus rx_commit(Handle in_handle, size_t in_size);
+                RxRingStatistics get_rx_ring_statistics(Handle in_handle);
+
+                enum class PortEvent
+                {
+                        eADDED,
+                        eREMOVED,
+                };
+
+                // get_available_ports() answers from an index that kernel uevents, and inotify on /dev, keep up to date.
+                // Callbacks run on the index's monitor thread; ports present before the call are not replayed. Returns 0 on
+                // failure, otherwise the id to remove the callback with
+                [[nodiscard]] u64 add_on_port_event_callback(std::function<void(PortEvent, const EnumeratedUARTPort &)> in_callback);
+                // Once this returns from any other thread, the callback is no longer running and will not be called again
+                OmegaStatus remove_on_port_event_callback(u64 in_callback_id);
+                // /dev name prefixes the index tracks. ttyS, ttyUSB and ttyACM are there from the start
+                OmegaStatus add_port_pattern(const char *in_prefix);
+                OmegaStatus remove_port_pattern(const char *in_prefix);
+
+                struct PortIdentity
+                {
+                        u16 vid;
+                        u16 pid;
+                        const char *serial_number{nullptr}; // nullptr matches any serial number
+                        int interface_number{-1};           // -1 matches any interface
+                };
+
+                // Looks in_identity up in the port index. Fails unless exactly one indexed port matches
+                OmegaStatus find_port(const PortIdentity &in_identity, EnumeratedUARTPort &out_port);
+                [[nodiscard]] Handle init(const PortIdentity &in_identity, Baudrate in_baudrate = 115200, DataBits in_databits = DataBits::eDATA_BITS_8, Parity in_parity = Parity::ePARITY_DISABLE, StopBits in_stopbits = StopBits::eSTOP_BITS_1);
+#endif
+#if defined(VIRTUAL_UART)
+                // Fault injection for bytes arriving at a virtual port. Probabilities are per byte, except stalls which are
+                // per write() reaching the port and hold the line for stall_us before the bytes start to arrive
+                struct VirtualFaults
+                {
+                        double drop_probability{0};
+                        double bit_flip_probability{0};
+                        double stall_probability{0};
+                        u32 stall_us{0};
+                        u32 seed{1};
+                };
+
+                // Creates two in-memory ports wired to each other: what one end writes arrives at the other. Names are at most
+                // 236 characters so get_available_ports() can show each end's peer in full. Each end takes a single handle at
+                // a time. disconnect() on either end pulls the cable: writes from then on are lost, bytes already on the wire
+                // still arrive and both ends' disconnected callbacks are called. connect() plugs it back
+                OmegaStatus create_virtual_pair(const char *in_first, const char *in_second);
+                // Unplugs both ends of the pair in_port belongs to. Handles still open on them fail from then on and their
+                // disconnected callbacks are called
+                OmegaStatus destroy_virtual_pair(const char *in_port);
+                // Paces the bytes in_port writes at the line rate of its Configuration: start bit, data bits, parity bit and
+                // stop bits per byte. Off by default, which delivers as fast as memory allows
+                OmegaStatus set_virtual_line_rate(const char *in_port, bool in_enabled);
+                OmegaStatus set_virtual_faults(const char *in_port, const VirtualFaults &in_faults);
+#endif
+#if CONFIG_OMEGA_UART_CONTROLLER_PROFILE && (defined(LINUX_UART) || defined(ESP32XX_UART))
+                // Per-port traffic counters, compiled in by OMEGA_UART_CONTROLLER_PROFILE (Kconfig or CMake). Safe to call while
+                // the port is busy; diff two snapshots to get rates
+                ProfileSnapshot get_profile(Handle in_handle);
 #endif
         } // namespace UART
 } // namespace Omega
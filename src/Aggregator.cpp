@@ -0,0 +1,238 @@
+/**
+ * @file Aggregator.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 4:02:17 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Aggregator.cpp
+ * File Created: Saturday, 17th October 2026 4:02:17 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 4:02:17 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+
+#include "OmegaUARTController/Aggregator.hpp"
+#include "OmegaUARTController/Timers.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace FanIn
+        {
+            Aggregator::Source::Source(Handle in_handle, size_t in_depth, size_t in_slot_size)
+                : m_handle{in_handle}, m_mask{in_depth - 1}, m_slots{std::make_unique<Slot[]>(in_depth)}, m_data{std::make_unique<u8[]>(in_depth * in_slot_size)}
+            {
+            }
+
+            Aggregator::Aggregator(const AggregatorConfiguration &in_configuration)
+                : m_configuration{std::min<size_t>(in_configuration.max_sources, INVALID_SOURCE), std::bit_ceil(std::max<size_t>(2, in_configuration.queue_depth)),
+                                  std::max<size_t>(1, in_configuration.slot_size), in_configuration.max_latency_us},
+                  m_sources{std::make_unique<std::unique_ptr<Source>[]>(m_configuration.max_sources)}
+            {
+            }
+
+            u32 Aggregator::add_source(Handle in_handle)
+            {
+                const u32 source = m_source_count.load(std::memory_order_relaxed);
+                if (m_configuration.max_sources <= source)
+                {
+                    OMEGA_LOGE("Aggregator is full");
+                    return INVALID_SOURCE;
+                }
+                m_sources[source] = std::make_unique<Source>(in_handle, m_configuration.queue_depth, m_configuration.slot_size);
+                m_source_count.store(source + 1, std::memory_order_release);
+                return source;
+            }
+
+#if defined(LINUX_UART)
+            OmegaStatus Aggregator::subscribe(Handle in_handle)
+            {
+                const u32 source = add_source(in_handle);
+                if (INVALID_SOURCE == source)
+                {
+                    return eFAILED;
+                }
+                return add_on_read_chunk_callback(in_handle, [this, source](const Handle, const RxChunk &in_chunk)
+                                                  { UNUSED(push(source, in_chunk.data, in_chunk.size, in_chunk.timestamp_us)); });
+            }
+#endif
+
+            OmegaStatus Aggregator::push(u32 in_source, const u8 *in_data, size_t in_size, u64 in_timestamp_us)
+            {
+                if (m_source_count.load(std::memory_order_acquire) <= in_source || (0 < in_size && nullptr == in_data))
+                {
+                    OMEGA_LOGE("Invalid chunk");
+                    return eFAILED;
+                }
+                auto &source = *m_sources[in_source];
+                const size_t slot_size = m_configuration.slot_size;
+                const size_t span = std::max<size_t>(1, (in_size + slot_size - 1) / slot_size);
+                const size_t head = source.m_head.load(std::memory_order_relaxed);
+                if (source.m_mask + 1 - (head - source.m_cached_tail) < span)
+                {
+                    source.m_cached_tail = source.m_tail.load(std::memory_order_acquire);
+                    if (source.m_mask + 1 - (head - source.m_cached_tail) < span)
+                    {
+                        source.m_dropped.fetch_add(1, std::memory_order_relaxed);
+                        return eFAILED;
+                    }
+                }
+                for (size_t idx = 0; idx < span; ++idx)
+                {
+                    const size_t slot = (head + idx) & source.m_mask;
+                    const size_t size = std::min(slot_size, in_size - idx * slot_size);
+                    if (0 < size)
+                    {
+                        std::memcpy(source.m_data.get() + slot * slot_size, in_data + idx * slot_size, size);
+                    }
+                    source.m_slots[slot] = Slot{in_timestamp_us, size};
+                }
+                source.m_newest_us.store(in_timestamp_us, std::memory_order_relaxed);
+                source.m_chunks.fetch_add(1, std::memory_order_relaxed);
+                source.m_head.store(head + span, std::memory_order_release);
+                // pairs with the fence in wait(): either the consumer sees the slots or we see it asleep
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (m_sleeping.load(std::memory_order_relaxed))
+                {
+                    std::lock_guard lock{m_wakeup_mutex};
+                    m_wakeup.notify_one();
+                }
+                return eSUCCESS;
+            }
+
+            bool Aggregator::readable(const Source &in_source) const
+            {
+                return in_source.m_head.load(std::memory_order_acquire) != in_source.m_tail.load(std::memory_order_relaxed) + in_source.m_released;
+            }
+
+            // Puts in_source's next slot into the merge. False when its queue is drained
+            bool Aggregator::refill(u32 in_source)
+            {
+                const auto &source = *m_sources[in_source];
+                if (!readable(source))
+                {
+                    return false;
+                }
+                const size_t slot = (source.m_tail.load(std::memory_order_relaxed) + source.m_released) & source.m_mask;
+                m_heads.emplace(source.m_slots[slot].m_timestamp_us, in_source);
+                return true;
+            }
+
+            // Sleeps until in_until_us or until a producer pushes, charging the time to the sources the merge waits for
+            void Aggregator::wait(u64 in_now_us, u64 in_until_us)
+            {
+                {
+                    std::unique_lock lock{m_wakeup_mutex};
+                    m_sleeping.store(true, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (std::none_of(m_empty.begin(), m_empty.end(), [this](u32 in_source)
+                                     { return readable(*m_sources[in_source]); }))
+                    {
+                        UNUSED(m_wakeup.wait_for(lock, std::chrono::microseconds{in_until_us - in_now_us}));
+                    }
+                    m_sleeping.store(false, std::memory_order_relaxed);
+                }
+                if (m_heads.empty())
+                {
+                    return;
+                }
+                const u64 stalled_us = Timers::now() - in_now_us;
+                for (const u32 source : m_empty)
+                {
+                    m_sources[source]->m_stalls.fetch_add(1, std::memory_order_relaxed);
+                    m_sources[source]->m_stalled_us.fetch_add(stalled_us, std::memory_order_relaxed);
+                }
+            }
+
+            size_t Aggregator::dequeue(Event *out_events, size_t in_max, u32 in_timeout_ms)
+            {
+                for (u32 source_id = 0; source_id < m_merged_sources; ++source_id)
+                {
+                    if (auto &source = *m_sources[source_id]; 0 < source.m_released)
+                    {
+                        source.m_tail.store(source.m_tail.load(std::memory_order_relaxed) + source.m_released, std::memory_order_release);
+                        source.m_released = 0;
+                    }
+                }
+                for (const u32 source_count = m_source_count.load(std::memory_order_acquire); m_merged_sources < source_count; ++m_merged_sources)
+                {
+                    m_empty.push_back(m_merged_sources);
+                }
+                const u64 deadline_us = Timers::now() + static_cast<u64>(in_timeout_ms) * 1000;
+                size_t count = 0;
+                while (count < in_max)
+                {
+                    std::erase_if(m_empty, [this](u32 in_source)
+                                  { return refill(in_source); });
+                    const u64 now_us = Timers::now();
+                    if (!m_heads.empty())
+                    {
+                        const auto [timestamp_us, source_id] = m_heads.top();
+                        if (m_empty.empty() || timestamp_us + m_configuration.max_latency_us <= now_us)
+                        {
+                            m_heads.pop();
+                            auto &source = *m_sources[source_id];
+                            const size_t slot = (source.m_tail.load(std::memory_order_relaxed) + source.m_released) & source.m_mask;
+                            out_events[count++] = Event{source.m_handle, source_id, timestamp_us, source.m_data.get() + slot * m_configuration.slot_size, source.m_slots[slot].m_size};
+                            source.m_released++;
+                            if (timestamp_us < m_released_until_us)
+                            {
+                                source.m_late.fetch_add(1, std::memory_order_relaxed);
+                            }
+                            m_released_until_us = std::max(m_released_until_us, timestamp_us);
+                            if (!refill(source_id))
+                            {
+                                m_empty.push_back(source_id);
+                            }
+                            continue;
+                        }
+                    }
+                    // hand over what is ready rather than hold it for the rest of the batch
+                    if (0 < count || deadline_us <= now_us)
+                    {
+                        break;
+                    }
+                    wait(now_us, m_heads.empty() ? deadline_us : std::min(deadline_us, m_heads.top().first + m_configuration.max_latency_us));
+                }
+                return count;
+            }
+
+            std::vector<SourceStatistics> Aggregator::statistics() const
+            {
+                const u64 now_us = Timers::now();
+                const u32 source_count = m_source_count.load(std::memory_order_acquire);
+                std::vector<SourceStatistics> statistics;
+                statistics.reserve(source_count);
+                for (u32 source_id = 0; source_id < source_count; ++source_id)
+                {
+                    const auto &source = m_sources[source_id];
+                    const u64 newest_us = source->m_newest_us.load(std::memory_order_relaxed);
+                    statistics.push_back(SourceStatistics{
+                        .chunks = source->m_chunks.load(std::memory_order_relaxed),
+                        .dropped = source->m_dropped.load(std::memory_order_relaxed),
+                        .late = source->m_late.load(std::memory_order_relaxed),
+                        .stalls = source->m_stalls.load(std::memory_order_relaxed),
+                        .stalled_us = source->m_stalled_us.load(std::memory_order_relaxed),
+                        .lag_us = now_us > newest_us ? now_us - newest_us : 0,
+                    });
+                }
+                return statistics;
+            }
+        } // namespace FanIn
+    } // namespace UART
+} // namespace Omega
@@ -0,0 +1,205 @@
+/**
+ * @file BufferPool.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 11:02:18 am
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: BufferPool.cpp
+ * File Created: Saturday, 17th October 2026 11:02:18 am
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 11:02:18 am
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#include "OmegaUARTController/BufferPool.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        struct RxBuffer::Block
+        {
+            std::atomic<u32> m_references{0};
+            std::atomic<u32> m_next{0};
+            size_t m_size{0};
+            u8 *m_data{nullptr};
+            BufferPool *m_pool{nullptr};
+        };
+
+        RxBuffer::RxBuffer(const RxBuffer &in_other) : m_block{in_other.m_block}
+        {
+            if (nullptr != m_block)
+            {
+                m_block->m_references.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        RxBuffer::RxBuffer(RxBuffer &&in_other) noexcept : m_block{in_other.m_block}
+        {
+            in_other.m_block = nullptr;
+        }
+
+        RxBuffer &RxBuffer::operator=(const RxBuffer &in_other)
+        {
+            if (this != &in_other)
+            {
+                RxBuffer copy{in_other};
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        RxBuffer &RxBuffer::operator=(RxBuffer &&in_other) noexcept
+        {
+            if (this != &in_other)
+            {
+                reset();
+                m_block = in_other.m_block;
+                in_other.m_block = nullptr;
+            }
+            return *this;
+        }
+
+        RxBuffer::~RxBuffer()
+        {
+            reset();
+        }
+
+        const u8 *RxBuffer::data() const
+        {
+            return nullptr == m_block ? nullptr : m_block->m_data;
+        }
+
+        size_t RxBuffer::size() const
+        {
+            return nullptr == m_block ? 0 : m_block->m_size;
+        }
+
+        void RxBuffer::reset()
+        {
+            if (nullptr == m_block)
+            {
+                return;
+            }
+            if (1 == m_block->m_references.fetch_sub(1, std::memory_order_acq_rel))
+            {
+                m_block->m_pool->release(m_block);
+            }
+            m_block = nullptr;
+        }
+
+        BufferPool *BufferPool::create(size_t in_block_size, size_t in_block_count)
+        {
+            if (0 == in_block_size || 0 == in_block_count || UINT32_MAX <= in_block_count)
+            {
+                return nullptr;
+            }
+            // pool, block headers and block payloads share one allocation
+            const size_t header_size = sizeof(BufferPool) + in_block_count * sizeof(RxBuffer::Block);
+            const size_t padded_header_size = (header_size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+            auto *storage = static_cast<u8 *>(std::malloc(padded_header_size + in_block_size * in_block_count));
+            if (nullptr == storage)
+            {
+                return nullptr;
+            }
+            return new (storage) BufferPool{in_block_size, in_block_count, storage + padded_header_size};
+        }
+
+        BufferPool::BufferPool(size_t in_block_size, size_t in_block_count, u8 *in_storage)
+            : m_block_size{in_block_size}, m_block_count{in_block_count}, m_blocks{reinterpret_cast<RxBuffer::Block *>(this + 1)}
+        {
+            for (size_t idx = 0; idx < m_block_count; ++idx)
+            {
+                auto *block = new (&m_blocks[idx]) RxBuffer::Block{};
+                block->m_data = in_storage + idx * m_block_size;
+                block->m_pool = this;
+                block->m_next.store(idx + 1 < m_block_count ? idx + 2 : 0, std::memory_order_relaxed);
+            }
+            m_free_list.store(1, std::memory_order_release);
+        }
+
+        void BufferPool::retire()
+        {
+            unreference();
+        }
+
+        RxBuffer BufferPool::acquire()
+        {
+            u64 head = m_free_list.load(std::memory_order_acquire);
+            for (;;)
+            {
+                const u32 index = static_cast<u32>(head);
+                if (0 == index)
+                {
+                    m_exhausted_count.fetch_add(1, std::memory_order_relaxed);
+                    return {};
+                }
+                auto &block = m_blocks[index - 1];
+                const u64 next = ((head >> 32) + 1) << 32 | block.m_next.load(std::memory_order_relaxed);
+                if (m_free_list.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire))
+                {
+                    m_references.fetch_add(1, std::memory_order_relaxed);
+                    block.m_size = 0;
+                    block.m_references.store(1, std::memory_order_relaxed);
+                    return RxBuffer{&block};
+                }
+            }
+        }
+
+        u8 *BufferPool::writable_data(RxBuffer &in_buffer)
+        {
+            return nullptr == in_buffer.m_block ? nullptr : in_buffer.m_block->m_data;
+        }
+
+        void BufferPool::set_size(RxBuffer &in_buffer, size_t in_size)
+        {
+            if (nullptr != in_buffer.m_block)
+            {
+                in_buffer.m_block->m_size = in_size <= in_buffer.m_block->m_pool->m_block_size ? in_size : in_buffer.m_block->m_pool->m_block_size;
+            }
+        }
+
+        void BufferPool::release(RxBuffer::Block *in_block)
+        {
+            const u32 index = static_cast<u32>(in_block - m_blocks) + 1;
+            u64 head = m_free_list.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                in_block->m_next.store(static_cast<u32>(head), std::memory_order_relaxed);
+                const u64 next = ((head >> 32) + 1) << 32 | index;
+                if (m_free_list.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            unreference();
+        }
+
+        void BufferPool::unreference()
+        {
+            if (1 == m_references.fetch_sub(1, std::memory_order_acq_rel))
+            {
+                for (size_t idx = 0; idx < m_block_count; ++idx)
+                {
+                    m_blocks[idx].~Block();
+                }
+                this->~BufferPool();
+                std::free(this);
+            }
+        }
+    } // namespace UART
+} // namespace Omega
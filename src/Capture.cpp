@@ -0,0 +1,573 @@
+/**
+ * @file Capture.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 2:14:52 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Capture.cpp
+ * File Created: Saturday, 17th October 2026 2:14:52 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 2:14:52 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "OmegaUARTController/Capture.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace Capture
+        {
+            __internal__ constexpr char MAGIC[8]{'O', 'M', 'G', 'U', 'A', 'R', 'T', 'C'};
+            __internal__ constexpr u32 VERSION{1};
+            // Record kind of the port names, next to the Direction values
+            __internal__ constexpr u8 PORT_NAME_KIND{0xFF};
+            __internal__ constexpr u8 GAP_FLAG{0x01};
+            __internal__ constexpr u64 RECORD_ALIGNMENT{8};
+
+            // At offset 0. data_end is kept current on every append so an unfinished file can be scanned up to it
+            struct FileHeader
+            {
+                char m_magic[8];
+                u32 m_version;
+                u32 m_header_size;
+                u64 m_data_end;
+                // Written by the writer's destructor: the index entries, then the port table
+                u64 m_index_offset;
+                u64 m_index_count;
+                u64 m_ports_offset;
+                u64 m_ports_count;
+                u64 m_reserved;
+            };
+            static_assert(64 == sizeof(FileHeader));
+
+            // Followed by m_size bytes, padded to RECORD_ALIGNMENT
+            struct RecordHeader
+            {
+                u64 m_timestamp_us;
+                u32 m_size;
+                u32 m_gap_us;
+                u16 m_port;
+                u8 m_kind;
+                u8 m_flags;
+                u8 m_reserved[4];
+            };
+            static_assert(24 == sizeof(RecordHeader));
+
+            __internal__ constexpr u64 record_size(size_t in_data_size)
+            {
+                return (sizeof(RecordHeader) + in_data_size + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+            }
+
+            /* START: WRITER */
+            std::unique_ptr<Writer> Writer::create(const char *in_path, const WriterConfiguration &in_configuration)
+            {
+                if (nullptr == in_path || 0 == in_configuration.grow_size || 0 == in_configuration.index_interval || sizeof(FileHeader) > in_configuration.max_size)
+                {
+                    OMEGA_LOGE("Invalid capture configuration");
+                    return nullptr;
+                }
+                const int file = ::open(in_path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+                if (-1 == file)
+                {
+                    OMEGA_LOGE("Opening %s failed with %s", in_path, strerror(errno));
+                    return nullptr;
+                }
+                void *mapping = mmap(nullptr, in_configuration.max_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_NORESERVE, file, 0);
+                if (MAP_FAILED == mapping)
+                {
+                    OMEGA_LOGE("mmap failed with %s", strerror(errno));
+                    close(file);
+                    return nullptr;
+                }
+                std::unique_ptr<Writer> writer{new Writer{file, static_cast<u8 *>(mapping), in_configuration}};
+                if (!writer->reserve(sizeof(FileHeader)))
+                {
+                    return nullptr;
+                }
+                FileHeader header{};
+                std::memcpy(header.m_magic, MAGIC, sizeof(MAGIC));
+                header.m_version = VERSION;
+                header.m_header_size = sizeof(FileHeader);
+                header.m_data_end = sizeof(FileHeader);
+                std::memcpy(writer->m_mapping, &header, sizeof(header));
+                writer->m_end = sizeof(FileHeader);
+                writer->m_next_index_at = sizeof(FileHeader);
+                return writer;
+            }
+
+            Writer::Writer(int in_file, u8 *in_mapping, const WriterConfiguration &in_configuration)
+                : m_file{in_file}, m_mapping{in_mapping}, m_configuration{in_configuration}
+            {
+            }
+
+            Writer::~Writer()
+            {
+                std::lock_guard lock{m_mutex};
+                auto *header = reinterpret_cast<FileHeader *>(m_mapping);
+                u64 ports_size = 0;
+                for (const auto &port : m_ports)
+                {
+                    ports_size += sizeof(u16) + port.size();
+                }
+                const u64 index_size = m_index.size() * sizeof(IndexEntry);
+                if (sizeof(FileHeader) <= m_end && reserve(m_end + index_size + ports_size))
+                {
+                    u8 *footer = m_mapping + m_end;
+                    if (0 < index_size)
+                    {
+                        std::memcpy(footer, m_index.data(), index_size);
+                    }
+                    footer += index_size;
+                    for (const auto &port : m_ports)
+                    {
+                        const u16 name_size = static_cast<u16>(port.size());
+                        std::memcpy(footer, &name_size, sizeof(name_size));
+                        std::memcpy(footer + sizeof(name_size), port.data(), name_size);
+                        footer += sizeof(name_size) + name_size;
+                    }
+                    header->m_index_offset = m_end;
+                    header->m_index_count = m_index.size();
+                    header->m_ports_offset = m_end + index_size;
+                    header->m_ports_count = m_ports.size();
+                    m_end += index_size + ports_size;
+                }
+                UNUSED(munmap(m_mapping, m_configuration.max_size));
+                if (0 != ftruncate(m_file, static_cast<off_t>(m_end)))
+                {
+                    OMEGA_LOGE("ftruncate failed with %s", strerror(errno));
+                }
+                close(m_file);
+            }
+
+            // Expects m_mutex to be held. Grows the file to cover in_end
+            bool Writer::reserve(u64 in_end)
+            {
+                if (in_end <= m_file_size)
+                {
+                    return true;
+                }
+                if (in_end > m_configuration.max_size)
+                {
+                    return false;
+                }
+                const u64 file_size = std::min(m_configuration.max_size, (in_end + m_configuration.grow_size - 1) / m_configuration.grow_size * m_configuration.grow_size);
+                if (0 != ftruncate(m_file, static_cast<off_t>(file_size)))
+                {
+                    OMEGA_LOGE("ftruncate failed with %s", strerror(errno));
+                    return false;
+                }
+                m_file_size = file_size;
+                return true;
+            }
+
+            // Expects m_mutex to be held
+            void Writer::put(u16 in_port, u8 in_kind, const u8 *in_data, size_t in_size, u64 in_timestamp_us, u32 in_gap_us, bool in_gap)
+            {
+                const u64 size = record_size(in_size);
+                if (UINT32_MAX < in_size || !reserve(m_end + size))
+                {
+                    if (0 == m_dropped++)
+                    {
+                        OMEGA_LOGE("Capture is full, dropping records");
+                    }
+                    return;
+                }
+                const RecordHeader record{
+                    .m_timestamp_us = in_timestamp_us,
+                    .m_size = static_cast<u32>(in_size),
+                    .m_gap_us = in_gap_us,
+                    .m_port = in_port,
+                    .m_kind = in_kind,
+                    .m_flags = static_cast<u8>(in_gap ? GAP_FLAG : 0),
+                    .m_reserved = {0},
+                };
+                std::memcpy(m_mapping + m_end, &record, sizeof(record));
+                if (0 < in_size)
+                {
+                    std::memcpy(m_mapping + m_end + sizeof(record), in_data, in_size);
+                }
+                if (PORT_NAME_KIND != in_kind && m_end >= m_next_index_at)
+                {
+                    m_index.push_back({in_timestamp_us, m_end});
+                    m_next_index_at = m_end + m_configuration.index_interval;
+                }
+                m_end += size;
+                reinterpret_cast<FileHeader *>(m_mapping)->m_data_end = m_end;
+            }
+
+            u16 Writer::add_port(const char *in_name)
+            {
+                const std::string name{nullptr == in_name ? "" : in_name, nullptr == in_name ? 0 : std::min<size_t>(strlen(in_name), UINT16_MAX)};
+                std::lock_guard lock{m_mutex};
+                const u16 port = static_cast<u16>(m_ports.size());
+                m_ports.push_back(name);
+                // also in the stream, for a file whose port table never got written
+                put(port, PORT_NAME_KIND, reinterpret_cast<const u8 *>(name.data()), name.size(), 0, 0, false);
+                return port;
+            }
+
+            OmegaStatus Writer::append(u16 in_port, Direction in_direction, const u8 *in_data, size_t in_size, u64 in_timestamp_us, u32 in_gap_us, bool in_gap)
+            {
+                if (0 < in_size && nullptr == in_data)
+                {
+                    OMEGA_LOGE("Invalid record");
+                    return eFAILED;
+                }
+                std::lock_guard lock{m_mutex};
+                const u64 dropped = m_dropped;
+                put(in_port, static_cast<u8>(in_direction), in_data, in_size, in_timestamp_us, in_gap_us, in_gap);
+                return dropped == m_dropped ? eSUCCESS : eFAILED;
+            }
+
+#if defined(LINUX_UART)
+            std::function<void(const Handle, const RxChunk &)> Writer::chunk_callback(u16 in_port)
+            {
+                return [this, in_port](const Handle, const RxChunk &in_chunk)
+                {
+                    UNUSED(append(in_port, Direction::eRX, in_chunk.data, in_chunk.size, in_chunk.timestamp_us, static_cast<u32>(std::min<u64>(in_chunk.gap_us, UINT32_MAX)), in_chunk.gap));
+                };
+            }
+#endif
+
+            void Writer::flush()
+            {
+                std::lock_guard lock{m_mutex};
+                UNUSED(msync(m_mapping, m_end, MS_ASYNC));
+            }
+
+            u64 Writer::size() const
+            {
+                std::lock_guard lock{m_mutex};
+                return m_end;
+            }
+
+            u64 Writer::dropped() const
+            {
+                std::lock_guard lock{m_mutex};
+                return m_dropped;
+            }
+            /* END: WRITER */
+
+            /* START: READER */
+            std::unique_ptr<Reader> Reader::open(const char *in_path)
+            {
+                const int file = ::open(in_path, O_RDONLY | O_CLOEXEC);
+                if (-1 == file)
+                {
+                    OMEGA_LOGE("Opening %s failed with %s", in_path, strerror(errno));
+                    return nullptr;
+                }
+                struct stat file_stat{};
+                if (0 != fstat(file, &file_stat) || sizeof(FileHeader) > static_cast<u64>(file_stat.st_size))
+                {
+                    OMEGA_LOGE("%s is not a capture", in_path);
+                    close(file);
+                    return nullptr;
+                }
+                const size_t mapping_size = static_cast<size_t>(file_stat.st_size);
+                void *mapping = mmap(nullptr, mapping_size, PROT_READ, MAP_SHARED, file, 0);
+                // the mapping keeps the file referenced
+                close(file);
+                if (MAP_FAILED == mapping)
+                {
+                    OMEGA_LOGE("mmap failed with %s", strerror(errno));
+                    return nullptr;
+                }
+                std::unique_ptr<Reader> reader{new Reader{static_cast<const u8 *>(mapping), mapping_size}};
+                FileHeader header{};
+                std::memcpy(&header, mapping, sizeof(header));
+                if (0 != std::memcmp(header.m_magic, MAGIC, sizeof(MAGIC)) || VERSION != header.m_version || sizeof(FileHeader) != header.m_header_size)
+                {
+                    OMEGA_LOGE("%s is not a capture", in_path);
+                    return nullptr;
+                }
+                reader->m_data_end = std::clamp<u64>(header.m_data_end, sizeof(FileHeader), mapping_size);
+                if (!reader->load_footer())
+                {
+                    OMEGA_LOGW("%s has no index, scanning it", in_path);
+                    reader->scan();
+                }
+                reader->bounds();
+                reader->rewind();
+                return reader;
+            }
+
+            Reader::Reader(const u8 *in_mapping, size_t in_mapping_size) : m_mapping{in_mapping}, m_mapping_size{in_mapping_size}
+            {
+            }
+
+            Reader::~Reader()
+            {
+                UNUSED(munmap(const_cast<u8 *>(m_mapping), m_mapping_size));
+            }
+
+            bool Reader::load_footer()
+            {
+                FileHeader header{};
+                std::memcpy(&header, m_mapping, sizeof(header));
+                if (m_data_end != header.m_index_offset || header.m_ports_offset < header.m_index_offset ||
+                    (header.m_ports_offset - header.m_index_offset) / sizeof(IndexEntry) != header.m_index_count || m_mapping_size < header.m_ports_offset)
+                {
+                    return false;
+                }
+                m_index.resize(header.m_index_count);
+                if (0 < header.m_index_count)
+                {
+                    std::memcpy(m_index.data(), m_mapping + header.m_index_offset, header.m_index_count * sizeof(IndexEntry));
+                }
+                u64 offset = header.m_ports_offset;
+                for (u64 idx = 0; idx < header.m_ports_count; ++idx)
+                {
+                    u16 name_size = 0;
+                    if (offset + sizeof(name_size) > m_mapping_size)
+                    {
+                        return false;
+                    }
+                    std::memcpy(&name_size, m_mapping + offset, sizeof(name_size));
+                    offset += sizeof(name_size);
+                    if (offset + name_size > m_mapping_size)
+                    {
+                        return false;
+                    }
+                    m_ports.emplace_back(reinterpret_cast<const char *>(m_mapping + offset), name_size);
+                    offset += name_size;
+                }
+                m_indexed = true;
+                return true;
+            }
+
+            // Rebuilds the index and the port table from the records, at the writer's default index interval
+            void Reader::scan()
+            {
+                m_index.clear();
+                m_ports.clear();
+                const u64 index_interval = WriterConfiguration{}.index_interval;
+                u64 next_index_at = sizeof(FileHeader);
+                Record record{};
+                u8 kind = 0;
+                for (u64 offset = sizeof(FileHeader), next = 0; 0 != (next = read(offset, record, kind)); offset = next)
+                {
+                    if (PORT_NAME_KIND == kind)
+                    {
+                        if (m_ports.size() <= record.port)
+                        {
+                            m_ports.resize(record.port + 1);
+                        }
+                        m_ports[record.port].assign(reinterpret_cast<const char *>(record.data), record.size);
+                    }
+                    else if (offset >= next_index_at)
+                    {
+                        m_index.push_back({record.timestamp_us, offset});
+                        next_index_at = offset + index_interval;
+                    }
+                }
+            }
+
+            // The first data record's timestamp, and the latest one from the last index entry on
+            void Reader::bounds()
+            {
+                Record record{};
+                u8 kind = 0;
+                for (u64 offset = sizeof(FileHeader), next = 0; 0 != (next = read(offset, record, kind)); offset = next)
+                {
+                    if (PORT_NAME_KIND != kind)
+                    {
+                        m_first_timestamp_us = record.timestamp_us;
+                        break;
+                    }
+                }
+                for (u64 offset = m_index.empty() ? sizeof(FileHeader) : m_index.back().m_offset, next = 0; 0 != (next = read(offset, record, kind)); offset = next)
+                {
+                    if (PORT_NAME_KIND != kind)
+                    {
+                        m_last_timestamp_us = std::max(m_last_timestamp_us, record.timestamp_us);
+                    }
+                }
+            }
+
+            u64 Reader::read(u64 in_offset, Record &out_record, u8 &out_kind) const
+            {
+                if (in_offset + sizeof(RecordHeader) > m_data_end)
+                {
+                    return 0;
+                }
+                RecordHeader header{};
+                std::memcpy(&header, m_mapping + in_offset, sizeof(header));
+                const u64 next = in_offset + record_size(header.m_size);
+                if (next > m_data_end)
+                {
+                    return 0;
+                }
+                out_record = Record{
+                    .timestamp_us = header.m_timestamp_us,
+                    .port = header.m_port,
+                    .direction = static_cast<Direction>(header.m_kind),
+                    .gap = 0 != (header.m_flags & GAP_FLAG),
+                    .gap_us = header.m_gap_us,
+                    .data = m_mapping + in_offset + sizeof(header),
+                    .size = header.m_size,
+                };
+                out_kind = header.m_kind;
+                return next;
+            }
+
+            bool Reader::next(Record &out_record)
+            {
+                for (u8 kind = 0;;)
+                {
+                    const u64 next = read(m_cursor, out_record, kind);
+                    if (0 == next)
+                    {
+                        return false;
+                    }
+                    m_cursor = next;
+                    if (PORT_NAME_KIND != kind)
+                    {
+                        return true;
+                    }
+                }
+            }
+
+            void Reader::seek(u64 in_timestamp_us)
+            {
+                // the last entry stamped before in_timestamp_us, as records stamped in_timestamp_us may precede an entry equal to it
+                const auto later = std::lower_bound(m_index.begin(), m_index.end(), in_timestamp_us, [](const IndexEntry &in_entry, u64 in_timestamp_us)
+                                                    { return in_entry.m_timestamp_us < in_timestamp_us; });
+                m_cursor = m_index.begin() == later ? sizeof(FileHeader) : std::prev(later)->m_offset;
+                Record record{};
+                u8 kind = 0;
+                for (u64 next = 0; 0 != (next = read(m_cursor, record, kind)); m_cursor = next)
+                {
+                    if (PORT_NAME_KIND != kind && in_timestamp_us <= record.timestamp_us)
+                    {
+                        return;
+                    }
+                }
+            }
+
+            void Reader::rewind()
+            {
+                m_cursor = sizeof(FileHeader);
+            }
+            /* END: READER */
+
+            /* START: REPLAY */
+            Replayer::Replayer(Reader &io_reader) : m_reader{io_reader}
+            {
+            }
+
+            Replayer::Route &Replayer::route(u16 in_port, Handle in_handle)
+            {
+                if (m_routes.size() <= in_port)
+                {
+                    m_routes.resize(in_port + 1);
+                }
+                m_routes[in_port].m_handle = in_handle;
+                m_routes[in_port].m_routed = true;
+                return m_routes[in_port];
+            }
+
+            void Replayer::add_on_read_callback(u16 in_port, Handle in_handle, std::function<void(const Handle, const u8 *, const size_t)> in_callback)
+            {
+                route(in_port, in_handle).m_read_callbacks.push_back(std::move(in_callback));
+            }
+
+#if defined(LINUX_UART)
+            void Replayer::add_on_read_chunk_callback(u16 in_port, Handle in_handle, std::function<void(const Handle, const RxChunk &)> in_callback)
+            {
+                route(in_port, in_handle).m_read_chunk_callbacks.push_back(std::move(in_callback));
+            }
+#endif
+
+            ReplayStatistics Replayer::run(double in_speed, std::stop_token in_stop_token)
+            {
+                ReplayStatistics statistics{};
+                const auto started = std::chrono::steady_clock::now();
+                std::mutex pacing_mutex;
+                std::condition_variable_any pacing;
+                bool paced = false;
+                u64 first_timestamp_us = 0;
+                Record record{};
+                while (!in_stop_token.stop_requested() && m_reader.next(record))
+                {
+                    if (Direction::eRX != record.direction || m_routes.size() <= record.port || !m_routes[record.port].m_routed)
+                    {
+                        continue;
+                    }
+                    if (0 < in_speed)
+                    {
+                        if (!paced)
+                        {
+                            paced = true;
+                            first_timestamp_us = record.timestamp_us;
+                        }
+                        const std::chrono::duration<double, std::micro> offset{static_cast<double>(std::max(record.timestamp_us, first_timestamp_us) - first_timestamp_us) / in_speed};
+                        const auto due = started + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset);
+                        if (const auto now = std::chrono::steady_clock::now(); due > now)
+                        {
+                            // sleeps through silences of any length while still answering in_stop_token
+                            std::unique_lock lock{pacing_mutex};
+                            UNUSED(pacing.wait_until(lock, in_stop_token, due, []
+                                                     { return false; }));
+                            if (in_stop_token.stop_requested())
+                            {
+                                break;
+                            }
+                        }
+                        else
+                        {
+                            statistics.max_lateness_us = std::max<u64>(statistics.max_lateness_us, std::chrono::duration_cast<std::chrono::microseconds>(now - due).count());
+                        }
+                    }
+                    const auto &route = m_routes[record.port];
+                    for (const auto &user_callback : route.m_read_callbacks)
+                    {
+                        user_callback(route.m_handle, record.data, record.size);
+                    }
+#if defined(LINUX_UART)
+                    if (!route.m_read_chunk_callbacks.empty())
+                    {
+                        const RxChunk rx_chunk{
+                            .data = record.data,
+                            .size = record.size,
+                            .timestamp_us = record.timestamp_us,
+                            .gap_us = record.gap_us,
+                            .gap = record.gap,
+                        };
+                        for (const auto &user_callback : route.m_read_chunk_callbacks)
+                        {
+                            user_callback(route.m_handle, rx_chunk);
+                        }
+                    }
+#endif
+                    statistics.records++;
+                    statistics.bytes += record.size;
+                }
+                return statistics;
+            }
+            /* END: REPLAY */
+        } // namespace Capture
+    } // namespace UART
+} // namespace Omega
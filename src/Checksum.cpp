@@ -0,0 +1,402 @@
+/**
+ * @file Checksum.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 2:41:37 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Checksum.cpp
+ * File Created: Saturday, 17th October 2026 2:41:37 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 2:41:37 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define CHECKSUM_X86_SIMD 1
+#endif
+
+#include "OmegaUARTController/Checksum.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace Checksum
+        {
+            /* START: TABLES */
+            template <typename T>
+            struct SlicingTables
+            {
+                T table[8][256];
+            };
+
+            // LSB-first: the register shifts right and the polynomial is bit reversed
+            template <typename T>
+            __internal__ constexpr SlicingTables<T> make_reflected_tables(T in_polynomial)
+            {
+                SlicingTables<T> tables{};
+                for (u32 byte = 0; byte < 256; ++byte)
+                {
+                    T crc = static_cast<T>(byte);
+                    for (int bit = 0; bit < 8; ++bit)
+                        crc = (crc & 1) ? static_cast<T>((crc >> 1) ^ in_polynomial) : static_cast<T>(crc >> 1);
+                    tables.table[0][byte] = crc;
+                }
+                for (u32 byte = 0; byte < 256; ++byte)
+                {
+                    for (int slice = 1; slice < 8; ++slice)
+                    {
+                        const T previous = tables.table[slice - 1][byte];
+                        tables.table[slice][byte] = static_cast<T>((previous >> 8) ^ tables.table[0][previous & 0xFF]);
+                    }
+                }
+                return tables;
+            }
+
+            // MSB-first: the register shifts left. Tables hold the register left-aligned to its width
+            template <typename T>
+            __internal__ constexpr SlicingTables<T> make_normal_tables(T in_polynomial)
+            {
+                constexpr int width = 8 * sizeof(T);
+                constexpr T top_bit = static_cast<T>(T{1} << (width - 1));
+                SlicingTables<T> tables{};
+                for (u32 byte = 0; byte < 256; ++byte)
+                {
+                    T crc = static_cast<T>(static_cast<T>(byte) << (width - 8));
+                    for (int bit = 0; bit < 8; ++bit)
+                        crc = (crc & top_bit) ? static_cast<T>((crc << 1) ^ in_polynomial) : static_cast<T>(crc << 1);
+                    tables.table[0][byte] = crc;
+                }
+                for (u32 byte = 0; byte < 256; ++byte)
+                {
+                    for (int slice = 1; slice < 8; ++slice)
+                    {
+                        const T previous = tables.table[slice - 1][byte];
+                        const T shifted = 8 == width ? T{0} : static_cast<T>(previous << 8);
+                        tables.table[slice][byte] = static_cast<T>(shifted ^ tables.table[0][(previous >> (width - 8)) & 0xFF]);
+                    }
+                }
+                return tables;
+            }
+
+            __internal__ constexpr auto s_crc8_tables = make_normal_tables<u8>(0x07);
+            __internal__ constexpr auto s_crc16_ccitt_tables = make_normal_tables<u16>(0x1021);
+            __internal__ constexpr auto s_crc16_modbus_tables = make_reflected_tables<u16>(0xA001);
+            __internal__ constexpr auto s_crc32_tables = make_reflected_tables<u32>(0xEDB88320);
+            __internal__ constexpr auto s_crc32c_tables = make_reflected_tables<u32>(0x82F63B78);
+            /* END: TABLES */
+
+            /* START: SLICING BY 8 */
+            __internal__ inline u32 load_le32(const u8 *in_data)
+            {
+                if constexpr (std::endian::native == std::endian::little)
+                {
+                    u32 value;
+                    std::memcpy(&value, in_data, sizeof(value));
+                    return value;
+                }
+                return static_cast<u32>(in_data[0]) | static_cast<u32>(in_data[1]) << 8 | static_cast<u32>(in_data[2]) << 16 | static_cast<u32>(in_data[3]) << 24;
+            }
+
+            template <typename T>
+            __internal__ u32 reflected_slicing_by_8(const SlicingTables<T> &in_tables, u32 in_crc, const u8 *in_data, size_t in_size)
+            {
+                const auto &t = in_tables.table;
+                for (; 8 <= in_size; in_data += 8, in_size -= 8)
+                {
+                    const u32 first = load_le32(in_data) ^ in_crc;
+                    const u32 second = load_le32(in_data + 4);
+                    in_crc = t[7][first & 0xFF] ^ t[6][(first >> 8) & 0xFF] ^ t[5][(first >> 16) & 0xFF] ^ t[4][first >> 24] ^
+                             t[3][second & 0xFF] ^ t[2][(second >> 8) & 0xFF] ^ t[1][(second >> 16) & 0xFF] ^ t[0][second >> 24];
+                }
+                for (; 0 < in_size; ++in_data, --in_size)
+                {
+                    in_crc = (in_crc >> 8) ^ t[0][(in_crc ^ *in_data) & 0xFF];
+                }
+                return in_crc;
+            }
+
+            template <typename T>
+            __internal__ u32 normal_slicing_by_8(const SlicingTables<T> &in_tables, u32 in_crc, const u8 *in_data, size_t in_size)
+            {
+                constexpr int width = 8 * sizeof(T);
+                const auto &t = in_tables.table;
+                T crc = static_cast<T>(in_crc);
+                for (; 8 <= in_size; in_data += 8, in_size -= 8)
+                {
+                    // the register overlaps the first width / 8 bytes of the block
+                    u8 block[8];
+                    std::memcpy(block, in_data, sizeof(block));
+                    for (int idx = 0; idx < width / 8; ++idx)
+                        block[idx] ^= static_cast<u8>(crc >> (width - 8 * (idx + 1)));
+                    crc = static_cast<T>(t[7][block[0]] ^ t[6][block[1]] ^ t[5][block[2]] ^ t[4][block[3]] ^
+                                         t[3][block[4]] ^ t[2][block[5]] ^ t[1][block[6]] ^ t[0][block[7]]);
+                }
+                for (; 0 < in_size; ++in_data, --in_size)
+                {
+                    const u8 index = static_cast<u8>((crc >> (width - 8)) ^ *in_data);
+                    crc = static_cast<T>((8 == width ? T{0} : static_cast<T>(crc << 8)) ^ t[0][index]);
+                }
+                return crc;
+            }
+            /* END: SLICING BY 8 */
+
+#if CHECKSUM_X86_SIMD
+            /* START: X86 */
+            __internal__ bool has_pclmul()
+            {
+                __internal__ const bool s_has_pclmul = []
+                {
+                    __builtin_cpu_init();
+                    return 0 != __builtin_cpu_supports("pclmul") && 0 != __builtin_cpu_supports("sse4.1");
+                }();
+                return s_has_pclmul;
+            }
+
+            __internal__ bool has_sse42()
+            {
+                __internal__ const bool s_has_sse42 = []
+                {
+                    __builtin_cpu_init();
+                    return 0 != __builtin_cpu_supports("sse4.2");
+                }();
+                return s_has_sse42;
+            }
+
+            __attribute__((target("sse4.2"))) __internal__ u32 crc32c_sse42(u32 in_crc, const u8 *in_data, size_t in_size)
+            {
+                u64 crc = in_crc;
+                for (; 8 <= in_size; in_data += 8, in_size -= 8)
+                {
+                    u64 value;
+                    std::memcpy(&value, in_data, sizeof(value));
+                    crc = _mm_crc32_u64(crc, value);
+                }
+                u32 crc32 = static_cast<u32>(crc);
+                for (; 0 < in_size; ++in_data, --in_size)
+                {
+                    crc32 = _mm_crc32_u8(crc32, *in_data);
+                }
+                return crc32;
+            }
+
+            // Folding with carry-less multiplication, after Intel's "Fast CRC Computation for Generic Polynomials Using
+            // PCLMULQDQ Instruction". Consumes whole 16 byte blocks of at least 64 bytes, the caller handles the tail
+            __attribute__((target("pclmul,sse4.1"))) __internal__ u32 crc32_pclmul_blocks(u32 in_crc, const u8 *in_data, size_t in_size)
+            {
+                alignas(16) static const u64 k1k2[] = {0x0154442bd4, 0x01c6e41596};
+                alignas(16) static const u64 k3k4[] = {0x01751997d0, 0x00ccaa009e};
+                alignas(16) static const u64 k5k0[] = {0x0163cd6124, 0x0000000000};
+                alignas(16) static const u64 poly[] = {0x01db710641, 0x01f7011641};
+
+                __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_data + 0x00));
+                __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_data + 0x10));
+                __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_data + 0x20));
+                __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_data + 0x30));
+                x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(in_crc)));
+                __m128i x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k1k2));
+                in_data += 64;
+                in_size -= 64;
+
+                // four lanes in parallel while 64 byte blocks remain
+                for (; 64 <= in_size; in_data += 64, in_size -= 64)
+                {
+                    const __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+                    const __m128i x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+                    const __m128i x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+                    const __m128i x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+                    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+                    x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+                    x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+                    x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+                    x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_data + 0x00)));
+                    x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_data + 0x10)));
+                    x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_data + 0x20)));
+                    x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_data + 0x30)));
+                }
+
+                // fold the four lanes into one
+                x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k3k4));
+                for (const __m128i next : {x2, x3, x4})
+                {
+                    const __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+                    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+                    x1 = _mm_xor_si128(_mm_xor_si128(x1, next), x5);
+                }
+
+                // remaining 16 byte blocks
+                for (; 16 <= in_size; in_data += 16, in_size -= 16)
+                {
+                    const __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+                    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+                    x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_data))), x5);
+                }
+
+                // 128 -> 64 bits
+                __m128i x2_fold = _mm_clmulepi64_si128(x1, x0, 0x10);
+                const __m128i low_mask = _mm_setr_epi32(~0, 0, ~0, 0);
+                x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2_fold);
+                x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(k5k0));
+                x2_fold = _mm_srli_si128(x1, 4);
+                x1 = _mm_and_si128(x1, low_mask);
+                x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+                x1 = _mm_xor_si128(x1, x2_fold);
+
+                // Barrett reduction to 32 bits
+                x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(poly));
+                x2_fold = _mm_and_si128(x1, low_mask);
+                x2_fold = _mm_clmulepi64_si128(x2_fold, x0, 0x10);
+                x2_fold = _mm_and_si128(x2_fold, low_mask);
+                x2_fold = _mm_clmulepi64_si128(x2_fold, x0, 0x00);
+                x1 = _mm_xor_si128(x1, x2_fold);
+                return static_cast<u32>(_mm_extract_epi32(x1, 1));
+            }
+
+            __internal__ u32 crc32_pclmul(u32 in_crc, const u8 *in_data, size_t in_size)
+            {
+                if (64 <= in_size)
+                {
+                    const size_t folded = in_size & ~size_t{15};
+                    in_crc = crc32_pclmul_blocks(in_crc, in_data, folded);
+                    in_data += folded;
+                    in_size -= folded;
+                }
+                return reflected_slicing_by_8(s_crc32_tables, in_crc, in_data, in_size);
+            }
+            /* END: X86 */
+#endif
+
+            bool is_supported(Algorithm in_algorithm, Kernel in_kernel)
+            {
+                switch (in_kernel)
+                {
+                case Kernel::eAUTO:
+                case Kernel::eSLICING_BY_8:
+                    return true;
+#if CHECKSUM_X86_SIMD
+                case Kernel::ePCLMULQDQ:
+                    return Algorithm::eCRC32 == in_algorithm && has_pclmul();
+                case Kernel::eSSE42:
+                    return Algorithm::eCRC32C == in_algorithm && has_sse42();
+#else
+                case Kernel::ePCLMULQDQ:
+                case Kernel::eSSE42:
+                    return false;
+#endif
+                }
+                return false;
+            }
+
+            __internal__ Kernel select_kernel(Algorithm in_algorithm, Kernel in_kernel)
+            {
+                if (Kernel::eAUTO != in_kernel)
+                {
+                    return is_supported(in_algorithm, in_kernel) ? in_kernel : Kernel::eSLICING_BY_8;
+                }
+                if (is_supported(in_algorithm, Kernel::eSSE42))
+                    return Kernel::eSSE42;
+                if (is_supported(in_algorithm, Kernel::ePCLMULQDQ))
+                    return Kernel::ePCLMULQDQ;
+                return Kernel::eSLICING_BY_8;
+            }
+
+            __internal__ constexpr u32 initial_state(Algorithm in_algorithm)
+            {
+                switch (in_algorithm)
+                {
+                case Algorithm::eCRC8:
+                    return 0x00;
+                case Algorithm::eCRC16_CCITT:
+                case Algorithm::eCRC16_MODBUS:
+                    return 0xFFFF;
+                case Algorithm::eCRC32:
+                case Algorithm::eCRC32C:
+                    return 0xFFFFFFFF;
+                }
+                return 0;
+            }
+
+            Crc::Crc(Algorithm in_algorithm, Kernel in_kernel)
+                : m_algorithm{in_algorithm}, m_kernel{select_kernel(in_algorithm, in_kernel)}, m_state{initial_state(in_algorithm)}
+            {
+            }
+
+            void Crc::reset()
+            {
+                m_state = initial_state(m_algorithm);
+            }
+
+            void Crc::update(const u8 *in_data, size_t in_size)
+            {
+                if (nullptr == in_data || 0 == in_size)
+                {
+                    return;
+                }
+                switch (m_algorithm)
+                {
+                case Algorithm::eCRC8:
+                    m_state = normal_slicing_by_8(s_crc8_tables, m_state, in_data, in_size);
+                    break;
+                case Algorithm::eCRC16_CCITT:
+                    m_state = normal_slicing_by_8(s_crc16_ccitt_tables, m_state, in_data, in_size);
+                    break;
+                case Algorithm::eCRC16_MODBUS:
+                    m_state = reflected_slicing_by_8(s_crc16_modbus_tables, m_state, in_data, in_size);
+                    break;
+                case Algorithm::eCRC32:
+#if CHECKSUM_X86_SIMD
+                    if (Kernel::ePCLMULQDQ == m_kernel)
+                    {
+                        m_state = crc32_pclmul(m_state, in_data, in_size);
+                        break;
+                    }
+#endif
+                    m_state = reflected_slicing_by_8(s_crc32_tables, m_state, in_data, in_size);
+                    break;
+                case Algorithm::eCRC32C:
+#if CHECKSUM_X86_SIMD
+                    if (Kernel::eSSE42 == m_kernel)
+                    {
+                        m_state = crc32c_sse42(m_state, in_data, in_size);
+                        break;
+                    }
+#endif
+                    m_state = reflected_slicing_by_8(s_crc32c_tables, m_state, in_data, in_size);
+                    break;
+                }
+            }
+
+            u32 Crc::value() const
+            {
+                switch (m_algorithm)
+                {
+                case Algorithm::eCRC32:
+                case Algorithm::eCRC32C:
+                    return ~m_state;
+                default:
+                    return m_state;
+                }
+            }
+
+            u32 compute(Algorithm in_algorithm, const u8 *in_data, size_t in_size)
+            {
+                Crc crc{in_algorithm};
+                crc.update(in_data, in_size);
+                return crc.value();
+            }
+        } // namespace Checksum
+    } // namespace UART
+} // namespace Omega
@@ -0,0 +1,285 @@
+/**
+ * @file Dispatch.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 5:41:09 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Dispatch.cpp
+ * File Created: Saturday, 17th October 2026 5:41:09 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 5:41:09 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <algorithm>
+
+#include "OmegaUARTController/Dispatch.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace Dispatch
+        {
+            // Set on the pool's workers so work posting more work keeps it on the same worker
+            __internal__ thread_local const Pool *t_pool{nullptr};
+            __internal__ thread_local u32 t_worker{0};
+
+            Pool::Pool(const PoolConfiguration &in_configuration)
+                : m_configuration{in_configuration}, m_lanes{std::make_unique<std::unique_ptr<LaneState>[]>(in_configuration.max_lanes)}
+            {
+                const size_t worker_count = 0 == in_configuration.workers ? std::max(1u, std::thread::hardware_concurrency()) : in_configuration.workers;
+                for (size_t idx = 0; idx < worker_count; ++idx)
+                {
+                    m_workers.push_back(std::make_unique<Worker>());
+                }
+                for (size_t idx = 0; idx < worker_count; ++idx)
+                {
+                    m_workers[idx]->m_thread = std::thread{&Pool::work, this, static_cast<u32>(idx)};
+                }
+            }
+
+            Pool::~Pool()
+            {
+                drain();
+                {
+                    std::lock_guard lock{m_wakeup_mutex};
+                    m_stopping = true;
+                }
+                m_wakeup.notify_all();
+                for (auto &worker : m_workers)
+                {
+                    worker->m_thread.join();
+                }
+            }
+
+            Lane Pool::add_lane()
+            {
+                const u32 lane = m_lane_count.load(std::memory_order_relaxed);
+                if (m_configuration.max_lanes <= lane)
+                {
+                    OMEGA_LOGE("Dispatch pool is out of lanes");
+                    return INVALID_LANE;
+                }
+                m_lanes[lane] = std::make_unique<LaneState>();
+                m_lanes[lane]->m_worker.store(lane % m_workers.size(), std::memory_order_relaxed);
+                m_lane_count.store(lane + 1, std::memory_order_release);
+                return lane;
+            }
+
+            OmegaStatus Pool::post(Lane in_lane, std::function<void()> in_work)
+            {
+                if (!in_work)
+                {
+                    OMEGA_LOGE("Invalid work");
+                    return eFAILED;
+                }
+                return enqueue(in_lane, Work{std::move(in_work), {}});
+            }
+
+#if defined(MACOSX_UART) || defined(LINUX_UART) || defined(VIRTUAL_UART)
+            Lane Pool::subscribe(Handle in_handle, std::function<void(const Handle, const RxBuffer &)> in_callback)
+            {
+                const Lane lane = add_lane();
+                if (INVALID_LANE == lane)
+                {
+                    return INVALID_LANE;
+                }
+                m_lanes[lane]->m_handle = in_handle;
+                m_lanes[lane]->m_subscriber = std::move(in_callback);
+                const OmegaStatus status = add_on_read_buffer_callback(in_handle, [this, lane](const Handle, const RxBuffer &in_buffer)
+                                                                       { UNUSED(enqueue(lane, Work{{}, in_buffer})); });
+                return eSUCCESS == status ? lane : INVALID_LANE;
+            }
+#endif
+
+            OmegaStatus Pool::enqueue(u32 in_lane, Work &&in_work)
+            {
+                if (m_lane_count.load(std::memory_order_acquire) <= in_lane)
+                {
+                    OMEGA_LOGE("Invalid lane");
+                    return eFAILED;
+                }
+                auto &lane = *m_lanes[in_lane];
+                bool idle;
+                {
+                    std::lock_guard lock{lane.m_mutex};
+                    if (0 != m_configuration.lane_depth && m_configuration.lane_depth <= lane.m_queue.size())
+                    {
+                        lane.m_dropped.fetch_add(1, std::memory_order_relaxed);
+                        return eFAILED;
+                    }
+                    lane.m_queue.push_back(std::move(in_work));
+                    if (lane.m_max_queued.load(std::memory_order_relaxed) < lane.m_queue.size())
+                    {
+                        lane.m_max_queued.store(lane.m_queue.size(), std::memory_order_relaxed);
+                    }
+                    m_outstanding.fetch_add(1, std::memory_order_relaxed);
+                    idle = !lane.m_scheduled;
+                    lane.m_scheduled = true;
+                }
+                if (idle)
+                {
+                    schedule(in_lane, this == t_pool ? t_worker : lane.m_worker.load(std::memory_order_relaxed));
+                }
+                return eSUCCESS;
+            }
+
+            void Pool::schedule(u32 in_lane, u32 in_worker)
+            {
+                // Counted before it is visible so a worker that takes it never sees the count below zero
+                m_runnable.fetch_add(1, std::memory_order_seq_cst);
+                {
+                    auto &worker = *m_workers[in_worker];
+                    std::lock_guard lock{worker.m_mutex};
+                    worker.m_lanes.push_back(in_lane);
+                }
+                // pairs with the increment in work(): either a worker sees the lane or we see it asleep
+                if (0 < m_sleeping.load(std::memory_order_seq_cst))
+                {
+                    std::lock_guard lock{m_wakeup_mutex};
+                    m_wakeup.notify_one();
+                }
+            }
+
+            // Takes the oldest lane from in_worker's own deque, or else the newest one from another worker's
+            bool Pool::take(u32 in_worker, u32 &out_lane)
+            {
+                const size_t worker_count = m_workers.size();
+                for (size_t idx = 0; idx < worker_count; ++idx)
+                {
+                    auto &worker = *m_workers[(in_worker + idx) % worker_count];
+                    std::lock_guard lock{worker.m_mutex};
+                    if (worker.m_lanes.empty())
+                    {
+                        continue;
+                    }
+                    if (0 == idx)
+                    {
+                        out_lane = worker.m_lanes.front();
+                        worker.m_lanes.pop_front();
+                    }
+                    else
+                    {
+                        out_lane = worker.m_lanes.back();
+                        worker.m_lanes.pop_back();
+                    }
+                    m_runnable.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+                return false;
+            }
+
+            // Runs everything in_lane holds, then puts it back behind the other lanes if more arrived meanwhile
+            void Pool::run(u32 in_worker, u32 in_lane)
+            {
+                auto &lane = *m_lanes[in_lane];
+                if (in_worker != lane.m_worker.load(std::memory_order_relaxed))
+                {
+                    lane.m_steals.fetch_add(1, std::memory_order_relaxed);
+                    lane.m_worker.store(in_worker, std::memory_order_relaxed);
+                }
+                {
+                    std::lock_guard lock{lane.m_mutex};
+                    std::swap(lane.m_queue, lane.m_running);
+                }
+                for (const auto &work : lane.m_running)
+                {
+                    if (work.m_function)
+                    {
+                        work.m_function();
+                    }
+                    else
+                    {
+                        lane.m_subscriber(lane.m_handle, work.m_buffer);
+                    }
+                }
+                const size_t executed = lane.m_running.size();
+                // Gives the buffers back to their pool right away
+                lane.m_running.clear();
+                lane.m_executed.fetch_add(executed, std::memory_order_relaxed);
+                bool again;
+                {
+                    std::lock_guard lock{lane.m_mutex};
+                    again = !lane.m_queue.empty();
+                    lane.m_scheduled = again;
+                }
+                if (again)
+                {
+                    schedule(in_lane, in_worker);
+                }
+                // pairs with the increment in drain()
+                if (executed == m_outstanding.fetch_sub(executed, std::memory_order_seq_cst) && 0 < m_draining.load(std::memory_order_seq_cst))
+                {
+                    std::lock_guard lock{m_wakeup_mutex};
+                    m_drained.notify_all();
+                }
+            }
+
+            void Pool::work(u32 in_worker)
+            {
+                t_pool = this;
+                t_worker = in_worker;
+                for (;;)
+                {
+                    u32 lane;
+                    if (take(in_worker, lane))
+                    {
+                        run(in_worker, lane);
+                        continue;
+                    }
+                    std::unique_lock lock{m_wakeup_mutex};
+                    m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+                    m_wakeup.wait(lock, [this]
+                                  { return m_stopping || 0 < m_runnable.load(std::memory_order_seq_cst); });
+                    m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+                    if (m_stopping && 0 == m_runnable.load(std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+                }
+            }
+
+            void Pool::drain()
+            {
+                std::unique_lock lock{m_wakeup_mutex};
+                m_draining.fetch_add(1, std::memory_order_seq_cst);
+                m_drained.wait(lock, [this]
+                               { return 0 == m_outstanding.load(std::memory_order_seq_cst); });
+                m_draining.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            std::vector<LaneStatistics> Pool::statistics() const
+            {
+                std::vector<LaneStatistics> statistics;
+                const u32 lane_count = m_lane_count.load(std::memory_order_acquire);
+                for (u32 idx = 0; idx < lane_count; ++idx)
+                {
+                    auto &lane = *m_lanes[idx];
+                    size_t queued;
+                    {
+                        std::lock_guard lock{lane.m_mutex};
+                        queued = lane.m_queue.size();
+                    }
+                    statistics.push_back(LaneStatistics{
+                        .executed = lane.m_executed.load(std::memory_order_relaxed),
+                        .dropped = lane.m_dropped.load(std::memory_order_relaxed),
+                        .queued = queued,
+                        .max_queued = lane.m_max_queued.load(std::memory_order_relaxed),
+                        .steals = lane.m_steals.load(std::memory_order_relaxed),
+                    });
+                }
+                return statistics;
+            }
+        } // namespace Dispatch
+    } // namespace UART
+} // namespace Omega
@@ -0,0 +1,626 @@
+/**
+ * @file Framing.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 1:20:05 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Framing.cpp
+ * File Created: Saturday, 17th October 2026 1:20:05 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 1:20:05 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))
+#include <immintrin.h>
+#define FRAMING_X86_SIMD 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define FRAMING_NEON_SIMD 1
+#endif
+
+#include "OmegaUARTController/Framing.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace Framing
+        {
+            __internal__ constexpr u8 SLIP_END{0xC0};
+            __internal__ constexpr u8 SLIP_ESC{0xDB};
+            __internal__ constexpr u8 SLIP_ESC_END{0xDC};
+            __internal__ constexpr u8 SLIP_ESC_ESC{0xDD};
+            __internal__ constexpr u8 COBS_DELIMITER{0x00};
+            __internal__ constexpr size_t COBS_MAX_BLOCK{254};
+
+            /* START: SCANNING */
+            __internal__ const u8 *find_byte_scalar(const u8 *in_begin, const u8 *in_end, u8 in_value)
+            {
+                for (; in_begin < in_end; ++in_begin)
+                {
+                    if (in_value == *in_begin)
+                        return in_begin;
+                }
+                return in_end;
+            }
+
+            __internal__ const u8 *find_either_scalar(const u8 *in_begin, const u8 *in_end, u8 in_first, u8 in_second)
+            {
+                for (; in_begin < in_end; ++in_begin)
+                {
+                    if (in_first == *in_begin || in_second == *in_begin)
+                        return in_begin;
+                }
+                return in_end;
+            }
+
+#if FRAMING_X86_SIMD
+            __internal__ const u8 *find_byte_sse2(const u8 *in_begin, const u8 *in_end, u8 in_value)
+            {
+                const __m128i needle = _mm_set1_epi8(static_cast<char>(in_value));
+                for (; 16 <= in_end - in_begin; in_begin += 16)
+                {
+                    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_begin));
+                    if (const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)); 0 != mask)
+                        return in_begin + __builtin_ctz(mask);
+                }
+                return find_byte_scalar(in_begin, in_end, in_value);
+            }
+
+            __internal__ const u8 *find_either_sse2(const u8 *in_begin, const u8 *in_end, u8 in_first, u8 in_second)
+            {
+                const __m128i first = _mm_set1_epi8(static_cast<char>(in_first));
+                const __m128i second = _mm_set1_epi8(static_cast<char>(in_second));
+                for (; 16 <= in_end - in_begin; in_begin += 16)
+                {
+                    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_begin));
+                    const __m128i matches = _mm_or_si128(_mm_cmpeq_epi8(chunk, first), _mm_cmpeq_epi8(chunk, second));
+                    if (const int mask = _mm_movemask_epi8(matches); 0 != mask)
+                        return in_begin + __builtin_ctz(mask);
+                }
+                return find_either_scalar(in_begin, in_end, in_first, in_second);
+            }
+
+            __attribute__((target("avx2"))) __internal__ const u8 *find_byte_avx2(const u8 *in_begin, const u8 *in_end, u8 in_value)
+            {
+                const __m256i needle = _mm256_set1_epi8(static_cast<char>(in_value));
+                for (; 32 <= in_end - in_begin; in_begin += 32)
+                {
+                    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in_begin));
+                    if (const u32 mask = static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle))); 0 != mask)
+                        return in_begin + __builtin_ctz(mask);
+                }
+                return find_byte_sse2(in_begin, in_end, in_value);
+            }
+
+            __attribute__((target("avx2"))) __internal__ const u8 *find_either_avx2(const u8 *in_begin, const u8 *in_end, u8 in_first, u8 in_second)
+            {
+                const __m256i first = _mm256_set1_epi8(static_cast<char>(in_first));
+                const __m256i second = _mm256_set1_epi8(static_cast<char>(in_second));
+                for (; 32 <= in_end - in_begin; in_begin += 32)
+                {
+                    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in_begin));
+                    const __m256i matches = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, first), _mm256_cmpeq_epi8(chunk, second));
+                    if (const u32 mask = static_cast<u32>(_mm256_movemask_epi8(matches)); 0 != mask)
+                        return in_begin + __builtin_ctz(mask);
+                }
+                return find_either_sse2(in_begin, in_end, in_first, in_second);
+            }
+
+            __internal__ bool has_avx2()
+            {
+                __internal__ const bool s_has_avx2 = []
+                {
+                    __builtin_cpu_init();
+                    return 0 != __builtin_cpu_supports("avx2");
+                }();
+                return s_has_avx2;
+            }
+#elif FRAMING_NEON_SIMD
+            // Narrows a 16 lane compare result to 4 bits per lane so the first match can be located with a single ctz
+            __internal__ inline u64 neon_match_mask(uint8x16_t in_matches)
+            {
+                return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(in_matches), 4)), 0);
+            }
+
+            __internal__ const u8 *find_byte_neon(const u8 *in_begin, const u8 *in_end, u8 in_value)
+            {
+                const uint8x16_t needle = vdupq_n_u8(in_value);
+                for (; 16 <= in_end - in_begin; in_begin += 16)
+                {
+                    if (const u64 mask = neon_match_mask(vceqq_u8(vld1q_u8(in_begin), needle)); 0 != mask)
+                        return in_begin + (__builtin_ctzll(mask) >> 2);
+                }
+                return find_byte_scalar(in_begin, in_end, in_value);
+            }
+
+            __internal__ const u8 *find_either_neon(const u8 *in_begin, const u8 *in_end, u8 in_first, u8 in_second)
+            {
+                const uint8x16_t first = vdupq_n_u8(in_first);
+                const uint8x16_t second = vdupq_n_u8(in_second);
+                for (; 16 <= in_end - in_begin; in_begin += 16)
+                {
+                    const uint8x16_t chunk = vld1q_u8(in_begin);
+                    if (const u64 mask = neon_match_mask(vorrq_u8(vceqq_u8(chunk, first), vceqq_u8(chunk, second))); 0 != mask)
+                        return in_begin + (__builtin_ctzll(mask) >> 2);
+                }
+                return find_either_scalar(in_begin, in_end, in_first, in_second);
+            }
+#endif
+
+            const u8 *find_byte(const u8 *in_begin, const u8 *in_end, u8 in_value)
+            {
+#if FRAMING_X86_SIMD
+                return has_avx2() ? find_byte_avx2(in_begin, in_end, in_value) : find_byte_sse2(in_begin, in_end, in_value);
+#elif FRAMING_NEON_SIMD
+                return find_byte_neon(in_begin, in_end, in_value);
+#else
+                return find_byte_scalar(in_begin, in_end, in_value);
+#endif
+            }
+
+            const u8 *find_either(const u8 *in_begin, const u8 *in_end, u8 in_first, u8 in_second)
+            {
+#if FRAMING_X86_SIMD
+                return has_avx2() ? find_either_avx2(in_begin, in_end, in_first, in_second) : find_either_sse2(in_begin, in_end, in_first, in_second);
+#elif FRAMING_NEON_SIMD
+                return find_either_neon(in_begin, in_end, in_first, in_second);
+#else
+                return find_either_scalar(in_begin, in_end, in_first, in_second);
+#endif
+            }
+            /* END: SCANNING */
+
+            /* START: ENCODERS */
+            size_t max_encoded_size(const FrameEncoding &in_encoding, size_t in_size)
+            {
+                switch (in_encoding.format)
+                {
+                case FrameFormat::eCOBS:
+                    return in_size + in_size / COBS_MAX_BLOCK + 2;
+                case FrameFormat::eSLIP:
+                    return 2 * in_size + 2;
+                case FrameFormat::eDELIMITER:
+                    return in_size + 1;
+                case FrameFormat::eLENGTH_PREFIXED:
+                    return in_size + in_encoding.length_size;
+                }
+                return 0;
+            }
+
+            __internal__ size_t encode_cobs(const u8 *in_payload, size_t in_size, u8 *out_buffer)
+            {
+                size_t write_index = 1;
+                size_t code_index = 0;
+                u8 code = 1;
+                const u8 *cursor = in_payload;
+                const u8 *const end = in_payload + in_size;
+                while (cursor < end)
+                {
+                    // copy everything up to the next zero or the end of the block in one go
+                    const u8 *zero = find_byte(cursor, std::min<const u8 *>(end, cursor + (0xFF - code)), COBS_DELIMITER);
+                    const size_t run = zero - cursor;
+                    std::memcpy(out_buffer + write_index, cursor, run);
+                    write_index += run;
+                    code += run;
+                    cursor = zero;
+                    if (0xFF != code && (cursor == end || COBS_DELIMITER != *cursor))
+                    {
+                        continue;
+                    }
+                    if (0xFF != code)
+                    {
+                        ++cursor; // the zero is implied by the code byte
+                    }
+                    out_buffer[code_index] = code;
+                    code_index = write_index++;
+                    code = 1;
+                }
+                out_buffer[code_index] = code;
+                out_buffer[write_index++] = COBS_DELIMITER;
+                return write_index;
+            }
+
+            __internal__ size_t encode_slip(const u8 *in_payload, size_t in_size, u8 *out_buffer)
+            {
+                size_t write_index = 0;
+                out_buffer[write_index++] = SLIP_END; // flushes any line noise the receiver collected
+                const u8 *cursor = in_payload;
+                const u8 *const end = in_payload + in_size;
+                while (cursor < end)
+                {
+                    const u8 *special = find_either(cursor, end, SLIP_END, SLIP_ESC);
+                    std::memcpy(out_buffer + write_index, cursor, special - cursor);
+                    write_index += special - cursor;
+                    if (special == end)
+                        break;
+                    out_buffer[write_index++] = SLIP_ESC;
+                    out_buffer[write_index++] = SLIP_END == *special ? SLIP_ESC_END : SLIP_ESC_ESC;
+                    cursor = special + 1;
+                }
+                out_buffer[write_index++] = SLIP_END;
+                return write_index;
+            }
+
+            size_t encode(const FrameEncoding &in_encoding, const u8 *in_payload, size_t in_size, u8 *out_buffer)
+            {
+                if ((nullptr == in_payload && 0 != in_size) || nullptr == out_buffer)
+                {
+                    return 0;
+                }
+                switch (in_encoding.format)
+                {
+                case FrameFormat::eCOBS:
+                    return encode_cobs(in_payload, in_size, out_buffer);
+                case FrameFormat::eSLIP:
+                    return encode_slip(in_payload, in_size, out_buffer);
+                case FrameFormat::eDELIMITER:
+                {
+                    std::memcpy(out_buffer, in_payload, in_size);
+                    out_buffer[in_size] = in_encoding.delimiter;
+                    return in_size + 1;
+                }
+                case FrameFormat::eLENGTH_PREFIXED:
+                {
+                    const u8 length_size = in_encoding.length_size;
+                    if (1 > length_size || 4 < length_size || (4 != length_size && in_size >= (size_t{1} << (8 * length_size))))
+                    {
+                        return 0;
+                    }
+                    for (u8 idx = 0; idx < length_size; ++idx)
+                    {
+                        const u8 shift = 8 * (in_encoding.big_endian ? length_size - 1 - idx : idx);
+                        out_buffer[idx] = static_cast<u8>(in_size >> shift);
+                    }
+                    std::memcpy(out_buffer + length_size, in_payload, in_size);
+                    return length_size + in_size;
+                }
+                }
+                return 0;
+            }
+
+            Response write_frame(Handle in_handle, const FrameEncoding &in_encoding, const u8 *in_payload, size_t in_size, u32 in_timeout_ms)
+            {
+                // grows to the largest frame a thread has sent and is reused from then on
+                thread_local std::vector<u8> s_frame_buffer;
+                const size_t required = max_encoded_size(in_encoding, in_size);
+                if (s_frame_buffer.size() < required)
+                {
+                    s_frame_buffer.resize(required);
+                }
+                const size_t encoded_size = encode(in_encoding, in_payload, in_size, s_frame_buffer.data());
+                if (0 == encoded_size)
+                {
+                    return {eFAILED, 0};
+                }
+                return write(in_handle, s_frame_buffer.data(), encoded_size, in_timeout_ms);
+            }
+            /* END: ENCODERS */
+
+            /* START: DECODERS */
+            Decoder::Decoder(size_t in_max_frame_size, FrameCallback in_on_frame)
+                : m_max_frame_size{in_max_frame_size}, m_buffer{std::make_unique<u8[]>(in_max_frame_size)}, m_on_frame{std::move(in_on_frame)}
+            {
+            }
+
+            void Decoder::reset()
+            {
+                m_size = 0;
+                m_oversized = false;
+            }
+
+            std::function<void(const Handle, const u8 *, const size_t)> Decoder::read_callback()
+            {
+                return [this](const Handle, const u8 *in_data, const size_t in_size)
+                { feed(in_data, in_size); };
+            }
+
+            void Decoder::append(const u8 *in_data, size_t in_size)
+            {
+                if (m_oversized)
+                {
+                    return;
+                }
+                if (m_max_frame_size - m_size < in_size)
+                {
+                    m_oversized = true;
+                    return;
+                }
+                std::memcpy(m_buffer.get() + m_size, in_data, in_size);
+                m_size += in_size;
+            }
+
+            void Decoder::emit(const u8 *in_frame, size_t in_size)
+            {
+                if (m_max_frame_size < in_size)
+                {
+                    m_statistics.oversized++;
+                    return;
+                }
+                m_statistics.frames++;
+                if (nullptr != m_on_frame)
+                    m_on_frame(in_frame, in_size);
+            }
+
+            // Finishes the frame that was reassembled across chunks
+            void Decoder::complete_buffered()
+            {
+                if (m_oversized)
+                {
+                    m_statistics.oversized++;
+                }
+                else if (0 < m_size)
+                {
+                    emit(m_buffer.get(), m_size);
+                }
+                reset();
+            }
+
+            DelimiterDecoder::DelimiterDecoder(u8 in_delimiter, size_t in_max_frame_size, FrameCallback in_on_frame)
+                : Decoder{in_max_frame_size, std::move(in_on_frame)}, m_delimiter{in_delimiter}
+            {
+            }
+
+            void DelimiterDecoder::feed(const u8 *in_data, size_t in_size)
+            {
+                const u8 *cursor = in_data;
+                const u8 *const end = in_data + in_size;
+                while (cursor < end)
+                {
+                    const u8 *delimiter = find_byte(cursor, end, m_delimiter);
+                    if (delimiter == end)
+                    {
+                        append(cursor, end - cursor);
+                        return;
+                    }
+                    if (0 == m_size && !m_oversized)
+                    {
+                        if (delimiter > cursor)
+                            emit(cursor, delimiter - cursor);
+                    }
+                    else
+                    {
+                        append(cursor, delimiter - cursor);
+                        complete_buffered();
+                    }
+                    cursor = delimiter + 1;
+                }
+            }
+
+            SlipDecoder::SlipDecoder(size_t in_max_frame_size, FrameCallback in_on_frame)
+                : Decoder{in_max_frame_size, std::move(in_on_frame)}
+            {
+            }
+
+            void SlipDecoder::reset()
+            {
+                Decoder::reset();
+                m_escaped = false;
+            }
+
+            void SlipDecoder::feed(const u8 *in_data, size_t in_size)
+            {
+                const u8 *cursor = in_data;
+                const u8 *const end = in_data + in_size;
+                while (cursor < end)
+                {
+                    if (m_escaped)
+                    {
+                        m_escaped = false;
+                        const u8 escaped = *cursor++;
+                        const u8 value = SLIP_ESC_END == escaped ? SLIP_END : SLIP_ESC_ESC == escaped ? SLIP_ESC
+                                                                                                      : escaped;
+                        append(&value, 1);
+                        continue;
+                    }
+                    const u8 *special = find_either(cursor, end, SLIP_END, SLIP_ESC);
+                    if (special == end)
+                    {
+                        append(cursor, end - cursor);
+                        return;
+                    }
+                    if (SLIP_ESC == *special)
+                    {
+                        append(cursor, special - cursor);
+                        m_escaped = true;
+                    }
+                    else if (0 == m_size && !m_oversized)
+                    {
+                        if (special > cursor)
+                            emit(cursor, special - cursor);
+                    }
+                    else
+                    {
+                        append(cursor, special - cursor);
+                        complete_buffered();
+                    }
+                    cursor = special + 1;
+                }
+            }
+
+            CobsDecoder::CobsDecoder(size_t in_max_frame_size, FrameCallback in_on_frame)
+                : Decoder{in_max_frame_size + in_max_frame_size / COBS_MAX_BLOCK + 1, std::move(in_on_frame)}, m_max_decoded_size{in_max_frame_size}
+            {
+            }
+
+            // Decodes into m_buffer. Works in place because the decoded output never overtakes the encoded input
+            void CobsDecoder::decode_and_emit(const u8 *in_encoded, size_t in_size)
+            {
+                u8 *const output = m_buffer.get();
+                size_t read_index = 0;
+                size_t write_index = 0;
+                while (read_index < in_size)
+                {
+                    const u8 code = in_encoded[read_index++];
+                    const size_t run = code - 1;
+                    if (0 == code || in_size - read_index < run)
+                    {
+                        m_statistics.malformed++;
+                        reset();
+                        return;
+                    }
+                    std::memmove(output + write_index, in_encoded + read_index, run);
+                    write_index += run;
+                    read_index += run;
+                    if (0xFF != code && read_index < in_size)
+                    {
+                        output[write_index++] = 0;
+                    }
+                }
+                reset();
+                if (m_max_decoded_size < write_index)
+                {
+                    m_statistics.oversized++;
+                    return;
+                }
+                emit(output, write_index);
+            }
+
+            void CobsDecoder::feed(const u8 *in_data, size_t in_size)
+            {
+                const u8 *cursor = in_data;
+                const u8 *const end = in_data + in_size;
+                while (cursor < end)
+                {
+                    const u8 *delimiter = find_byte(cursor, end, COBS_DELIMITER);
+                    if (delimiter == end)
+                    {
+                        append(cursor, end - cursor);
+                        return;
+                    }
+                    if (0 == m_size && !m_oversized)
+                    {
+                        if (delimiter > cursor)
+                        {
+                            if (static_cast<size_t>(delimiter - cursor) > m_max_frame_size)
+                                m_statistics.oversized++;
+                            else
+                                decode_and_emit(cursor, delimiter - cursor);
+                        }
+                    }
+                    else
+                    {
+                        append(cursor, delimiter - cursor);
+                        if (m_oversized)
+                        {
+                            m_statistics.oversized++;
+                            reset();
+                        }
+                        else
+                        {
+                            decode_and_emit(m_buffer.get(), m_size);
+                        }
+                    }
+                    cursor = delimiter + 1;
+                }
+            }
+
+            LengthPrefixedDecoder::LengthPrefixedDecoder(u8 in_length_size, bool in_big_endian, size_t in_max_frame_size, FrameCallback in_on_frame)
+                : Decoder{in_max_frame_size, std::move(in_on_frame)}, m_length_size{std::clamp<u8>(in_length_size, 1, 4)}, m_big_endian{in_big_endian}
+            {
+            }
+
+            void LengthPrefixedDecoder::reset()
+            {
+                Decoder::reset();
+                m_header_size = 0;
+                m_length = 0;
+                m_skip = 0;
+            }
+
+            void LengthPrefixedDecoder::feed(const u8 *in_data, size_t in_size)
+            {
+                const u8 *cursor = in_data;
+                const u8 *const end = in_data + in_size;
+                while (cursor < end)
+                {
+                    if (0 < m_skip)
+                    {
+                        const size_t skipped = std::min<size_t>(m_skip, end - cursor);
+                        m_skip -= skipped;
+                        cursor += skipped;
+                        continue;
+                    }
+                    if (m_header_size < m_length_size)
+                    {
+                        m_header[m_header_size++] = *cursor++;
+                        if (m_header_size < m_length_size)
+                            continue;
+                        m_length = 0;
+                        for (u8 idx = 0; idx < m_length_size; ++idx)
+                        {
+                            const u8 shift = 8 * (m_big_endian ? m_length_size - 1 - idx : idx);
+                            m_length |= static_cast<size_t>(m_header[idx]) << shift;
+                        }
+                        if (m_length > m_max_frame_size)
+                        {
+                            m_statistics.oversized++;
+                            const size_t length = m_length;
+                            reset();
+                            m_skip = length;
+                        }
+                        else if (0 == m_length)
+                        {
+                            emit(m_buffer.get(), 0);
+                            reset();
+                        }
+                        continue;
+                    }
+                    const size_t missing = m_length - m_size;
+                    const size_t available = end - cursor;
+                    if (0 == m_size && available >= missing)
+                    {
+                        emit(cursor, missing);
+                        cursor += missing;
+                        reset();
+                        continue;
+                    }
+                    const size_t taken = std::min(missing, available);
+                    append(cursor, taken);
+                    cursor += taken;
+                    if (m_size == m_length)
+                    {
+                        emit(m_buffer.get(), m_size);
+                        reset();
+                    }
+                }
+            }
+
+            std::unique_ptr<Decoder> make_decoder(const FrameEncoding &in_encoding, size_t in_max_frame_size, FrameCallback in_on_frame)
+            {
+                switch (in_encoding.format)
+                {
+                case FrameFormat::eCOBS:
+                    return std::make_unique<CobsDecoder>(in_max_frame_size, std::move(in_on_frame));
+                case FrameFormat::eSLIP:
+                    return std::make_unique<SlipDecoder>(in_max_frame_size, std::move(in_on_frame));
+                case FrameFormat::eDELIMITER:
+                    return std::make_unique<DelimiterDecoder>(in_encoding.delimiter, in_max_frame_size, std::move(in_on_frame));
+                case FrameFormat::eLENGTH_PREFIXED:
+                    // the widths encode() accepts, rather than the clamped one the decoder would fall back to
+                    if (1 > in_encoding.length_size || 4 < in_encoding.length_size)
+                    {
+                        return nullptr;
+                    }
+                    return std::make_unique<LengthPrefixedDecoder>(in_encoding.length_size, in_encoding.big_endian, in_max_frame_size, std::move(in_on_frame));
+                }
+                return nullptr;
+            }
+            /* END: DECODERS */
+        } // namespace Framing
+    } // namespace UART
+} // namespace Omega
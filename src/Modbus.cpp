@@ -0,0 +1,678 @@
+/**
+ * @file Modbus.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 11:57:26 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Modbus.cpp
+ * File Created: Saturday, 17th October 2026 11:57:26 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 11:57:26 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "OmegaUARTController/Checksum.hpp"
+#include "OmegaUARTController/Modbus.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace Modbus
+        {
+            __internal__ constexpr size_t CRC_SIZE{2};
+            __internal__ constexpr u32 FAST_BAUDRATE{19200};
+            __internal__ constexpr u32 FAST_T1_5_US{750};
+            __internal__ constexpr u32 FAST_T3_5_US{1750};
+
+            /* START: FRAMING */
+            Timing timing(const Configuration &in_configuration)
+            {
+                u64 data_bits = 8;
+                switch (in_configuration.databits)
+                {
+                case DataBits::eDATA_BITS_5:
+                    data_bits = 5;
+                    break;
+                case DataBits::eDATA_BITS_6:
+                    data_bits = 6;
+                    break;
+                case DataBits::eDATA_BITS_7:
+                    data_bits = 7;
+                    break;
+                case DataBits::eDATA_BITS_8:
+                    break;
+                }
+                // start, data and parity bits plus the stop bits, in half bits
+                u64 half_bits = 2 * (1 + data_bits + (Parity::ePARITY_DISABLE == in_configuration.parity ? 0 : 1)) + 2;
+#if !defined(MACOSX_UART)
+                if (StopBits::eSTOP_BITS_1_5 == in_configuration.stopbits)
+                {
+                    half_bits += 1;
+                }
+#endif
+                if (StopBits::eSTOP_BITS_2 == in_configuration.stopbits)
+                {
+                    half_bits += 2;
+                }
+                const u64 baudrate = std::max<u64>(1, in_configuration.baudrate);
+                const u64 character_ns = (half_bits * 1'000'000'000 + 2 * baudrate - 1) / (2 * baudrate);
+                if (FAST_BAUDRATE < baudrate)
+                {
+                    return {static_cast<u32>((character_ns + 999) / 1000), FAST_T1_5_US, FAST_T3_5_US};
+                }
+                return {static_cast<u32>((character_ns + 999) / 1000), static_cast<u32>((3 * character_ns + 1999) / 2000), static_cast<u32>((7 * character_ns + 1999) / 2000)};
+            }
+
+            size_t encode(u8 in_address, u8 in_function, const u8 *in_data, size_t in_size, u8 *out_adu)
+            {
+                if (MAX_ADU_SIZE < in_size + 2 + CRC_SIZE || (0 < in_size && nullptr == in_data))
+                {
+                    return 0;
+                }
+                out_adu[0] = in_address;
+                out_adu[1] = in_function;
+                if (0 < in_size)
+                {
+                    std::memcpy(out_adu + 2, in_data, in_size);
+                }
+                const u32 crc = Checksum::compute(Checksum::Algorithm::eCRC16_MODBUS, out_adu, in_size + 2);
+                out_adu[in_size + 2] = static_cast<u8>(crc);
+                out_adu[in_size + 3] = static_cast<u8>(crc >> 8);
+                return in_size + 2 + CRC_SIZE;
+            }
+
+            __internal__ bool crc_matches(const u8 *in_adu, size_t in_size)
+            {
+                if (2 + CRC_SIZE > in_size)
+                {
+                    return false;
+                }
+                const u32 crc = Checksum::compute(Checksum::Algorithm::eCRC16_MODBUS, in_adu, in_size - CRC_SIZE);
+                return static_cast<u8>(crc) == in_adu[in_size - 2] && static_cast<u8>(crc >> 8) == in_adu[in_size - 1];
+            }
+
+            FrameDetector::FrameDetector(const Timing &in_timing, Direction in_direction, FrameCallback in_on_frame)
+                : m_timing{in_timing}, m_direction{in_direction}, m_on_frame{std::move(in_on_frame)}
+            {
+            }
+
+            void FrameDetector::feed(const u8 *in_data, size_t in_size, u64 in_arrival_us)
+            {
+                if (0 == in_size)
+                {
+                    return;
+                }
+                if (0 < m_size)
+                {
+                    // the chunk's bytes are taken to have arrived back to back, ending at in_arrival_us
+                    const u64 chunk_us = in_size * m_timing.character_us;
+                    const u64 started = in_arrival_us > chunk_us ? in_arrival_us - chunk_us : 0;
+                    const u64 silence = started > m_last_arrival_us ? started - m_last_arrival_us : 0;
+                    if (m_timing.t3_5_us <= silence)
+                    {
+                        close();
+                    }
+                    else if (m_timing.t1_5_us < silence && !m_broken)
+                    {
+                        m_broken = true;
+                        m_statistics.gap_errors++;
+                    }
+                }
+                m_last_arrival_us = in_arrival_us;
+                for (size_t idx = 0; idx < in_size; ++idx)
+                {
+                    if (MAX_ADU_SIZE == m_size)
+                    {
+                        if (!m_broken)
+                        {
+                            m_broken = true;
+                            m_statistics.overruns++;
+                        }
+                        continue;
+                    }
+                    m_buffer[m_size++] = in_data[idx];
+                    if (const size_t size = m_size; !m_broken && expected_size() == size && crc_matches(m_buffer, size))
+                    {
+                        m_statistics.frames++;
+                        m_size = 0;
+                        m_on_frame(m_buffer, size - CRC_SIZE, in_arrival_us);
+                    }
+                }
+            }
+
+            u64 FrameDetector::poll(u64 in_now_us)
+            {
+                if (0 == m_size)
+                {
+                    return TimerWheel<>::NEVER;
+                }
+                if (const u64 end = m_last_arrival_us + m_timing.t3_5_us; end > in_now_us)
+                {
+                    return end;
+                }
+                close();
+                return TimerWheel<>::NEVER;
+            }
+
+            void FrameDetector::reset()
+            {
+                m_size = 0;
+                m_broken = false;
+            }
+
+            // 0 while the frame is too short to tell, or for function codes whose length only the t3.5 silence tells
+            size_t FrameDetector::expected_size() const
+            {
+                if (2 > m_size)
+                {
+                    return 0;
+                }
+                const u8 function = m_buffer[1];
+                if (Direction::eRESPONSES == m_direction)
+                {
+                    if (0 != (function & EXCEPTION_FLAG))
+                    {
+                        return 3 + CRC_SIZE;
+                    }
+                    switch (static_cast<FunctionCode>(function))
+                    {
+                    case FunctionCode::eREAD_COILS:
+                    case FunctionCode::eREAD_DISCRETE_INPUTS:
+                    case FunctionCode::eREAD_HOLDING_REGISTERS:
+                    case FunctionCode::eREAD_INPUT_REGISTERS:
+                        return 3 > m_size ? 0 : 3 + m_buffer[2] + CRC_SIZE;
+                    case FunctionCode::eWRITE_SINGLE_COIL:
+                    case FunctionCode::eWRITE_SINGLE_REGISTER:
+                    case FunctionCode::eWRITE_MULTIPLE_COILS:
+                    case FunctionCode::eWRITE_MULTIPLE_REGISTERS:
+                        return 6 + CRC_SIZE;
+                    }
+                    return 0;
+                }
+                switch (static_cast<FunctionCode>(function))
+                {
+                case FunctionCode::eREAD_COILS:
+                case FunctionCode::eREAD_DISCRETE_INPUTS:
+                case FunctionCode::eREAD_HOLDING_REGISTERS:
+                case FunctionCode::eREAD_INPUT_REGISTERS:
+                case FunctionCode::eWRITE_SINGLE_COIL:
+                case FunctionCode::eWRITE_SINGLE_REGISTER:
+                    return 6 + CRC_SIZE;
+                case FunctionCode::eWRITE_MULTIPLE_COILS:
+                case FunctionCode::eWRITE_MULTIPLE_REGISTERS:
+                    return 7 > m_size ? 0 : 7 + m_buffer[6] + CRC_SIZE;
+                }
+                return 0;
+            }
+
+            void FrameDetector::close()
+            {
+                if (!m_broken)
+                {
+                    if (crc_matches(m_buffer, m_size))
+                    {
+                        m_statistics.frames++;
+                        m_on_frame(m_buffer, m_size - CRC_SIZE, m_last_arrival_us);
+                    }
+                    else
+                    {
+                        m_statistics.crc_errors++;
+                    }
+                }
+                reset();
+            }
+            /* END: FRAMING */
+
+            __internal__ Statistics merged(const Statistics &in_detector, const Statistics &in_engine)
+            {
+                Statistics statistics = in_engine;
+                statistics.frames = in_detector.frames;
+                statistics.crc_errors = in_detector.crc_errors;
+                statistics.gap_errors = in_detector.gap_errors;
+                statistics.overruns = in_detector.overruns;
+                return statistics;
+            }
+
+            /* START: MASTER */
+            Master::Master(Handle in_handle, const MasterConfiguration &in_configuration)
+                : m_handle{in_handle}, m_configuration{in_configuration}, m_timing{Modbus::timing(get_configuration(in_handle))},
+                  m_detector{m_timing, Direction::eRESPONSES, [this](const u8 *in_frame, const size_t in_size, const u64 in_arrival_us)
+                             { on_frame(in_frame, in_size, in_arrival_us); }},
+                  m_timer{[this]
+                          {
+                              {
+                                  std::lock_guard lock{m_mutex};
+                                  pump(Timers::now());
+                              }
+                              settle();
+                          }}
+            {
+            }
+
+            Master::~Master()
+            {
+                std::vector<std::shared_ptr<Transaction>> outstanding;
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_closing = true;
+                    outstanding.assign(m_queue.begin(), m_queue.end());
+                    m_queue.clear();
+                    if (nullptr != m_current)
+                    {
+                        outstanding.push_back(std::move(m_current));
+                    }
+                    m_to_send = nullptr;
+                    m_timer.disarm();
+                }
+                m_timer.synchronize();
+                for (const auto &transaction : outstanding)
+                {
+                    transaction->m_on_complete(Result{eFAILED, false, 0, transaction->m_attempts, {}});
+                }
+            }
+
+            std::shared_ptr<Master::Transaction> Master::make_transaction(const Request &in_request, Completion in_on_complete)
+            {
+                if (nullptr == in_on_complete)
+                {
+                    OMEGA_LOGE("Invalid completion");
+                    return nullptr;
+                }
+                auto transaction = std::make_shared<Transaction>();
+                transaction->m_size = encode(in_request.address, in_request.function, in_request.data.data(), in_request.data.size(), transaction->m_adu);
+                if (0 == transaction->m_size)
+                {
+                    OMEGA_LOGE("Request does not fit a Modbus RTU frame");
+                    return nullptr;
+                }
+                transaction->m_on_complete = std::move(in_on_complete);
+                return transaction;
+            }
+
+            OmegaStatus Master::submit(const Request &in_request, Completion in_on_complete)
+            {
+                auto transaction = make_transaction(in_request, std::move(in_on_complete));
+                if (nullptr == transaction)
+                {
+                    return eFAILED;
+                }
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_queue.push_back(std::move(transaction));
+                    pump(Timers::now());
+                }
+                settle();
+                return eSUCCESS;
+            }
+
+            std::future<Result> Master::submit(const Request &in_request)
+            {
+                auto promise = std::make_shared<std::promise<Result>>();
+                auto future = promise->get_future();
+                if (eSUCCESS != submit(in_request, [promise](const Result &in_result)
+                                       { promise->set_value(in_result); }))
+                {
+                    promise->set_value(Result{eFAILED, false, 0, 0, {}});
+                }
+                return future;
+            }
+
+            u64 Master::add_poll(const Request &in_request, u32 in_period_ms, Completion in_on_complete)
+            {
+                if (0 == in_period_ms)
+                {
+                    OMEGA_LOGE("Invalid poll period");
+                    return 0;
+                }
+                auto transaction = make_transaction(in_request, std::move(in_on_complete));
+                if (nullptr == transaction)
+                {
+                    return 0;
+                }
+                u64 poll_id = 0;
+                {
+                    std::lock_guard lock{m_mutex};
+                    poll_id = m_next_poll_id++;
+                    transaction->m_poll_id = poll_id;
+                    const u64 now = Timers::now();
+                    m_polls.emplace(poll_id, Poll{std::move(transaction), static_cast<u64>(in_period_ms) * 1000, now});
+                    m_poll_order.emplace(now, poll_id);
+                    pump(now);
+                }
+                settle();
+                return poll_id;
+            }
+
+            OmegaStatus Master::remove_poll(u64 in_poll_id)
+            {
+                std::lock_guard lock{m_mutex};
+                const auto found = m_polls.find(in_poll_id);
+                if (m_polls.end() == found)
+                {
+                    OMEGA_LOGE("Unknown poll");
+                    return eFAILED;
+                }
+                m_poll_order.erase({found->second.m_due, in_poll_id});
+                m_polls.erase(found);
+                return eSUCCESS;
+            }
+
+            void Master::feed(const u8 *in_data, size_t in_size, u64 in_arrival_us)
+            {
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_detector.feed(in_data, in_size, in_arrival_us);
+                    pump(Timers::now());
+                }
+                settle();
+            }
+
+            std::function<void(const Handle, const u8 *, const size_t)> Master::read_callback()
+            {
+                return [this](const Handle, const u8 *in_data, const size_t in_size)
+                { feed(in_data, in_size, Timers::now()); };
+            }
+
+#if defined(LINUX_UART)
+            std::function<void(const Handle, const RxChunk &)> Master::chunk_callback()
+            {
+                return [this](const Handle, const RxChunk &in_chunk)
+                { feed(in_chunk.data, in_chunk.size, in_chunk.timestamp_us); };
+            }
+#endif
+
+            Statistics Master::statistics() const
+            {
+                std::lock_guard lock{m_mutex};
+                return merged(m_detector.statistics(), m_statistics);
+            }
+
+            // Expects m_mutex to be held
+            void Master::on_frame(const u8 *in_frame, size_t in_size, u64 in_arrival_us)
+            {
+                m_line_free_at = in_arrival_us + m_timing.t3_5_us;
+                if (nullptr == m_current || BROADCAST_ADDRESS == m_current->m_adu[0] || m_current->m_adu[0] != in_frame[0] ||
+                    m_current->m_adu[1] != (in_frame[1] & ~EXCEPTION_FLAG))
+                {
+                    m_statistics.unexpected++;
+                    return;
+                }
+                m_missed.erase(in_frame[0]);
+                if (0 != (in_frame[1] & EXCEPTION_FLAG))
+                {
+                    m_statistics.exceptions++;
+                    complete(Result{eFAILED, false, 2 < in_size ? in_frame[2] : u8{0}, m_current->m_attempts, {}});
+                    return;
+                }
+                complete(Result{eSUCCESS, false, 0, m_current->m_attempts, {in_frame + 2, in_frame + in_size}});
+            }
+
+            // Expects m_mutex to be held
+            void Master::complete(Result in_result)
+            {
+                m_completed.push_back({m_current->m_on_complete, std::move(in_result)});
+                m_current = nullptr;
+            }
+
+            // Expects m_mutex to be held. Settles the transaction on the wire once its time is up, picks the next one once
+            // the line is free, and arms the timer for whichever of those comes next
+            void Master::pump(u64 in_now_us)
+            {
+                const u64 frame_end = m_detector.poll(in_now_us);
+                if (nullptr != m_current && m_response_deadline <= in_now_us)
+                {
+                    const u8 address = m_current->m_adu[0];
+                    if (BROADCAST_ADDRESS == address)
+                    {
+                        complete(Result{eSUCCESS, false, 0, m_current->m_attempts, {}});
+                    }
+                    else if (m_current->m_attempts <= m_configuration.retries)
+                    {
+                        m_queue.push_front(std::move(m_current));
+                    }
+                    else
+                    {
+                        m_statistics.timeouts++;
+                        if (const u32 missed = ++m_missed[address]; m_configuration.backoff_after <= missed)
+                        {
+                            for (auto &[poll_id, poll] : m_polls)
+                            {
+                                const u64 backoff = std::min<u64>(static_cast<u64>(m_configuration.max_backoff_ms) * 1000, poll.m_period_us << std::min<u32>(missed - m_configuration.backoff_after + 1, 16));
+                                if (address == poll.m_template->m_adu[0] && poll.m_due < in_now_us + backoff)
+                                {
+                                    m_poll_order.erase({poll.m_due, poll_id});
+                                    poll.m_due = in_now_us + backoff;
+                                    m_poll_order.emplace(poll.m_due, poll_id);
+                                }
+                            }
+                        }
+                        complete(Result{eFAILED, true, 0, m_current->m_attempts, {}});
+                    }
+                    m_line_free_at = std::max(m_line_free_at, in_now_us);
+                }
+                if (nullptr == m_current && !m_closing && m_line_free_at <= in_now_us)
+                {
+                    if (!m_queue.empty())
+                    {
+                        m_current = std::move(m_queue.front());
+                        m_queue.pop_front();
+                    }
+                    else if (!m_poll_order.empty() && m_poll_order.begin()->first <= in_now_us)
+                    {
+                        const auto [due, poll_id] = *m_poll_order.begin();
+                        m_poll_order.erase(m_poll_order.begin());
+                        auto &poll = m_polls.at(poll_id);
+                        m_current = std::make_shared<Transaction>(*poll.m_template);
+                        // a poll the bus cannot keep up with runs as often as it can rather than in bursts
+                        poll.m_due = std::max(due + poll.m_period_us, in_now_us);
+                        m_poll_order.emplace(poll.m_due, poll_id);
+                    }
+                    if (nullptr != m_current)
+                    {
+                        m_current->m_attempts++;
+                        const u64 transmitted = in_now_us + m_current->m_size * m_timing.character_us;
+                        const u32 wait_ms = BROADCAST_ADDRESS == m_current->m_adu[0] ? m_configuration.turnaround_delay_ms : m_configuration.response_timeout_ms;
+                        m_response_deadline = transmitted + static_cast<u64>(wait_ms) * 1000;
+                        m_to_send = m_current;
+                    }
+                }
+                u64 wake = frame_end;
+                if (nullptr != m_current)
+                {
+                    wake = std::min(wake, m_response_deadline);
+                }
+                else if (!m_closing && !m_queue.empty())
+                {
+                    wake = std::min(wake, m_line_free_at);
+                }
+                else if (!m_closing && !m_poll_order.empty())
+                {
+                    wake = std::min(wake, std::max(m_line_free_at, m_poll_order.begin()->first));
+                }
+                if (TimerWheel<>::NEVER == wake)
+                {
+                    m_timer.disarm();
+                }
+                else
+                {
+                    m_timer.arm(wake);
+                }
+            }
+
+            // Sends what pump() put on the wire and runs the completions it collected, outside m_mutex
+            void Master::settle()
+            {
+                for (;;)
+                {
+                    std::shared_ptr<Transaction> to_send;
+                    std::vector<Completed> completed;
+                    {
+                        std::lock_guard lock{m_mutex};
+                        to_send = std::move(m_to_send);
+                        completed.swap(m_completed);
+                    }
+                    bool sent = true;
+                    if (nullptr != to_send)
+                    {
+                        const auto response = write(m_handle, to_send->m_adu, to_send->m_size, m_configuration.response_timeout_ms);
+                        sent = eSUCCESS == response.status && to_send->m_size == response.size;
+                    }
+                    for (const auto &done : completed)
+                    {
+                        done.m_on_complete(done.m_result);
+                    }
+                    if (sent)
+                    {
+                        return;
+                    }
+                    OMEGA_LOGE("Request to slave %d could not be sent", to_send->m_adu[0]);
+                    std::lock_guard lock{m_mutex};
+                    if (to_send == m_current)
+                    {
+                        complete(Result{eFAILED, false, 0, to_send->m_attempts, {}});
+                        pump(Timers::now());
+                    }
+                }
+            }
+            /* END: MASTER */
+
+            /* START: SLAVE */
+            Slave::Slave(Handle in_handle, RequestHandler in_on_request)
+                : m_handle{in_handle}, m_on_request{std::move(in_on_request)}, m_timing{Modbus::timing(get_configuration(in_handle))},
+                  m_detector{m_timing, Direction::eREQUESTS, [this](const u8 *in_frame, const size_t in_size, const u64 in_arrival_us)
+                             { m_requests.emplace_back(std::vector<u8>{in_frame, in_frame + in_size}, in_arrival_us); }},
+                  m_timer{[this]
+                          { on_timer(); }}
+            {
+            }
+
+            Slave::~Slave()
+            {
+                m_timer.disarm();
+                m_timer.synchronize();
+            }
+
+            void Slave::feed(const u8 *in_data, size_t in_size, u64 in_arrival_us)
+            {
+                std::vector<std::pair<std::vector<u8>, u64>> requests;
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_detector.feed(in_data, in_size, in_arrival_us);
+                    requests.swap(m_requests);
+                }
+                respond(requests);
+                transmit(Timers::now());
+            }
+
+            std::function<void(const Handle, const u8 *, const size_t)> Slave::read_callback()
+            {
+                return [this](const Handle, const u8 *in_data, const size_t in_size)
+                { feed(in_data, in_size, Timers::now()); };
+            }
+
+#if defined(LINUX_UART)
+            std::function<void(const Handle, const RxChunk &)> Slave::chunk_callback()
+            {
+                return [this](const Handle, const RxChunk &in_chunk)
+                { feed(in_chunk.data, in_chunk.size, in_chunk.timestamp_us); };
+            }
+#endif
+
+            Statistics Slave::statistics() const
+            {
+                std::lock_guard lock{m_mutex};
+                return merged(m_detector.statistics(), m_statistics);
+            }
+
+            void Slave::on_timer()
+            {
+                const u64 now = Timers::now();
+                std::vector<std::pair<std::vector<u8>, u64>> requests;
+                {
+                    std::lock_guard lock{m_mutex};
+                    UNUSED(m_detector.poll(now));
+                    requests.swap(m_requests);
+                }
+                respond(requests);
+                transmit(now);
+            }
+
+            // Runs the handler outside m_mutex. Only the latest response is kept, as a master waits for one answer at a time
+            void Slave::respond(std::vector<std::pair<std::vector<u8>, u64>> &io_requests)
+            {
+                for (const auto &[request, arrival_us] : io_requests)
+                {
+                    std::vector<u8> data;
+                    const u8 exception = m_on_request(request[0], request[1], request.data() + 2, request.size() - 2, data);
+                    if (BROADCAST_ADDRESS == request[0] || NO_RESPONSE == exception)
+                    {
+                        continue;
+                    }
+                    u8 adu[MAX_ADU_SIZE];
+                    const size_t size = 0 == exception ? encode(request[0], request[1], data.data(), data.size(), adu)
+                                                       : encode(request[0], request[1] | EXCEPTION_FLAG, &exception, 1, adu);
+                    if (0 == size)
+                    {
+                        OMEGA_LOGE("Response does not fit a Modbus RTU frame");
+                        continue;
+                    }
+                    std::lock_guard lock{m_mutex};
+                    if (0 != exception)
+                    {
+                        m_statistics.exceptions++;
+                    }
+                    m_response.assign(adu, adu + size);
+                    m_response_at = arrival_us + m_timing.t3_5_us;
+                }
+            }
+
+            // Sends the pending response once t3.5 passed since its request, and keeps the timer armed for that or for the
+            // detector's open frame
+            void Slave::transmit(u64 in_now_us)
+            {
+                std::vector<u8> response;
+                {
+                    std::lock_guard lock{m_mutex};
+                    if (!m_response.empty() && m_response_at <= in_now_us)
+                    {
+                        response.swap(m_response);
+                    }
+                    u64 wake = m_detector.poll(in_now_us);
+                    if (!m_response.empty())
+                    {
+                        wake = std::min(wake, m_response_at);
+                    }
+                    if (TimerWheel<>::NEVER == wake)
+                    {
+                        m_timer.disarm();
+                    }
+                    else
+                    {
+                        m_timer.arm(wake);
+                    }
+                }
+                if (!response.empty())
+                {
+                    if (const auto sent = write(m_handle, response.data(), response.size(), FAST_T3_5_US + response.size() * m_timing.character_us / 1000 + 1000); eSUCCESS != sent.status)
+                    {
+                        OMEGA_LOGE("Response could not be sent");
+                    }
+                }
+            }
+            /* END: SLAVE */
+        } // namespace Modbus
+    } // namespace UART
+} // namespace Omega
@@ -0,0 +1,164 @@
+/**
+ * @file Timers.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 11:48:10 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Timers.cpp
+ * File Created: Saturday, 17th October 2026 11:48:10 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 11:48:10 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "OmegaUARTController/Timers.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace Timers
+        {
+            struct TimerThread
+            {
+                std::mutex m_mutex;
+                std::condition_variable m_wakeup;
+                // Held while expired timers run, so one being destroyed can wait until its callback returned
+                std::mutex m_dispatch_mutex;
+                TimerWheel<> m_timers;
+                // Timers that went off, run once m_dispatch_mutex is held
+                std::vector<Timer *> m_expired;
+                const std::chrono::steady_clock::time_point m_epoch{std::chrono::steady_clock::now()};
+                std::thread *m_thread{nullptr};
+                bool m_running{false};
+
+                static void loop();
+                ~TimerThread();
+            };
+            __internal__ TimerThread s_timer_thread;
+            __internal__ thread_local bool t_on_timer_thread{false};
+
+            u64 now()
+            {
+                return std::chrono::floor<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_timer_thread.m_epoch).count();
+            }
+
+            u64 after(u64 in_delay_us)
+            {
+                return now() + in_delay_us + 1;
+            }
+
+            void TimerThread::loop()
+            {
+                t_on_timer_thread = true;
+                std::vector<Timer *> expired;
+                std::unique_lock lock{s_timer_thread.m_mutex};
+                while (s_timer_thread.m_running)
+                {
+                    if (const u64 next = s_timer_thread.m_timers.next_expiry(); TimerWheel<>::NEVER == next)
+                    {
+                        s_timer_thread.m_wakeup.wait(lock);
+                    }
+                    else
+                    {
+                        s_timer_thread.m_wakeup.wait_until(lock, s_timer_thread.m_epoch + std::chrono::microseconds{next});
+                    }
+                    s_timer_thread.m_timers.advance(now(), [](TimerHook &in_timer)
+                                                    { s_timer_thread.m_expired.push_back(static_cast<Timer::Hook &>(in_timer).m_timer); });
+                    if (s_timer_thread.m_expired.empty())
+                    {
+                        continue;
+                    }
+                    lock.unlock();
+                    {
+                        // a timer disarmed meanwhile took itself off m_expired
+                        std::lock_guard dispatch_lock{s_timer_thread.m_dispatch_mutex};
+                        lock.lock();
+                        expired.swap(s_timer_thread.m_expired);
+                        lock.unlock();
+                        for (auto *timer : expired)
+                        {
+                            timer->m_on_expired();
+                        }
+                    }
+                    expired.clear();
+                    lock.lock();
+                }
+            }
+
+            TimerThread::~TimerThread()
+            {
+                if (nullptr == m_thread)
+                {
+                    return;
+                }
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_running = false;
+                }
+                m_wakeup.notify_one();
+                m_thread->join();
+                delete m_thread;
+            }
+
+            Timer::Timer(std::function<void()> in_on_expired) : m_on_expired{std::move(in_on_expired)}
+            {
+                m_hook.m_timer = this;
+            }
+
+            Timer::~Timer()
+            {
+                disarm();
+                synchronize();
+            }
+
+            void Timer::arm(u64 in_tick)
+            {
+                std::lock_guard lock{s_timer_thread.m_mutex};
+                std::erase(s_timer_thread.m_expired, this);
+                const u64 earliest = s_timer_thread.m_timers.next_expiry();
+                s_timer_thread.m_timers.schedule(m_hook, in_tick);
+                if (nullptr == s_timer_thread.m_thread)
+                {
+                    s_timer_thread.m_running = true;
+                    s_timer_thread.m_thread = new std::thread{TimerThread::loop};
+                }
+                else if (s_timer_thread.m_timers.next_expiry() < earliest && !t_on_timer_thread)
+                {
+                    s_timer_thread.m_wakeup.notify_one();
+                }
+            }
+
+            void Timer::disarm()
+            {
+                std::lock_guard lock{s_timer_thread.m_mutex};
+                s_timer_thread.m_timers.cancel(m_hook);
+                std::erase(s_timer_thread.m_expired, this);
+            }
+
+            void Timer::synchronize()
+            {
+                if (!t_on_timer_thread)
+                {
+                    std::lock_guard dispatch_lock{s_timer_thread.m_dispatch_mutex};
+                }
+            }
+        } // namespace Timers
+    } // namespace UART
+} // namespace Omega
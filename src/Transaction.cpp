@@ -0,0 +1,281 @@
+/**
+ * @file Transaction.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 11:02:37 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: Transaction.cpp
+ * File Created: Saturday, 17th October 2026 11:02:37 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 11:02:37 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <algorithm>
+
+#include "OmegaUARTController/Transaction.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        namespace Transaction
+        {
+            __internal__ u64 deadline_tick(u32 in_timeout_ms)
+            {
+                return Timers::after(static_cast<u64>(in_timeout_ms) * 1000);
+            }
+
+            /* START: ENGINE */
+            Engine::Engine(Handle in_handle, const EngineConfiguration &in_configuration, KeyExtractor in_key_extractor)
+                : m_handle{in_handle}, m_configuration{in_configuration}, m_key_extractor{std::move(in_key_extractor)},
+                  m_decoder{Framing::make_decoder(in_configuration.encoding, in_configuration.max_frame_size, [this](const u8 *in_frame, const size_t in_size)
+                                                  { on_frame(in_frame, in_size); })},
+                  m_deadlines{Timers::now()}, m_timer{[this]
+                                                    { on_deadline(); }}
+            {
+            }
+
+            Engine::~Engine()
+            {
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_closing = true;
+                }
+                m_timer.disarm();
+                m_timer.synchronize();
+                std::unordered_map<u64, std::shared_ptr<Request>> requests;
+                {
+                    std::lock_guard lock{m_mutex};
+                    requests.swap(m_requests);
+                    m_queue.clear();
+                }
+                for (const auto &[key, request] : requests)
+                {
+                    request->m_on_complete(Result{eFAILED, false, request->m_attempts, {}});
+                }
+            }
+
+            OmegaStatus Engine::submit(u64 in_key, const u8 *in_request, size_t in_size, Completion in_on_complete)
+            {
+                if (nullptr == m_decoder || nullptr == in_on_complete)
+                {
+                    OMEGA_LOGE("Invalid transaction engine or completion");
+                    return eFAILED;
+                }
+                auto request = std::make_shared<Request>();
+                request->m_key = in_key;
+                request->m_frame.resize(Framing::max_encoded_size(m_configuration.encoding, in_size));
+                if (const size_t encoded_size = Framing::encode(m_configuration.encoding, in_request, in_size, request->m_frame.data()); 0 == encoded_size)
+                {
+                    OMEGA_LOGE("Request could not be framed");
+                    return eFAILED;
+                }
+                else
+                {
+                    request->m_frame.resize(encoded_size);
+                }
+                request->m_on_complete = std::move(in_on_complete);
+                Requests sendable;
+                {
+                    std::lock_guard lock{m_mutex};
+                    if (m_closing)
+                    {
+                        OMEGA_LOGE("The transaction engine is shutting down");
+                        return eFAILED;
+                    }
+                    if (!m_requests.try_emplace(in_key, request).second)
+                    {
+                        OMEGA_LOGE("A request with key %llu is already outstanding", static_cast<unsigned long long>(in_key));
+                        return eFAILED;
+                    }
+                    m_statistics.submitted++;
+                    m_queue.push_back(std::move(request));
+                    sendable = admit();
+                }
+                transmit(sendable);
+                return eSUCCESS;
+            }
+
+            std::future<Result> Engine::submit(u64 in_key, const u8 *in_request, size_t in_size)
+            {
+                auto promise = std::make_shared<std::promise<Result>>();
+                auto future = promise->get_future();
+                if (eSUCCESS != submit(in_key, in_request, in_size, [promise](const Result &in_result)
+                                       { promise->set_value(in_result); }))
+                {
+                    promise->set_value(Result{eFAILED, false, 0, {}});
+                }
+                return future;
+            }
+
+            void Engine::feed(const u8 *in_data, size_t in_size)
+            {
+                if (nullptr != m_decoder)
+                {
+                    m_decoder->feed(in_data, in_size);
+                }
+            }
+
+            std::function<void(const Handle, const u8 *, const size_t)> Engine::read_callback()
+            {
+                return [this](const Handle, const u8 *in_data, const size_t in_size)
+                { feed(in_data, in_size); };
+            }
+
+            size_t Engine::outstanding() const
+            {
+                std::lock_guard lock{m_mutex};
+                return m_requests.size();
+            }
+
+            EngineStatistics Engine::statistics() const
+            {
+                std::lock_guard lock{m_mutex};
+                return m_statistics;
+            }
+
+            void Engine::on_frame(const u8 *in_frame, size_t in_size)
+            {
+                u64 key = 0;
+                const bool keyed = m_key_extractor(in_frame, in_size, key);
+                std::shared_ptr<Request> request;
+                Requests sendable;
+                {
+                    std::lock_guard lock{m_mutex};
+                    const auto found = keyed ? m_requests.find(key) : m_requests.end();
+                    // a queued request cannot have been answered yet
+                    if (m_requests.end() == found || 0 == found->second->m_attempts)
+                    {
+                        m_statistics.unmatched++;
+                        return;
+                    }
+                    request = found->second;
+                    retire(request);
+                    m_statistics.completed++;
+                    sendable = admit();
+                }
+                // the window is refilled before the completion runs, so the device is not kept waiting on it
+                transmit(sendable);
+                request->m_on_complete(Result{eSUCCESS, false, request->m_attempts, {in_frame, in_frame + in_size}});
+            }
+
+            void Engine::on_deadline()
+            {
+                Requests resend;
+                Requests failed;
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_armed_tick = TimerWheel<>::NEVER;
+                    m_deadlines.advance(Timers::now(), [this, &resend, &failed](TimerHook &in_timer)
+                                        {
+                                            auto request = m_requests.at(static_cast<Request &>(in_timer).m_key);
+                                            if (request->m_attempts <= m_configuration.retries)
+                                            {
+                                                request->m_attempts++;
+                                                m_statistics.retries++;
+                                                m_deadlines.schedule(*request, deadline_tick(m_configuration.timeout_ms));
+                                                resend.push_back(request);
+                                            }
+                                            else
+                                            {
+                                                m_statistics.timeouts++;
+                                                failed.push_back(request);
+                                                retire(request);
+                                            } });
+                    auto sendable = admit();
+                    resend.insert(resend.end(), sendable.begin(), sendable.end());
+                }
+                transmit(resend);
+                for (const auto &request : failed)
+                {
+                    request->m_on_complete(Result{eFAILED, true, request->m_attempts, {}});
+                }
+            }
+
+            // Expects m_mutex to be held. Moves queued requests onto the wire while the window has room and keeps the timer
+            // armed for the earliest deadline
+            Engine::Requests Engine::admit()
+            {
+                Requests sendable;
+                while (!m_queue.empty() && m_in_flight < std::max<size_t>(1, m_configuration.window))
+                {
+                    auto &request = m_queue.front();
+                    request->m_attempts = 1;
+                    m_deadlines.schedule(*request, deadline_tick(m_configuration.timeout_ms));
+                    m_in_flight++;
+                    sendable.push_back(std::move(request));
+                    m_queue.pop_front();
+                }
+                if (const u64 next = m_deadlines.next_expiry(); !m_closing && next != m_armed_tick)
+                {
+                    m_armed_tick = next;
+                    if (TimerWheel<>::NEVER == next)
+                    {
+                        m_timer.disarm();
+                    }
+                    else
+                    {
+                        m_timer.arm(next);
+                    }
+                }
+                return sendable;
+            }
+
+            void Engine::transmit(const Requests &in_requests)
+            {
+                for (const auto &request : in_requests)
+                {
+                    Response response{eFAILED, 0};
+                    {
+                        std::lock_guard lock{m_write_mutex};
+                        response = write(m_handle, request->m_frame.data(), request->m_frame.size(), m_configuration.write_timeout_ms);
+                    }
+                    if (eSUCCESS != response.status || request->m_frame.size() != response.size)
+                    {
+                        OMEGA_LOGE("Request %llu could not be sent", static_cast<unsigned long long>(request->m_key));
+                        fail(request);
+                    }
+                }
+            }
+
+            void Engine::fail(const std::shared_ptr<Request> &in_request)
+            {
+                Requests sendable;
+                u32 attempts = 0;
+                {
+                    std::lock_guard lock{m_mutex};
+                    const auto found = m_requests.find(in_request->m_key);
+                    // answered, timed out or failed meanwhile
+                    if (m_requests.end() == found || in_request != found->second)
+                    {
+                        return;
+                    }
+                    retire(in_request);
+                    attempts = in_request->m_attempts;
+                    sendable = admit();
+                }
+                transmit(sendable);
+                in_request->m_on_complete(Result{eFAILED, false, attempts, {}});
+            }
+
+            // Expects m_mutex to be held. Takes a request that is on the wire off the engine
+            void Engine::retire(const std::shared_ptr<Request> &in_request)
+            {
+                m_deadlines.cancel(*in_request);
+                m_in_flight--;
+                m_requests.erase(in_request->m_key);
+            }
+            /* END: ENGINE */
+        } // namespace Transaction
+    } // namespace UART
+} // namespace Omega
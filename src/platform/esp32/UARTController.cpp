@@ -28,6 +28,7 @@
 #include <driver/gpio.h>
 #include <driver/uart.h>
 #include <esp_err.h>
+#include <soc/soc_caps.h>
 
 #include <sdkconfig.h>
 
@@ -57,6 +58,14 @@
 #define LOGE(format, ...)
 #endif
 
+#if CONFIG_OMEGA_UART_CONTROLLER_PROFILE
+#define PROFILE(controller, call) (controller).m_profile->call
+#define PROFILE_START(name) const auto name = Omega::UART::PortProfile::now()
+#else
+#define PROFILE(controller, call)
+#define PROFILE_START(name)
+#endif
+
 __internal__ constexpr size_t s_UART_BASE_STACK_SIZE = 256;
 #define UART_EVENT_HANDLER_STACK_SIZE (configMINIMAL_STACK_SIZE + s_UART_BASE_STACK_SIZE * 4)
 
@@ -89,9 +98,17 @@ namespace Omega
             u8 *rx_buffer;
             size_t (*read_uart)(uint8_t *, size_t, uint32_t);
             size_t (*write_uart)(uint8_t *, size_t, uint32_t);
+#if CONFIG_OMEGA_UART_CONTROLLER_PROFILE
+            PortProfile *m_profile;
+#endif
         };
 
         __internal__ std::unordered_map<Handle, UARTController> s_controllers;
+#if CONFIG_OMEGA_UART_CONTROLLER_PROFILE
+        // The counters are atomics and cannot be copied along with UARTController; map nodes never move, so the
+        // controller keeps a pointer to its entry
+        __internal__ std::unordered_map<Handle, PortProfile> s_profiles;
+#endif
 
         __internal__ inline OmegaStatus initialize_stack(UARTController &controller, const uart_config_t &in_config)
         {
@@ -134,7 +151,10 @@ namespace Omega
                     {
                         LOGD("UART_DATA");
                         const size_t read_bytes = uart_read_bytes(controller->m_uart_port, controller->rx_buffer, uart_event.size, portMAX_DELAY);
+                        PROFILE(*controller, record_rx(read_bytes));
+                        PROFILE_START(callback_started);
                         on_data(controller->handle, controller->rx_buffer, read_bytes);
+                        PROFILE(*controller, record_callbacks(callback_started));
                         break;
                     }
                     case UART_BREAK: /*!< UART break event*/
@@ -145,11 +165,15 @@ namespace Omega
                     case UART_BUFFER_FULL: /*!< UART RX buffer full event*/
                     {
                         LOGD("UART_BUFFER_FULL");
+                        // the bytes of this event that found no room in the RX ring buffer
+                        PROFILE(*controller, record_overrun(uart_event.size));
                         break;
                     }
                     case UART_FIFO_OVF: /*!< UART FIFO overflow event*/
                     {
                         LOGD("UART_FIFO_OVF");
+                        // the driver has already reset the hardware FIFO, which was full when it overflowed
+                        PROFILE(*controller, record_overrun(SOC_UART_FIFO_LEN));
                         break;
                     }
                     case UART_FRAME_ERR: /*!< UART RX frame error event*/
@@ -227,6 +251,9 @@ namespace Omega
                 return 0;
             }
             s_controllers[handle] = {in_port, in_tx, in_rx, in_baudrate, in_databits, in_parity, in_stopbits, handle};
+#if CONFIG_OMEGA_UART_CONTROLLER_PROFILE
+            s_controllers[handle].m_profile = &s_profiles.try_emplace(handle).first->second;
+#endif
             const uart_config_t uart_config = {static_cast<int>(in_baudrate), static_cast<uart_word_length_t>(in_databits), static_cast<uart_parity_t>(in_parity), static_cast<uart_stop_bits_t>(in_stopbits)};
             if (eSUCCESS != initialize_stack(s_controllers[handle], uart_config))
             {
@@ -265,6 +292,7 @@ namespace Omega
             }
             auto &controller = iterator->second;
             const size_t read_bytes = uart_read_bytes(controller.m_uart_port, out_buffer, in_read_bytes, pdMS_TO_TICKS(in_timeout_ms));
+            PROFILE(controller, record_rx(read_bytes));
             return {eSUCCESS, read_bytes};
         }
 
@@ -287,13 +315,22 @@ namespace Omega
                 return {eFAILED};
             }
             auto &controller = iterator->second;
-            const size_t write_bytes = uart_write_bytes(controller.m_uart_port, in_buffer, in_write_bytes);
-            if (ESP_OK != uart_wait_tx_done(controller.m_uart_port, in_timeout_ms))
+            const int write_bytes = uart_write_bytes(controller.m_uart_port, in_buffer, in_write_bytes);
+            if (0 > write_bytes)
+            {
+                LOGE("uart_write_bytes failed");
+                return {eFAILED};
+            }
+            PROFILE(controller, record_tx(write_bytes));
+            PROFILE_START(block_started);
+            const auto tx_done = uart_wait_tx_done(controller.m_uart_port, in_timeout_ms);
+            PROFILE(controller, record_write_block(block_started));
+            if (ESP_OK != tx_done)
             {
                 LOGD("uart_wait_tx_done failed");
                 return {eFAILED};
             }
-            return {eSUCCESS, write_bytes};
+            return {eSUCCESS, static_cast<size_t>(write_bytes)};
         }
 
         [[nodiscard]] OmegaStatus deinit(const Handle in_handle)
@@ -320,6 +357,17 @@ namespace Omega
             return eSUCCESS;
         }
 
+#if CONFIG_OMEGA_UART_CONTROLLER_PROFILE
+        ProfileSnapshot get_profile(Handle in_handle)
+        {
+            if (const auto found = s_profiles.find(in_handle); s_profiles.end() != found)
+            {
+                return found->second.snapshot();
+            }
+            return {};
+        }
+#endif
+
         __attribute__((weak)) void on_data(const Omega::UART::Handle, const u8 *, const size_t) {}
     } // namespace UART
 } // namespace Omega
@@ -21,14 +21,46 @@
  */
 
 #include <stdio.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <dirent.h>
 #include <cstring>
+#include <climits>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <unordered_map>
 #include <fcntl.h>
 #include <unistd.h>
 #include <termios.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <arpa/inet.h>
+#include <linux/netlink.h>
+#include <linux/serial.h>
+#if defined(CONFIG_OMEGA_UART_CONTROLLER_IO_URING)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
 
 #include "OmegaUtilityDriver/UtilityDriver.hpp"
+#include "OmegaUARTController/Async.hpp"
+#include "OmegaUARTController/BufferPool.hpp"
+#include "OmegaUARTController/Framing.hpp"
+#include "OmegaUARTController/Profile.hpp"
+#include "OmegaUARTController/Timers.hpp"
+#include "OmegaUARTController/RingBuffer.hpp"
+#include "OmegaUARTController/SlotMap.hpp"
 #include "OmegaUARTController/UARTController.hpp"
 
 struct TermiosBaudrates
@@ -37,6 +69,25 @@ struct TermiosBaudrates
     const u16 m_termios_baudrate;
 };
 
+// <asm/termbits.h> cannot be included next to <termios.h>, so the kernel's termios2 layout used by TCGETS2/TCSETS2 is mirrored here
+struct termios2
+{
+    tcflag_t c_iflag;
+    tcflag_t c_oflag;
+    tcflag_t c_cflag;
+    tcflag_t c_lflag;
+    cc_t c_line;
+    cc_t c_cc[19];
+    speed_t c_ispeed;
+    speed_t c_ospeed;
+};
+#ifndef BOTHER
+#define BOTHER 0010000
+#endif
+#ifndef IBSHIFT
+#define IBSHIFT 16
+#endif
+
 const size_t TERMIOS_BAUDRATE_COUNT = 30;
 const TermiosBaudrates termios_baudrates[30] = {
     {50, B50},
@@ -75,9 +126,41 @@ namespace Omega
 {
     namespace UART
     {
+        __internal__ constexpr size_t RX_CHUNK_SIZE{100};
+        __internal__ constexpr size_t RX_POOL_BLOCK_COUNT{32};
+        __internal__ constexpr size_t TERMIOS_MAX_VMIN{255};
+
+        // Where the next read lands: free space in the RX ring, the rest of the pending pool block, or the port's scratch
+        // buffer when the consumer fell behind and the bytes are going to be dropped
+        struct RxTarget
+        {
+            u8 *m_data;
+            size_t m_size;
+            bool m_discard;
+        };
 
+        // Lives in place inside s_com_ports. Whoever drops the last pin on a deinitialised port destroys it, which is also
+        // when its tty is closed, so a read() or write() still running on another thread never sees the descriptor reused
         struct UARTPort
         {
+            UARTPort(int in_handle, const char *in_port_name, Baudrate in_baudrate, DataBits in_databits, StopBits in_stopbits, Parity in_parity, int in_closing_handle)
+                : m_handle{in_handle}, m_baudrate{in_baudrate}, m_databits{in_databits}, m_stopbits{in_stopbits}, m_parity{in_parity}, m_closing_handle{in_closing_handle}
+            {
+                UNUSED(std::strncpy(m_port_name, in_port_name, PORT_NAME_SIZE));
+            }
+            UARTPort(const UARTPort &) = delete;
+            UARTPort &operator=(const UARTPort &) = delete;
+            ~UARTPort()
+            {
+                if (nullptr != m_rx_pool)
+                {
+                    m_rx_pool->retire();
+                }
+                tcflush(m_handle, TCIOFLUSH);
+                close(m_handle);
+                close(m_closing_handle);
+            }
+
             int m_handle;
             char m_port_name[PORT_NAME_SIZE + 1]{0};
             Baudrate m_baudrate{115200};
@@ -86,257 +169,2975 @@ namespace Omega
             Parity m_parity{Parity::ePARITY_DISABLE};
             std::vector<std::function<void(const Handle, const u8 *, const size_t)>> m_read_callbacks;
             std::thread *m_uart_read_thread{nullptr};
+            int m_stop_handle{-1};
+            std::atomic<bool> m_registered_to_reactor{false};
+            std::unique_ptr<RingBuffer> m_rx_ring;
+            BufferPool *m_rx_pool{nullptr};
+            std::vector<std::function<void(const Handle, const RxBuffer &)>> m_read_buffer_callbacks;
+            std::vector<std::function<void(const Handle, const RxChunk &)>> m_read_chunk_callbacks;
+            RxDeliveryPolicy m_rx_policy{};
+            RxBuffer m_rx_pending;
+            size_t m_rx_pending_size{0};
+            // Only kept while chunk callbacks are added. Set up by start() from the frame format
+            u64 m_rx_character_ns{0};
+            u64 m_rx_gap_threshold_us{0};
+            u64 m_rx_last_us{0};
+            u64 m_rx_pending_timestamp_us{0};
+            u64 m_rx_pending_gap_us{0};
+            int m_rx_timer_handle{-1};
+            bool m_rx_timer_armed{false};
+            u8 m_rx_discard[RX_CHUNK_SIZE];
+            std::atomic<bool> m_registered_to_uring{false};
+            RxTarget m_uring_rx_target{};
+            // start(), stop() and the setters serialise on m_control_mutex; read(), write() and delivery never take it
+            std::mutex m_control_mutex;
+            std::atomic<bool> m_stopping{false};
+            std::atomic<bool> m_closing{false};
+            int m_closing_handle{-1};
+            [[no_unique_address]] PortProfile m_profile;
+            // Guarded by s_async_loop.m_mutex, except for the stash which only the port's reading operation touches
+            Async::Operation *m_async_reader{nullptr};
+            Async::Operation *m_async_writer{nullptr};
+            u32 m_async_events{0};
+            bool m_async_registered{false};
+            std::vector<u8> m_async_stash;
         };
-        __internal__ std::unordered_map<Handle, UARTPort> s_com_ports;
+        __internal__ SlotMap<UARTPort> s_com_ports;
+        // Set on the threads that run read callbacks: the per-port readers, the reactor and the io_uring loop
+        __internal__ thread_local bool t_on_rx_thread{false};
+        // Set when a per-port reader got stopped from one of its own callbacks and has to wind itself down
+        __internal__ thread_local bool t_reader_detached{false};
+        __internal__ thread_local bool t_on_reactor_thread{false};
 
-        std::vector<EnumeratedUARTPort> get_available_ports()
+        __internal__ void arm_rx_timer(UARTPort &in_uart_port, bool in_arm)
         {
-            std::vector<EnumeratedUARTPort> serial_ports;
+            if (-1 == in_uart_port.m_rx_timer_handle || in_arm == in_uart_port.m_rx_timer_armed)
+            {
+                return;
+            }
+            const u32 latency_us = in_arm ? in_uart_port.m_rx_policy.max_latency_us : 0;
+            const itimerspec timer_spec{
+                .it_interval = {0, 0},
+                .it_value = {static_cast<time_t>(latency_us / 1000000), static_cast<long>(latency_us % 1000000) * 1000},
+            };
+            UNUSED(timerfd_settime(in_uart_port.m_rx_timer_handle, 0, &timer_spec, nullptr));
+            in_uart_port.m_rx_timer_armed = in_arm;
+        }
 
-            DIR *dir;
-            struct dirent *entry;
-            const char *dev_dir = "/dev";
-            const char *patterns[] = {"ttyS", "ttyUSB", "ttyACM"};
-            int i;
-            dir = opendir(dev_dir);
-            if (dir == NULL)
+        // Hands the batch collected so far to the read callbacks
+        __internal__ void flush_rx_pending(Handle in_handle, UARTPort &in_uart_port)
+        {
+            arm_rx_timer(in_uart_port, false);
+            if (0 == in_uart_port.m_rx_pending_size)
             {
-                OMEGA_LOGE("Unable to open /dev");
-                return serial_ports;
+                return;
+            }
+            auto rx_buffer = std::move(in_uart_port.m_rx_pending);
+            BufferPool::set_size(rx_buffer, in_uart_port.m_rx_pending_size);
+            in_uart_port.m_rx_pending_size = 0;
+            const auto callbacks_started = PortProfile::now();
+            for (const auto &user_callback : in_uart_port.m_read_callbacks)
+            {
+                user_callback(in_handle, rx_buffer.data(), rx_buffer.size());
+            }
+            for (const auto &user_callback : in_uart_port.m_read_buffer_callbacks)
+            {
+                user_callback(in_handle, rx_buffer);
             }
-            while ((entry = readdir(dir)) != NULL)
+            if (!in_uart_port.m_read_chunk_callbacks.empty())
             {
-                for (i = 0; i < sizeof(patterns) / sizeof(patterns[0]); i++)
+                const RxChunk rx_chunk{
+                    .data = rx_buffer.data(),
+                    .size = rx_buffer.size(),
+                    .timestamp_us = in_uart_port.m_rx_pending_timestamp_us,
+                    .gap_us = in_uart_port.m_rx_pending_gap_us,
+                    .gap = 0 != in_uart_port.m_rx_gap_threshold_us && in_uart_port.m_rx_pending_gap_us > in_uart_port.m_rx_gap_threshold_us,
+                };
+                for (const auto &user_callback : in_uart_port.m_read_chunk_callbacks)
                 {
-                    if (strncmp(entry->d_name, patterns[i], strlen(patterns[i])) == 0)
-                    {
-                        EnumeratedUARTPort uart_port{0};
-                        UNUSED(sprintf(uart_port.m_port_name, "/dev/%s", entry->d_name));
-                        serial_ports.push_back(uart_port);
-                    }
+                    user_callback(in_handle, rx_chunk);
                 }
             }
-            closedir(dir);
-            return serial_ports;
+            in_uart_port.m_profile.record_callbacks(callbacks_started);
         }
 
-        Handle init(const char *in_port, Baudrate in_baudrate, DataBits in_databits, Parity in_parity, StopBits in_stopbits)
+        __internal__ void on_rx_timer_expired(Handle in_handle, UARTPort &in_uart_port)
         {
-            __internal__ Handle user_serial_handle = 0;
+            u64 expirations{};
+            UNUSED(::read(in_uart_port.m_rx_timer_handle, &expirations, sizeof(expirations)));
+            in_uart_port.m_rx_timer_armed = false;
+            flush_rx_pending(in_handle, in_uart_port);
+        }
 
-            if (nullptr == in_port || 0 == std::strlen(in_port))
+        // Start bit, data bits, parity and stop bits
+        __internal__ u64 character_time_ns(const UARTPort &in_uart_port)
+        {
+            u64 half_bits = 2 * (1 + static_cast<u64>(in_uart_port.m_databits) + (Parity::ePARITY_DISABLE == in_uart_port.m_parity ? 0 : 1));
+            half_bits += StopBits::eSTOP_BITS_2 == in_uart_port.m_stopbits ? 4 : StopBits::eSTOP_BITS_1_5 == in_uart_port.m_stopbits ? 3 : 2;
+            return half_bits * 1000000000 / (2 * std::max<u64>(1, in_uart_port.m_baudrate));
+        }
+
+        __internal__ RxTarget next_rx_target(UARTPort &in_uart_port)
+        {
+            if (nullptr != in_uart_port.m_rx_ring)
             {
-                OMEGA_LOGE("Invalid serial port path");
-                return 0;
+                if (const auto span = in_uart_port.m_rx_ring->write_span(); !span.empty())
+                {
+                    return {span.data(), span.size(), false};
+                }
+            }
+            else if (in_uart_port.m_rx_pending || (in_uart_port.m_rx_pending = in_uart_port.m_rx_pool->acquire()))
+            {
+                return {BufferPool::writable_data(in_uart_port.m_rx_pending) + in_uart_port.m_rx_pending_size, in_uart_port.m_rx_pool->block_size() - in_uart_port.m_rx_pending_size, false};
             }
+            return {in_uart_port.m_rx_discard, sizeof(in_uart_port.m_rx_discard), true};
+        }
 
-            int termios_baudrate_index = -1;
-            for (size_t idx = 0; idx < TERMIOS_BAUDRATE_COUNT; ++idx)
+        __internal__ void commit_rx(Handle in_handle, UARTPort &in_uart_port, const RxTarget &in_target, size_t in_read_bytes)
+        {
+            if (nullptr != in_uart_port.m_rx_ring)
             {
-                if (in_baudrate == termios_baudrates[idx].m_user_baurdare)
+                if (in_target.m_discard)
                 {
-                    termios_baudrate_index = idx;
-                    break;
+                    // Keep the kernel buffer moving even though the consumer fell behind
+                    in_uart_port.m_rx_ring->record_overrun(in_read_bytes);
+                    in_uart_port.m_profile.record_overrun(in_read_bytes);
+                    return;
                 }
+                in_uart_port.m_rx_ring->publish(in_read_bytes);
+                return;
             }
-            if (-1 == termios_baudrate_index)
+            if (in_target.m_discard)
             {
-                OMEGA_LOGE("Custom baudrates are not supported by Linux");
-                return 0;
+                // Every block is still held by a consumer. The bytes were dropped instead of stalling the tty
+                in_uart_port.m_profile.record_overrun(in_read_bytes);
+                return;
+            }
+            if (!in_uart_port.m_read_chunk_callbacks.empty())
+            {
+                const u64 now_us = Timers::now();
+                if (0 == in_uart_port.m_rx_pending_size)
+                {
+                    const u64 transfer_us = in_read_bytes * in_uart_port.m_rx_character_ns / 1000;
+                    const u64 first_byte_us = now_us > transfer_us ? now_us - transfer_us : 0;
+                    in_uart_port.m_rx_pending_gap_us = first_byte_us > in_uart_port.m_rx_last_us ? first_byte_us - in_uart_port.m_rx_last_us : 0;
+                }
+                in_uart_port.m_rx_pending_timestamp_us = now_us;
+                in_uart_port.m_rx_last_us = now_us;
+            }
+            if (0 == in_uart_port.m_rx_pending_size)
+            {
+                arm_rx_timer(in_uart_port, true);
+            }
+            in_uart_port.m_rx_pending_size += in_read_bytes;
+            if (in_uart_port.m_rx_pending_size >= std::min(in_uart_port.m_rx_policy.min_bytes, in_uart_port.m_rx_pool->block_size()))
+            {
+                flush_rx_pending(in_handle, in_uart_port);
             }
+        }
 
-            int serial_handle = 0;
-            if (serial_handle = open(in_port, O_RDWR | O_NOCTTY); -1 == serial_handle)
+        // Reads everything the tty currently holds and hands it to the RX ring or to the read callbacks
+        __internal__ void drain_port(Handle in_handle, UARTPort &in_uart_port)
+        {
+            for (;;)
             {
-                OMEGA_LOGE("Opening serial port failed with %s", strerror(errno));
-                return 0;
+                const auto rx_target = next_rx_target(in_uart_port);
+                const ssize_t read_bytes = ::read(in_uart_port.m_handle, rx_target.m_data, rx_target.m_size);
+                in_uart_port.m_profile.record_rx(read_bytes);
+                if (0 >= read_bytes)
+                {
+                    if (-1 == read_bytes && EAGAIN != errno && EWOULDBLOCK != errno && EINTR != errno)
+                    {
+                        OMEGA_LOGE("read failed with %s", strerror(errno));
+                    }
+                    return;
+                }
+                commit_rx(in_handle, in_uart_port, rx_target, read_bytes);
+                // A read callback that stopped the handle leaves the rest of the tty to whoever starts it next
+                if (t_on_reactor_thread ? !in_uart_port.m_registered_to_reactor.load(std::memory_order_acquire) : t_reader_detached)
+                {
+                    return;
+                }
+                if (rx_target.m_size > static_cast<size_t>(read_bytes))
+                {
+                    return;
+                }
             }
+        }
 
+        __internal__ OmegaStatus apply_rx_delivery_policy(UARTPort &in_uart_port)
+        {
+            const auto &rx_policy = in_uart_port.m_rx_policy;
             struct termios termios_config{};
-            if (tcgetattr(serial_handle, &termios_config) != 0)
+            if (0 != tcgetattr(in_uart_port.m_handle, &termios_config))
             {
-                OMEGA_LOGE("tcgetattr");
-                return 0;
+                OMEGA_LOGE("tcgetattr failed with %s", strerror(errno));
+                return eFAILED;
             }
-            if (const auto status = cfsetospeed(&termios_config, termios_baudrates[termios_baudrate_index].m_termios_baudrate); -1 == status)
+            // With VTIME = 0 the tty only reports POLLIN once VMIN bytes are queued, so the kernel does the batching for us.
+            // A latency bound has to be enforced from user space instead, which needs a wakeup on every first byte
+            const bool kernel_batching = nullptr != in_uart_port.m_rx_ring || 0 == rx_policy.max_latency_us;
+            termios_config.c_cc[VMIN] = kernel_batching ? std::clamp<size_t>(rx_policy.min_bytes, 1, TERMIOS_MAX_VMIN) : 1;
+            termios_config.c_cc[VTIME] = 0;
+            if (0 != tcsetattr(in_uart_port.m_handle, TCSANOW, &termios_config))
             {
-                OMEGA_LOGE("cfsetospeed failed for %d", in_baudrate);
-                return 0;
+                OMEGA_LOGE("tcsetattr failed with %s", strerror(errno));
+                return eFAILED;
             }
-            if (const auto status = cfsetispeed(&termios_config, termios_baudrates[termios_baudrate_index].m_termios_baudrate); -1 == status)
+            if (!kernel_batching && -1 == in_uart_port.m_rx_timer_handle)
             {
-                OMEGA_LOGE("cfsetispeed failed for %d", in_baudrate);
-                return 0;
+                if (in_uart_port.m_rx_timer_handle = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC); -1 == in_uart_port.m_rx_timer_handle)
+                {
+                    OMEGA_LOGE("timerfd_create failed with %s", strerror(errno));
+                    return eFAILED;
+                }
             }
+            return eSUCCESS;
+        }
 
-            termios_config.c_cflag &= ~CSIZE;
-            switch (in_databits)
+        __internal__ void release_rx_timer(UARTPort &in_uart_port)
+        {
+            if (-1 != in_uart_port.m_rx_timer_handle)
             {
-            case DataBits::eDATA_BITS_5:
+                close(in_uart_port.m_rx_timer_handle);
+                in_uart_port.m_rx_timer_handle = -1;
+                in_uart_port.m_rx_timer_armed = false;
+            }
+        }
+
+        __internal__ bool is_started(const UARTPort &in_uart_port)
+        {
+            return nullptr != in_uart_port.m_uart_read_thread || in_uart_port.m_registered_to_reactor || in_uart_port.m_registered_to_uring;
+        }
+
+        struct Reactor
+        {
+            int m_epoll_handle{-1};
+            int m_wakeup_handle{-1};
+            std::thread *m_thread{nullptr};
+            size_t m_registered_count{0};
+            std::atomic<bool> m_running{false};
+            // Guarded by s_reactor_mutex. stop() waits on m_changed for the handle being dispatched, and the last stop()
+            // for the loop to exit, without holding the lock, so callbacks on the loop can still start and stop handles
+            Handle m_dispatching{INVALID_UART_HANDLE};
+            size_t m_dispatch_waiters{0};
+            bool m_exited{false};
+            std::condition_variable m_changed;
+        };
+        __internal__ constexpr size_t REACTOR_MAX_EVENTS{64};
+        __internal__ std::atomic<IOModel> s_io_model{IOModel::eTHREAD_PER_PORT};
+        __internal__ Reactor s_reactor;
+        __internal__ std::mutex s_reactor_mutex;
+
+        // Marks epoll events that belong to a port's RX coalescing timer rather than to its tty
+        __internal__ constexpr u64 REACTOR_RX_TIMER_EVENT{1ULL << 63};
+
+        __internal__ void reactor_dispatch(u64 in_event_data)
+        {
+            const Handle handle = in_event_data & ~REACTOR_RX_TIMER_EVENT;
+            auto found = s_com_ports.pin(handle);
+            if (!found)
             {
-                termios_config.c_cflag |= CS5;
-                break;
+                return;
             }
-            case DataBits::eDATA_BITS_6:
             {
-                termios_config.c_cflag |= CS6;
-                break;
+                std::lock_guard lock{s_reactor_mutex};
+                // the event may have been reported before stop() took the port off the reactor
+                if (!found->m_registered_to_reactor)
+                {
+                    return;
+                }
+                s_reactor.m_dispatching = handle;
             }
-            case DataBits::eDATA_BITS_7:
+            if (0 != (in_event_data & REACTOR_RX_TIMER_EVENT))
             {
-                termios_config.c_cflag |= CS7;
-                break;
+                on_rx_timer_expired(handle, *found);
             }
-            case DataBits::eDATA_BITS_8:
+            else
             {
-                termios_config.c_cflag |= CS8;
-                break;
+                drain_port(handle, *found);
             }
+            std::lock_guard lock{s_reactor_mutex};
+            s_reactor.m_dispatching = INVALID_UART_HANDLE;
+            if (0 < s_reactor.m_dispatch_waiters)
+            {
+                s_reactor.m_changed.notify_all();
             }
-            switch (in_parity)
+        }
+
+        // Checked again under the lock once the flag drops, since a start() may take the loop back while it winds down
+        __internal__ bool reactor_keep_running()
+        {
+            if (s_reactor.m_running.load(std::memory_order_acquire))
             {
-            case Parity::ePARITY_DISABLE:
+                return true;
+            }
+            std::lock_guard lock{s_reactor_mutex};
+            if (s_reactor.m_running.load(std::memory_order_relaxed))
             {
-                termios_config.c_cflag &= ~PARENB;
-                break;
+                return true;
             }
-            case Parity::ePARITY_ODD:
+            s_reactor.m_exited = true;
+            s_reactor.m_changed.notify_all();
+            return false;
+        }
+
+        __internal__ void reactor_loop()
+        {
+            t_on_rx_thread = true;
+            t_on_reactor_thread = true;
+            epoll_event events[REACTOR_MAX_EVENTS]{};
+            while (reactor_keep_running())
             {
-                termios_config.c_cflag |= PARENB;
-                termios_config.c_cflag &= ~PARODD;
-                break;
+                const int event_count = epoll_wait(s_reactor.m_epoll_handle, events, REACTOR_MAX_EVENTS, -1);
+                if (-1 == event_count)
+                {
+                    if (EINTR == errno)
+                    {
+                        continue;
+                    }
+                    OMEGA_LOGE("epoll_wait failed with %s", strerror(errno));
+                    std::lock_guard lock{s_reactor_mutex};
+                    s_reactor.m_exited = true;
+                    s_reactor.m_changed.notify_all();
+                    return;
+                }
+                for (int idx = 0; idx < event_count; ++idx)
+                {
+                    const u64 event_data = events[idx].data.u64;
+                    if (INVALID_UART_HANDLE == event_data)
+                    {
+                        eventfd_t value{};
+                        UNUSED(eventfd_read(s_reactor.m_wakeup_handle, &value));
+                        continue;
+                    }
+                    reactor_dispatch(event_data);
+                }
             }
-            case Parity::ePARITY_EVEN:
+        }
+
+        __internal__ OmegaStatus reactor_register(Handle in_handle, UARTPort &in_uart_port)
+        {
+            std::unique_lock lock{s_reactor_mutex};
+            if (nullptr != s_reactor.m_thread && !s_reactor.m_running.load(std::memory_order_relaxed))
             {
-                termios_config.c_cflag |= PARENB;
-                termios_config.c_cflag |= PARODD;
-                break;
+                if (s_reactor.m_exited)
+                {
+                    // the last stop() is about to join the loop and close it, a new one is set up once it is gone
+                    s_reactor.m_changed.wait(lock, []
+                                             { return nullptr == s_reactor.m_thread; });
+                }
+                else
+                {
+                    // still winding down: keep it instead
+                    s_reactor.m_running.store(true, std::memory_order_release);
+                    s_reactor.m_changed.notify_all();
+                }
+            }
+            if (-1 == s_reactor.m_epoll_handle)
+            {
+                if (s_reactor.m_epoll_handle = epoll_create1(EPOLL_CLOEXEC); -1 == s_reactor.m_epoll_handle)
+                {
+                    OMEGA_LOGE("epoll_create1 failed with %s", strerror(errno));
+                    return eFAILED;
+                }
+                if (s_reactor.m_wakeup_handle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC); -1 == s_reactor.m_wakeup_handle)
+                {
+                    OMEGA_LOGE("eventfd failed with %s", strerror(errno));
+                    close(s_reactor.m_epoll_handle);
+                    s_reactor.m_epoll_handle = -1;
+                    return eFAILED;
+                }
+                epoll_event wakeup_event{.events = EPOLLIN, .data = {.u64 = INVALID_UART_HANDLE}};
+                UNUSED(epoll_ctl(s_reactor.m_epoll_handle, EPOLL_CTL_ADD, s_reactor.m_wakeup_handle, &wakeup_event));
+                s_reactor.m_running.store(true, std::memory_order_release);
+                s_reactor.m_thread = new std::thread{reactor_loop};
+            }
+            epoll_event port_event{.events = EPOLLIN, .data = {.u64 = in_handle}};
+            if (-1 == epoll_ctl(s_reactor.m_epoll_handle, EPOLL_CTL_ADD, in_uart_port.m_handle, &port_event))
+            {
+                OMEGA_LOGE("epoll_ctl failed with %s", strerror(errno));
+                return eFAILED;
             }
+            if (-1 != in_uart_port.m_rx_timer_handle)
+            {
+                epoll_event timer_event{.events = EPOLLIN, .data = {.u64 = in_handle | REACTOR_RX_TIMER_EVENT}};
+                if (-1 == epoll_ctl(s_reactor.m_epoll_handle, EPOLL_CTL_ADD, in_uart_port.m_rx_timer_handle, &timer_event))
+                {
+                    OMEGA_LOGE("epoll_ctl failed with %s", strerror(errno));
+                    UNUSED(epoll_ctl(s_reactor.m_epoll_handle, EPOLL_CTL_DEL, in_uart_port.m_handle, nullptr));
+                    return eFAILED;
+                }
             }
+            in_uart_port.m_registered_to_reactor = true;
+            s_reactor.m_registered_count++;
+            return eSUCCESS;
+        }
 
-            switch (in_stopbits)
+        __internal__ void reactor_unregister(Handle in_handle, UARTPort &in_uart_port)
+        {
+            std::unique_lock lock{s_reactor_mutex};
+            UNUSED(epoll_ctl(s_reactor.m_epoll_handle, EPOLL_CTL_DEL, in_uart_port.m_handle, nullptr));
+            if (-1 != in_uart_port.m_rx_timer_handle)
             {
-            case StopBits::eSTOP_BITS_1:
+                UNUSED(epoll_ctl(s_reactor.m_epoll_handle, EPOLL_CTL_DEL, in_uart_port.m_rx_timer_handle, nullptr));
+            }
+            in_uart_port.m_registered_to_reactor = false;
+            const bool on_reactor_thread = std::this_thread::get_id() == s_reactor.m_thread->get_id();
+            if (!on_reactor_thread)
             {
-                termios_config.c_cflag &= ~CSTOPB;
-                break;
+                // An event for this handle may be in its callbacks. Those may start and stop other handles, so the wait
+                // gives up the lock
+                s_reactor.m_dispatch_waiters++;
+                s_reactor.m_changed.wait(lock, [in_handle]
+                                         { return in_handle != s_reactor.m_dispatching; });
+                s_reactor.m_dispatch_waiters--;
             }
-            case StopBits::eSTOP_BITS_2:
+            // A reactor emptied from inside a callback stays up idle and is picked up again by the next start(), so a
+            // restart from that callback never ends up with two loops on one epoll set
+            if (0 < --s_reactor.m_registered_count || on_reactor_thread)
             {
-                termios_config.c_cflag |= CSTOPB;
-                break;
+                return;
             }
+            s_reactor.m_running.store(false, std::memory_order_release);
+            UNUSED(eventfd_write(s_reactor.m_wakeup_handle, 1));
+            // A callback still running on the loop may start a handle meanwhile, which keeps the loop up
+            auto *reactor_thread = s_reactor.m_thread;
+            s_reactor.m_changed.wait(lock, [reactor_thread]
+                                     { return reactor_thread != s_reactor.m_thread || s_reactor.m_exited || s_reactor.m_running.load(std::memory_order_relaxed); });
+            if (reactor_thread != s_reactor.m_thread || !s_reactor.m_exited)
+            {
+                return;
             }
-            // Raw input/output (no canonical mode, no echo, no signal chars)
-            termios_config.c_lflag = 0;
-            termios_config.c_oflag = 0;
-            termios_config.c_iflag &= ~(IXON | IXOFF | IXANY); // Disable software flow control
+            s_reactor.m_thread->join();
+            delete s_reactor.m_thread;
+            s_reactor.m_thread = nullptr;
+            s_reactor.m_exited = false;
+            close(s_reactor.m_wakeup_handle);
+            close(s_reactor.m_epoll_handle);
+            s_reactor.m_wakeup_handle = -1;
+            s_reactor.m_epoll_handle = -1;
+            s_reactor.m_changed.notify_all();
+        }
 
-            // No blocking on read, unless at least 1 byte available
-            termios_config.c_cc[VMIN] = 1;
-            termios_config.c_cc[VTIME] = 0;
+#if defined(CONFIG_OMEGA_UART_CONTROLLER_IO_URING)
+        /* START: IO_URING */
+        // Talks to the kernel through <linux/io_uring.h> and raw syscalls so liburing is not required
+        struct Uring
+        {
+            int m_ring_handle{-1};
+            void *m_sq_ring{nullptr};
+            size_t m_sq_ring_size{0};
+            void *m_cq_ring{nullptr};
+            size_t m_cq_ring_size{0};
+            io_uring_sqe *m_sqes{nullptr};
+            size_t m_sqes_size{0};
+            u32 *m_sq_head{nullptr};
+            u32 *m_sq_tail{nullptr};
+            u32 *m_sq_array{nullptr};
+            u32 m_sq_mask{0};
+            u32 m_sq_entries{0};
+            u32 *m_cq_head{nullptr};
+            u32 *m_cq_tail{nullptr};
+            io_uring_cqe *m_cqes{nullptr};
+            u32 m_cq_mask{0};
+            std::mutex m_submit_mutex;
+            std::thread *m_thread{nullptr};
+            size_t m_registered_count{0};
+            std::atomic<bool> m_running{false};
+            // Guarded by s_uring_mutex, waited on the same way as the reactor's
+            Handle m_dispatching{INVALID_UART_HANDLE};
+            size_t m_dispatch_waiters{0};
+            bool m_exited{false};
+            std::condition_variable m_changed;
+        };
+        __internal__ constexpr u32 URING_QUEUE_DEPTH{256};
+        __internal__ Uring s_uring;
+        __internal__ std::mutex s_uring_mutex;
 
-            if (tcsetattr(serial_handle, TCSANOW, &termios_config) != 0)
-            {
-                perror("tcsetattr");
-                return 0;
-            }
+        // The top two bits of user_data say what completed, the rest carries a handle or a UringWrite pointer
+        __internal__ constexpr u64 URING_TAG_MASK{3ULL << 62};
+        __internal__ constexpr u64 URING_READ_EVENT{0};
+        __internal__ constexpr u64 URING_RX_TIMER_EVENT{1ULL << 62};
+        __internal__ constexpr u64 URING_WRITE_EVENT{2ULL << 62};
+        __internal__ constexpr u64 URING_WAKEUP_EVENT{3ULL << 62};
 
-            tcflush(serial_handle, TCIOFLUSH);
+        struct UringWriteBatch;
+        struct UringWrite
+        {
+            UringWriteBatch *m_batch;
+            WriteRequest *m_request;
+            UARTPort *m_uart_port; // pinned by uring_write_batch() for as long as the batch runs
+            size_t m_next; // next request for the same handle, written once this one is done
+            bool m_in_flight{false};
+        };
 
-            user_serial_handle++;
-            UARTPort serial_port{
-                .m_handle = serial_handle,
-                .m_baudrate = in_baudrate,
-                .m_databits = in_databits,
-                .m_stopbits = in_stopbits,
-                .m_parity = in_parity,
-            };
-            UNUSED(std::strncpy(serial_port.m_port_name, in_port, PORT_NAME_SIZE));
-            UNUSED(s_com_ports.insert({user_serial_handle, serial_port}));
+        struct UringWriteBatch
+        {
+            std::mutex m_mutex;
+            std::condition_variable m_completed;
+            std::vector<UringWrite> m_writes;
+            size_t m_remaining{0};
+            bool m_cancelled{false};
+        };
+        __internal__ constexpr size_t URING_NO_NEXT_WRITE{SIZE_MAX};
 
-            return user_serial_handle;
+        __internal__ int uring_enter(u32 in_to_submit, u32 in_min_complete, u32 in_flags)
+        {
+            return static_cast<int>(syscall(__NR_io_uring_enter, s_uring.m_ring_handle, in_to_submit, in_min_complete, in_flags, nullptr, 0));
         }
 
-        Response read(Handle in_handle, u8 *out_buffer, const size_t in_read_bytes, u32 in_timeout_ms)
+        // Hands every queued SQE to the kernel. The kernel clamps the count to what is actually queued
+        __internal__ void uring_submit()
         {
-            if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+            while (-1 == uring_enter(s_uring.m_sq_entries, 0, 0) && EINTR == errno)
             {
-                auto &uart_port = s_com_ports.at(in_handle);
-                unsigned long read_bytes = 0;
-                if (read_bytes = ::read(uart_port.m_handle, out_buffer, in_read_bytes); -1 == read_bytes)
-                {
-                    OMEGA_LOGE("read filed failed");
-                    return {eFAILED, 0};
-                }
-                return {eSUCCESS, read_bytes};
             }
-            return {eSUCCESS, 0};
         }
 
-        Response write(Handle in_handle, const u8 *in_buffer, const size_t in_write_bytes, u32 in_timeout_ms)
+        // Queues one SQE without a syscall; it goes out with the next uring_submit() or the ring thread's next wait
+        __internal__ void uring_queue(const io_uring_sqe &in_sqe)
         {
-            if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+            std::lock_guard lock{s_uring.m_submit_mutex};
+            const u32 tail = *s_uring.m_sq_tail;
+            while (tail - std::atomic_ref<u32>{*s_uring.m_sq_head}.load(std::memory_order_acquire) >= s_uring.m_sq_entries)
             {
-                auto &uart_port = s_com_ports.at(in_handle);
-                unsigned long written_bytes = 0;
-                if (written_bytes = ::write(uart_port.m_handle, in_buffer, in_write_bytes); -1 == written_bytes)
-                {
-                    OMEGA_LOGE("Write filed failed");
-                    return {eFAILED, 0};
-                }
-                return {eSUCCESS, written_bytes};
+                uring_submit();
             }
-            return {eSUCCESS, 0};
+            const u32 index = tail & s_uring.m_sq_mask;
+            s_uring.m_sqes[index] = in_sqe;
+            s_uring.m_sq_array[index] = index;
+            std::atomic_ref<u32>{*s_uring.m_sq_tail}.store(tail + 1, std::memory_order_release);
         }
 
-        OmegaStatus add_on_read_callback(Handle in_handle, std::function<void(const Handle, const u8 *, const size_t)> in_callback)
+        __internal__ io_uring_sqe make_sqe(u8 in_opcode, int in_fd, const void *in_address, size_t in_length, u64 in_user_data)
+        {
+            io_uring_sqe sqe{};
+            sqe.opcode = in_opcode;
+            sqe.fd = in_fd;
+            sqe.off = UINT64_MAX; // ttys are streams, use the file position
+            sqe.addr = reinterpret_cast<u64>(in_address);
+            sqe.len = static_cast<u32>(std::min<size_t>(in_length, UINT32_MAX));
+            sqe.user_data = in_user_data;
+            return sqe;
+        }
+
+        __internal__ void uring_post_read(Handle in_handle, UARTPort &in_uart_port)
+        {
+            in_uart_port.m_uring_rx_target = next_rx_target(in_uart_port);
+            const auto &rx_target = in_uart_port.m_uring_rx_target;
+            uring_queue(make_sqe(IORING_OP_READ, in_uart_port.m_handle, rx_target.m_data, rx_target.m_size, URING_READ_EVENT | in_handle));
+        }
+
+        __internal__ void uring_post_rx_timer(Handle in_handle, UARTPort &in_uart_port)
+        {
+            auto sqe = make_sqe(IORING_OP_POLL_ADD, in_uart_port.m_rx_timer_handle, nullptr, 0, URING_RX_TIMER_EVENT | in_handle);
+            sqe.off = 0;
+            sqe.poll32_events = POLLIN;
+            uring_queue(sqe);
+        }
+
+        __internal__ void uring_post_cancel(u64 in_user_data)
+        {
+            auto sqe = make_sqe(IORING_OP_ASYNC_CANCEL, -1, nullptr, 0, URING_WAKEUP_EVENT);
+            sqe.off = 0;
+            sqe.addr = in_user_data;
+            uring_queue(sqe);
+        }
+
+        __internal__ void uring_post_write(UringWrite &in_write)
+        {
+            const auto &request = *in_write.m_request;
+            in_write.m_in_flight = true;
+            uring_queue(make_sqe(IORING_OP_WRITE, in_write.m_uart_port->m_handle, request.buffer + request.response.size, request.size - request.response.size,
+                                 URING_WRITE_EVENT | reinterpret_cast<u64>(&in_write)));
+        }
+
+        __internal__ void uring_on_write_completed(UringWrite &in_write, int in_result)
         {
-            if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+            auto &batch = *in_write.m_batch;
+            std::lock_guard lock{batch.m_mutex};
+            in_write.m_in_flight = false;
+            in_write.m_uart_port->m_profile.record_tx(in_result);
+            auto &request = *in_write.m_request;
+            if (0 < in_result)
             {
-                auto &uart_port = s_com_ports.at(in_handle);
-                uart_port.m_read_callbacks.push_back(in_callback);
-                return eSUCCESS;
+                request.response.size += in_result;
+            }
+            else if (-EAGAIN != in_result && -EINTR != in_result && -ECANCELED != in_result)
+            {
+                OMEGA_LOGE("write failed with %s", strerror(-in_result));
+                request.response.status = eFAILED;
+            }
+            const bool failed = eSUCCESS != request.response.status;
+            if (!failed && !batch.m_cancelled && request.response.size < request.size)
+            {
+                // ttys accept partial writes, keep going with the rest
+                uring_post_write(in_write);
+                return;
+            }
+            for (auto *write = &in_write;;)
+            {
+                write->m_request->response.timed_out = !failed && write->m_request->response.size < write->m_request->size;
+                --batch.m_remaining;
+                if (URING_NO_NEXT_WRITE == write->m_next)
+                {
+                    break;
+                }
+                write = &batch.m_writes[write->m_next];
+                if (!batch.m_cancelled)
+                {
+                    uring_post_write(*write);
+                    break;
+                }
+            }
+            if (0 == batch.m_remaining)
+            {
+                batch.m_completed.notify_all();
             }
-            return eFAILED;
         }
 
-        OmegaStatus start(Handle in_handle)
+        __internal__ void uring_on_port_event(u64 in_tag, Handle in_handle, UARTPort &in_uart_port, int in_result)
         {
-            if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+            if (URING_RX_TIMER_EVENT == in_tag)
             {
-                auto &uart_port = s_com_ports.at(in_handle);
-                auto uart_read_thread = [in_handle](const UARTPort &in_uart_port)
+                if (0 < in_result)
                 {
-                    for (;;)
-                    {
-                        char buffer[100 + 1]{0};
-                        const auto response = read(in_handle, (u8 *)buffer, 100, 0);
-                        if (0 < response.size)
-                        {
-                            for (const auto &user_callback : in_uart_port.m_read_callbacks)
-                            {
-                                user_callback(in_handle, (const u8 *)buffer, response.size);
-                            }
-                        }
-                    }
-                };
-                uart_port.m_uart_read_thread = new std::thread{uart_read_thread, uart_port};
-                return eSUCCESS;
+                    on_rx_timer_expired(in_handle, in_uart_port);
+                }
+            }
+            else if (0 < in_result)
+            {
+                in_uart_port.m_profile.record_rx(in_result);
+                commit_rx(in_handle, in_uart_port, in_uart_port.m_uring_rx_target, in_result);
+            }
+            else if (-EAGAIN != in_result && -EINTR != in_result)
+            {
+                if (-ECANCELED != in_result)
+                {
+                    OMEGA_LOGE("read failed with %s", 0 == in_result ? "end of file" : strerror(-in_result));
+                }
+                return;
+            }
+            // a read callback may have stopped or deinitialised the handle
+            if (in_uart_port.m_registered_to_uring)
+            {
+                if (URING_RX_TIMER_EVENT == in_tag)
+                {
+                    uring_post_rx_timer(in_handle, in_uart_port);
+                }
+                else
+                {
+                    uring_post_read(in_handle, in_uart_port);
+                }
             }
-            return eFAILED;
         }
 
-        OmegaStatus deinit(const Handle in_handle)
+        __internal__ void uring_dispatch(const io_uring_cqe &in_cqe)
         {
-            if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+            const u64 tag = in_cqe.user_data & URING_TAG_MASK;
+            if (URING_WRITE_EVENT == tag)
             {
-                auto &uart_port = s_com_ports.at(in_handle);
-                uart_port.m_uart_read_thread->join();
-                delete uart_port.m_uart_read_thread;
-                uart_port.m_uart_read_thread = nullptr;
-                tcflush(uart_port.m_handle, TCIOFLUSH);
-                close(uart_port.m_handle);
+                uring_on_write_completed(*reinterpret_cast<UringWrite *>(in_cqe.user_data & ~URING_TAG_MASK), in_cqe.res);
+                return;
+            }
+            if (URING_WAKEUP_EVENT == tag)
+            {
+                return;
+            }
+            const Handle handle = in_cqe.user_data & ~URING_TAG_MASK;
+            auto found = s_com_ports.pin(handle);
+            if (!found)
+            {
+                return;
+            }
+            {
+                std::lock_guard lock{s_uring_mutex};
+                if (!found->m_registered_to_uring)
+                {
+                    // completion of a request that was cancelled when the handle stopped
+                    return;
+                }
+                s_uring.m_dispatching = handle;
+            }
+            uring_on_port_event(tag, handle, *found, in_cqe.res);
+            std::lock_guard lock{s_uring_mutex};
+            s_uring.m_dispatching = INVALID_UART_HANDLE;
+            if (0 < s_uring.m_dispatch_waiters)
+            {
+                s_uring.m_changed.notify_all();
+            }
+        }
+
+        // Checked again under the lock once the flag drops, since a start() may take the ring back while it winds down
+        __internal__ bool uring_keep_running()
+        {
+            if (s_uring.m_running.load(std::memory_order_acquire))
+            {
+                return true;
+            }
+            std::lock_guard lock{s_uring_mutex};
+            if (s_uring.m_running.load(std::memory_order_relaxed))
+            {
+                return true;
+            }
+            s_uring.m_exited = true;
+            s_uring.m_changed.notify_all();
+            return false;
+        }
+
+        __internal__ void uring_loop()
+        {
+            t_on_rx_thread = true;
+            while (uring_keep_running())
+            {
+                // One syscall submits every read reposted during the last round and waits for the next completions. The
+                // kernel skips the wait when it submits fewer SQEs than asked for, so ask for exactly the queued ones
+                const u32 queued = std::atomic_ref<u32>{*s_uring.m_sq_tail}.load(std::memory_order_acquire) -
+                                   std::atomic_ref<u32>{*s_uring.m_sq_head}.load(std::memory_order_acquire);
+                if (-1 == uring_enter(queued, 1, IORING_ENTER_GETEVENTS) && EINTR != errno && EBUSY != errno && EAGAIN != errno)
+                {
+                    OMEGA_LOGE("io_uring_enter failed with %s", strerror(errno));
+                    std::lock_guard lock{s_uring_mutex};
+                    s_uring.m_exited = true;
+                    s_uring.m_changed.notify_all();
+                    return;
+                }
+                u32 head = *s_uring.m_cq_head;
+                const u32 tail = std::atomic_ref<u32>{*s_uring.m_cq_tail}.load(std::memory_order_acquire);
+                if (head != tail)
+                {
+                    // Port state set up before a read was queued only reaches this thread through the kernel. Pairing with
+                    // the submit lock makes that ordering visible to the language memory model as well
+                    std::lock_guard lock{s_uring.m_submit_mutex};
+                }
+                for (; head != tail; ++head)
+                {
+                    const io_uring_cqe cqe = s_uring.m_cqes[head & s_uring.m_cq_mask];
+                    std::atomic_ref<u32>{*s_uring.m_cq_head}.store(head + 1, std::memory_order_release);
+                    uring_dispatch(cqe);
+                }
+            }
+        }
+
+        __internal__ void uring_close()
+        {
+            if (nullptr != s_uring.m_sqes)
+            {
+                munmap(s_uring.m_sqes, s_uring.m_sqes_size);
+            }
+            if (nullptr != s_uring.m_cq_ring && s_uring.m_cq_ring != s_uring.m_sq_ring)
+            {
+                munmap(s_uring.m_cq_ring, s_uring.m_cq_ring_size);
+            }
+            if (nullptr != s_uring.m_sq_ring)
+            {
+                munmap(s_uring.m_sq_ring, s_uring.m_sq_ring_size);
+            }
+            if (-1 != s_uring.m_ring_handle)
+            {
+                close(s_uring.m_ring_handle);
+            }
+            s_uring.m_ring_handle = -1;
+            s_uring.m_sq_ring = s_uring.m_cq_ring = nullptr;
+            s_uring.m_sqes = nullptr;
+        }
+
+        __internal__ OmegaStatus uring_open()
+        {
+            io_uring_params params{};
+            if (s_uring.m_ring_handle = static_cast<int>(syscall(__NR_io_uring_setup, URING_QUEUE_DEPTH, &params)); -1 == s_uring.m_ring_handle)
+            {
+                OMEGA_LOGE("io_uring_setup failed with %s", strerror(errno));
+                return eFAILED;
+            }
+            s_uring.m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+            s_uring.m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool single_mmap = 0 != (params.features & IORING_FEAT_SINGLE_MMAP);
+            if (single_mmap)
+            {
+                s_uring.m_sq_ring_size = s_uring.m_cq_ring_size = std::max(s_uring.m_sq_ring_size, s_uring.m_cq_ring_size);
+            }
+            const auto map = [](size_t in_size, off_t in_offset) -> void *
+            {
+                void *mapping = mmap(nullptr, in_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, s_uring.m_ring_handle, in_offset);
+                return MAP_FAILED == mapping ? nullptr : mapping;
+            };
+            s_uring.m_sq_ring = map(s_uring.m_sq_ring_size, IORING_OFF_SQ_RING);
+            s_uring.m_cq_ring = single_mmap ? s_uring.m_sq_ring : map(s_uring.m_cq_ring_size, IORING_OFF_CQ_RING);
+            s_uring.m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            s_uring.m_sqes = static_cast<io_uring_sqe *>(map(s_uring.m_sqes_size, IORING_OFF_SQES));
+            if (nullptr == s_uring.m_sq_ring || nullptr == s_uring.m_cq_ring || nullptr == s_uring.m_sqes)
+            {
+                OMEGA_LOGE("Mapping the io_uring queues failed with %s", strerror(errno));
+                uring_close();
+                return eFAILED;
+            }
+            auto *sq_ring = static_cast<u8 *>(s_uring.m_sq_ring);
+            auto *cq_ring = static_cast<u8 *>(s_uring.m_cq_ring);
+            s_uring.m_sq_head = reinterpret_cast<u32 *>(sq_ring + params.sq_off.head);
+            s_uring.m_sq_tail = reinterpret_cast<u32 *>(sq_ring + params.sq_off.tail);
+            s_uring.m_sq_array = reinterpret_cast<u32 *>(sq_ring + params.sq_off.array);
+            s_uring.m_sq_mask = *reinterpret_cast<u32 *>(sq_ring + params.sq_off.ring_mask);
+            s_uring.m_sq_entries = params.sq_entries;
+            s_uring.m_cq_head = reinterpret_cast<u32 *>(cq_ring + params.cq_off.head);
+            s_uring.m_cq_tail = reinterpret_cast<u32 *>(cq_ring + params.cq_off.tail);
+            s_uring.m_cqes = reinterpret_cast<io_uring_cqe *>(cq_ring + params.cq_off.cqes);
+            s_uring.m_cq_mask = *reinterpret_cast<u32 *>(cq_ring + params.cq_off.ring_mask);
+            return eSUCCESS;
+        }
+
+        // Probed once per set_io_model(): io_uring may be compiled out of the kernel, disabled by sysctl or blocked by seccomp
+        __internal__ bool uring_supported()
+        {
+            io_uring_params params{};
+            const int ring_handle = static_cast<int>(syscall(__NR_io_uring_setup, 1, &params));
+            if (-1 == ring_handle)
+            {
+                return false;
+            }
+            // FAST_POLL keeps a posted tty read parked on the tty's wait queue instead of an io-wq worker,
+            // NODROP keeps completions when the CQ overflows
+            bool supported = (IORING_FEAT_FAST_POLL | IORING_FEAT_NODROP) == (params.features & (IORING_FEAT_FAST_POLL | IORING_FEAT_NODROP));
+            constexpr size_t probe_op_count = 256;
+            auto probe_storage = std::make_unique<u8[]>(sizeof(io_uring_probe) + probe_op_count * sizeof(io_uring_probe_op));
+            auto *probe = reinterpret_cast<io_uring_probe *>(probe_storage.get());
+            std::memset(probe, 0, sizeof(io_uring_probe) + probe_op_count * sizeof(io_uring_probe_op));
+            if (supported && 0 == syscall(__NR_io_uring_register, ring_handle, IORING_REGISTER_PROBE, probe, probe_op_count))
+            {
+                for (const u8 opcode : {IORING_OP_NOP, IORING_OP_READ, IORING_OP_WRITE, IORING_OP_POLL_ADD, IORING_OP_ASYNC_CANCEL})
+                {
+                    supported = supported && opcode <= probe->last_op && 0 != (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED);
+                }
+            }
+            else
+            {
+                supported = false;
+            }
+            close(ring_handle);
+            return supported;
+        }
+
+        __internal__ OmegaStatus uring_register(Handle in_handle, UARTPort &in_uart_port)
+        {
+            std::unique_lock lock{s_uring_mutex};
+            if (nullptr != s_uring.m_thread && !s_uring.m_running.load(std::memory_order_relaxed))
+            {
+                if (s_uring.m_exited)
+                {
+                    // the last stop() is about to join the loop and close the ring, a new one is set up once it is gone
+                    s_uring.m_changed.wait(lock, []
+                                           { return nullptr == s_uring.m_thread; });
+                }
+                else
+                {
+                    // still winding down: keep it instead
+                    s_uring.m_running.store(true, std::memory_order_release);
+                    s_uring.m_changed.notify_all();
+                }
+            }
+            if (-1 == s_uring.m_ring_handle)
+            {
+                if (eSUCCESS != uring_open())
+                {
+                    return eFAILED;
+                }
+                s_uring.m_running.store(true, std::memory_order_release);
+                s_uring.m_thread = new std::thread{uring_loop};
+            }
+            in_uart_port.m_registered_to_uring = true;
+            s_uring.m_registered_count++;
+            uring_post_read(in_handle, in_uart_port);
+            if (-1 != in_uart_port.m_rx_timer_handle)
+            {
+                uring_post_rx_timer(in_handle, in_uart_port);
+            }
+            uring_submit();
+            return eSUCCESS;
+        }
+
+        __internal__ void uring_unregister(Handle in_handle, UARTPort &in_uart_port)
+        {
+            std::unique_lock lock{s_uring_mutex};
+            in_uart_port.m_registered_to_uring = false;
+            const bool on_uring_thread = std::this_thread::get_id() == s_uring.m_thread->get_id();
+            if (!on_uring_thread)
+            {
+                // A completion for this handle may be in its callbacks. Those may start and stop other handles, so the
+                // wait gives up the lock
+                s_uring.m_dispatch_waiters++;
+                s_uring.m_changed.wait(lock, [in_handle]
+                                       { return in_handle != s_uring.m_dispatching; });
+                s_uring.m_dispatch_waiters--;
+            }
+            // Only cancelled now, as the callbacks that were running may have posted the next read
+            uring_post_cancel(URING_READ_EVENT | in_handle);
+            if (-1 != in_uart_port.m_rx_timer_handle)
+            {
+                uring_post_cancel(URING_RX_TIMER_EVENT | in_handle);
+            }
+            // A parked tty read is cancelled inline, so once this returns the kernel no longer touches the read buffer
+            uring_submit();
+            // The loop still walks the completion queue after a callback returns, so a ring emptied from inside a
+            // callback stays up idle and is picked up again by the next start()
+            if (0 < --s_uring.m_registered_count || on_uring_thread)
+            {
+                return;
+            }
+            s_uring.m_running.store(false, std::memory_order_release);
+            uring_queue(make_sqe(IORING_OP_NOP, -1, nullptr, 0, URING_WAKEUP_EVENT));
+            uring_submit();
+            // A callback still running on the loop may start a handle meanwhile, which keeps the ring up
+            auto *uring_thread = s_uring.m_thread;
+            s_uring.m_changed.wait(lock, [uring_thread]
+                                   { return uring_thread != s_uring.m_thread || s_uring.m_exited || s_uring.m_running.load(std::memory_order_relaxed); });
+            if (uring_thread != s_uring.m_thread || !s_uring.m_exited)
+            {
+                return;
+            }
+            s_uring.m_thread->join();
+            delete s_uring.m_thread;
+            s_uring.m_thread = nullptr;
+            s_uring.m_exited = false;
+            uring_close();
+            s_uring.m_changed.notify_all();
+        }
+
+        // in_requests only holds requests for handles registered to the ring
+        __internal__ void uring_write_batch(const std::vector<WriteRequest *> &in_requests, std::chrono::steady_clock::time_point in_deadline)
+        {
+            UringWriteBatch batch;
+            batch.m_writes.reserve(in_requests.size());
+            // keeps every target's tty open until the kernel is done with the batch
+            std::vector<SlotMap<UARTPort>::Pin> pinned_ports;
+            pinned_ports.reserve(in_requests.size());
+            std::unordered_map<Handle, size_t> last_write_for_handle;
+            std::vector<size_t> first_writes;
+            for (auto *request : in_requests)
+            {
+                if (0 == request->size)
+                {
+                    continue;
+                }
+                auto pinned = s_com_ports.pin(request->handle);
+                if (!pinned)
+                {
+                    request->response = {eFAILED, 0};
+                    continue;
+                }
+                const size_t index = batch.m_writes.size();
+                batch.m_writes.push_back({&batch, request, pinned.get(), URING_NO_NEXT_WRITE});
+                pinned_ports.push_back(std::move(pinned));
+                if (const auto [previous, inserted] = last_write_for_handle.try_emplace(request->handle, index); !inserted)
+                {
+                    batch.m_writes[previous->second].m_next = index;
+                    previous->second = index;
+                }
+                else
+                {
+                    first_writes.push_back(index);
+                }
+            }
+            if (batch.m_writes.empty())
+            {
+                return;
+            }
+            std::unique_lock lock{batch.m_mutex};
+            batch.m_remaining = batch.m_writes.size();
+            for (const auto index : first_writes)
+            {
+                uring_post_write(batch.m_writes[index]);
+            }
+            uring_submit();
+            if (!batch.m_completed.wait_until(lock, in_deadline, [&batch]
+                                              { return 0 == batch.m_remaining; }))
+            {
+                batch.m_cancelled = true;
+                for (auto &write : batch.m_writes)
+                {
+                    if (write.m_in_flight)
+                    {
+                        uring_post_cancel(URING_WRITE_EVENT | reinterpret_cast<u64>(&write));
+                    }
+                }
+                uring_submit();
+                // the kernel may still be writing from the caller's buffers until every request has completed
+                batch.m_completed.wait(lock, [&batch]
+                                       { return 0 == batch.m_remaining; });
+            }
+        }
+        /* END: IO_URING */
+#endif
+
+        OmegaStatus set_io_model(IOModel in_io_model)
+        {
+            bool any_started = false;
+            s_com_ports.for_each([&any_started](Handle, UARTPort &in_uart_port)
+                                 {
+                                     std::lock_guard lock{in_uart_port.m_control_mutex};
+                                     any_started = any_started || is_started(in_uart_port); });
+            if (any_started)
+            {
+                OMEGA_LOGE("IO model cannot be changed while a handle is started");
+                return eFAILED;
+            }
+            if (IOModel::eIO_URING == in_io_model)
+            {
+#if defined(CONFIG_OMEGA_UART_CONTROLLER_IO_URING)
+                const bool io_uring_available = uring_supported();
+#else
+                const bool io_uring_available = false;
+#endif
+                if (!io_uring_available)
+                {
+                    OMEGA_LOGW("io_uring is not available, falling back to the epoll reactor");
+                    in_io_model = IOModel::eREACTOR;
+                }
+            }
+            s_io_model.store(in_io_model, std::memory_order_release);
+            return eSUCCESS;
+        }
+
+        IOModel get_io_model()
+        {
+            return s_io_model.load(std::memory_order_acquire);
+        }
+
+        __internal__ OmegaStatus set_custom_baudrate(int in_serial_handle, Baudrate in_baudrate)
+        {
+            struct termios2 termios_config{};
+            if (-1 == ioctl(in_serial_handle, TCGETS2, &termios_config))
+            {
+                OMEGA_LOGE("TCGETS2 failed with %s", strerror(errno));
+                return eFAILED;
+            }
+            termios_config.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+            termios_config.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+            termios_config.c_ispeed = in_baudrate;
+            termios_config.c_ospeed = in_baudrate;
+            if (-1 == ioctl(in_serial_handle, TCSETS2, &termios_config))
+            {
+                OMEGA_LOGE("TCSETS2 failed with %s", strerror(errno));
+                return eFAILED;
+            }
+            return eSUCCESS;
+        }
+
+        // The rate the driver actually programmed, which may differ from the requested one after divisor rounding
+        __internal__ Baudrate get_actual_baudrate(int in_serial_handle)
+        {
+            struct termios2 termios_config{};
+            if (-1 == ioctl(in_serial_handle, TCGETS2, &termios_config))
+            {
+                OMEGA_LOGE("TCGETS2 failed with %s", strerror(errno));
+                return 0;
+            }
+            return termios_config.c_ospeed;
+        }
+
+        /* START: PORT INDEX */
+        struct PortIndexCallback
+        {
+            u64 m_id;
+            std::function<void(PortEvent, const EnumeratedUARTPort &)> m_callback;
+            std::atomic<bool> m_active{true};
+        };
+
+        struct PortIndex
+        {
+            // Guards the patterns, the ports and the pending events
+            std::mutex m_mutex;
+            std::vector<std::string> m_patterns{"ttyS", "ttyUSB", "ttyACM"};
+            std::vector<EnumeratedUARTPort> m_ports;
+            std::vector<std::pair<PortEvent, EnumeratedUARTPort>> m_pending_events;
+            // "vid:pid" and "vid:pid:serial" to positions in m_ports, rebuilt on the first lookup after m_ports changed
+            std::unordered_map<std::string, std::vector<size_t>> m_by_identity;
+            bool m_identity_stale{true};
+            bool m_open_attempted{false};
+            int m_epoll_handle{-1};
+            int m_uevent_handle{-1};
+            int m_inotify_handle{-1};
+            int m_wakeup_handle{-1};
+            std::thread *m_thread{nullptr};
+            std::atomic<bool> m_running{false};
+
+            std::mutex m_callback_mutex;
+            std::vector<std::shared_ptr<PortIndexCallback>> m_callbacks;
+            u64 m_next_callback_id{1};
+            // Held by the monitor thread for as long as it is calling back
+            std::mutex m_dispatch_mutex;
+
+            ~PortIndex();
+        };
+        __internal__ PortIndex s_port_index;
+        __internal__ thread_local bool t_on_port_monitor{false};
+
+        // Tags for the monitor's epoll events
+        __internal__ constexpr u64 PORT_INDEX_WAKEUP_EVENT{0};
+        __internal__ constexpr u64 PORT_INDEX_UEVENT_EVENT{1};
+        __internal__ constexpr u64 PORT_INDEX_INOTIFY_EVENT{2};
+
+        __internal__ bool matches_port_pattern(const std::vector<std::string> &in_patterns, const char *in_name)
+        {
+            for (const auto &pattern : in_patterns)
+            {
+                if (0 == strncmp(in_name, pattern.c_str(), pattern.size()))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        __internal__ std::vector<std::string> scan_dev(const std::vector<std::string> &in_patterns)
+        {
+            std::vector<std::string> dev_names;
+            DIR *dir = opendir("/dev");
+            if (nullptr == dir)
+            {
+                OMEGA_LOGE("Unable to open /dev");
+                return dev_names;
+            }
+            while (const struct dirent *entry = readdir(dir))
+            {
+                if (matches_port_pattern(in_patterns, entry->d_name))
+                {
+                    dev_names.emplace_back(entry->d_name);
+                }
+            }
+            closedir(dir);
+            return dev_names;
+        }
+
+        // Reads a sysfs attribute without its trailing newline
+        __internal__ bool read_sysfs_attribute(const std::string &in_path, char *out_value, size_t in_size)
+        {
+            const int attribute_handle = open(in_path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (-1 == attribute_handle)
+            {
+                return false;
+            }
+            const ssize_t read_bytes = ::read(attribute_handle, out_value, in_size - 1);
+            close(attribute_handle);
+            if (0 >= read_bytes)
+            {
+                return false;
+            }
+            out_value[read_bytes] = '\0';
+            out_value[strcspn(out_value, "\n")] = '\0';
+            return true;
+        }
+
+        // /dev/serial/by-id link targets, resolved to their /dev node, to the link
+        typedef std::unordered_map<std::string, std::string> ByIdLinks;
+
+        __internal__ ByIdLinks read_by_id_links()
+        {
+            ByIdLinks links;
+            DIR *dir = opendir("/dev/serial/by-id");
+            if (nullptr == dir)
+            {
+                return links;
+            }
+            while (const struct dirent *entry = readdir(dir))
+            {
+                if ('.' == entry->d_name[0])
+                {
+                    continue;
+                }
+                const std::string link = std::string{"/dev/serial/by-id/"} + entry->d_name;
+                if (char *target = realpath(link.c_str(), nullptr))
+                {
+                    links.emplace(target, link);
+                    free(target);
+                }
+            }
+            closedir(dir);
+            return links;
+        }
+
+        // Fills in what sysfs knows about /dev/in_dev_name. USB serial adapters hang off an interface directory holding
+        // bInterfaceNumber, below the device directory holding idVendor and the descriptor strings
+        __internal__ EnumeratedUARTPort make_enumerated_port(const char *in_dev_name, const ByIdLinks &in_by_id_links)
+        {
+            EnumeratedUARTPort uart_port{};
+            UNUSED(snprintf(uart_port.m_port_name, sizeof(uart_port.m_port_name), "/dev/%s", in_dev_name));
+            if (const auto link = in_by_id_links.find(uart_port.m_port_name); in_by_id_links.end() != link)
+            {
+                UNUSED(snprintf(uart_port.m_by_id_path, sizeof(uart_port.m_by_id_path), "%s", link->second.c_str()));
+            }
+            const std::string class_path = std::string{"/sys/class/tty/"} + in_dev_name;
+            char *device_path = realpath((class_path + "/device").c_str(), nullptr);
+            if (nullptr == device_path)
+            {
+                UNUSED(snprintf(uart_port.m_friendly_portname, sizeof(uart_port.m_friendly_portname), "%s", in_dev_name));
+                return uart_port;
+            }
+            char attribute[USB_STRING_SIZE + 1]{0};
+            std::string driver;
+            for (std::string path = device_path; path.size() > sizeof("/sys/devices") - 1; path.erase(path.rfind('/')))
+            {
+                // Skips the serial core's own port and ctrl devices for the one that drives the hardware
+                if (char *driver_path = realpath((path + "/driver").c_str(), nullptr); nullptr != driver_path)
+                {
+                    if (driver.empty() && nullptr == strstr(driver_path, "/bus/serial-base/"))
+                    {
+                        driver = strrchr(driver_path, '/') + 1;
+                    }
+                    free(driver_path);
+                }
+                if (-1 == uart_port.m_interface_number && read_sysfs_attribute(path + "/bInterfaceNumber", attribute, sizeof(attribute)))
+                {
+                    uart_port.m_interface_number = strtol(attribute, nullptr, 16);
+                }
+                if (read_sysfs_attribute(path + "/idVendor", attribute, sizeof(attribute)))
+                {
+                    uart_port.m_vid = strtoul(attribute, nullptr, 16);
+                    if (read_sysfs_attribute(path + "/idProduct", attribute, sizeof(attribute)))
+                    {
+                        uart_port.m_pid = strtoul(attribute, nullptr, 16);
+                    }
+                    UNUSED(read_sysfs_attribute(path + "/serial", uart_port.m_serial_number, sizeof(uart_port.m_serial_number)));
+                    UNUSED(read_sysfs_attribute(path + "/manufacturer", uart_port.m_manufacturer, sizeof(uart_port.m_manufacturer)));
+                    UNUSED(read_sysfs_attribute(path + "/product", uart_port.m_product, sizeof(uart_port.m_product)));
+                    break;
+                }
+            }
+            free(device_path);
+
+            if (0 != uart_port.m_product[0])
+            {
+                UNUSED(snprintf(uart_port.m_friendly_portname, sizeof(uart_port.m_friendly_portname), "%s", uart_port.m_product));
+            }
+            else if (0 != uart_port.m_vid)
+            {
+                UNUSED(snprintf(uart_port.m_friendly_portname, sizeof(uart_port.m_friendly_portname), "USB serial %04x:%04x", uart_port.m_vid, uart_port.m_pid));
+            }
+            else if (!driver.empty())
+            {
+                UNUSED(snprintf(uart_port.m_friendly_portname, sizeof(uart_port.m_friendly_portname), "%s (%s)", in_dev_name, driver.c_str()));
+            }
+            else
+            {
+                UNUSED(snprintf(uart_port.m_friendly_portname, sizeof(uart_port.m_friendly_portname), "%s", in_dev_name));
+            }
+            return uart_port;
+        }
+
+        __internal__ auto find_indexed_port(const char *in_port_name)
+        {
+            return std::find_if(s_port_index.m_ports.begin(), s_port_index.m_ports.end(), [in_port_name](const EnumeratedUARTPort &in_port)
+                                { return 0 == strcmp(in_port.m_port_name, in_port_name); });
+        }
+
+        // The port index helpers below expect s_port_index.m_mutex to be held. A null in_by_id_links reads the links afresh
+        __internal__ void port_index_insert(const char *in_dev_name, const ByIdLinks *in_by_id_links)
+        {
+            if (!matches_port_pattern(s_port_index.m_patterns, in_dev_name))
+            {
+                return;
+            }
+            char port_name[PORT_NAME_SIZE + 1]{0};
+            UNUSED(snprintf(port_name, sizeof(port_name), "/dev/%s", in_dev_name));
+            if (s_port_index.m_ports.end() != find_indexed_port(port_name))
+            {
+                return;
+            }
+            s_port_index.m_ports.push_back(make_enumerated_port(in_dev_name, nullptr != in_by_id_links ? *in_by_id_links : read_by_id_links()));
+            s_port_index.m_identity_stale = true;
+            s_port_index.m_pending_events.emplace_back(PortEvent::eADDED, s_port_index.m_ports.back());
+        }
+
+        __internal__ void port_index_erase(const char *in_port_name)
+        {
+            if (const auto found = find_indexed_port(in_port_name); s_port_index.m_ports.end() != found)
+            {
+                s_port_index.m_pending_events.emplace_back(PortEvent::eREMOVED, *found);
+                s_port_index.m_ports.erase(found);
+                s_port_index.m_identity_stale = true;
+            }
+        }
+
+        // Brings the index in line with /dev after the patterns changed or an event queue overflowed
+        __internal__ void port_index_rescan()
+        {
+            const auto scanned = scan_dev(s_port_index.m_patterns);
+            for (size_t idx = s_port_index.m_ports.size(); 0 < idx--;)
+            {
+                const char *dev_name = s_port_index.m_ports[idx].m_port_name + sizeof("/dev/") - 1;
+                if (scanned.end() == std::find(scanned.begin(), scanned.end(), dev_name))
+                {
+                    s_port_index.m_pending_events.emplace_back(PortEvent::eREMOVED, s_port_index.m_ports[idx]);
+                    s_port_index.m_ports.erase(s_port_index.m_ports.begin() + idx);
+                    s_port_index.m_identity_stale = true;
+                }
+            }
+            const ByIdLinks by_id_links = read_by_id_links();
+            for (const auto &dev_name : scanned)
+            {
+                port_index_insert(dev_name.c_str(), &by_id_links);
+            }
+        }
+
+        // udev rebroadcasts every uevent it finished on multicast group 2, after a header of its own
+        struct UdevMessageHeader
+        {
+            char prefix[8]; // "libudev"
+            u32 magic;      // 0xfeedcafe, big endian
+            u32 header_size;
+            u32 properties_offset;
+            u32 properties_size;
+        };
+        __internal__ constexpr u32 UDEV_MESSAGE_MAGIC{0xfeedcafe};
+
+        // Uevent properties are NUL separated KEY=VALUE pairs. DEVNAME is relative to /dev from the kernel and absolute from udev
+        __internal__ void on_uevent(const char *in_properties, size_t in_size, bool in_from_udev)
+        {
+            const char *action = nullptr;
+            const char *dev_name = nullptr;
+            const char *dev_links = nullptr;
+            bool tty = false;
+            for (const char *field = in_properties; field < in_properties + in_size; field += strlen(field) + 1)
+            {
+                if (0 == strncmp(field, "ACTION=", 7))
+                {
+                    action = field + 7;
+                }
+                else if (0 == strncmp(field, "DEVNAME=", 8))
+                {
+                    dev_name = field + 8;
+                }
+                else if (0 == strncmp(field, "DEVLINKS=", 9))
+                {
+                    dev_links = field + 9;
+                }
+                else if (0 == strcmp(field, "SUBSYSTEM=tty"))
+                {
+                    tty = true;
+                }
+            }
+            if (!tty || nullptr == action || nullptr == dev_name)
+            {
+                return;
+            }
+            if (0 == strncmp(dev_name, "/dev/", 5))
+            {
+                dev_name += 5;
+            }
+            char port_name[PORT_NAME_SIZE + 1]{0};
+            UNUSED(snprintf(port_name, sizeof(port_name), "/dev/%s", dev_name));
+            if (0 == strcmp(action, "remove"))
+            {
+                port_index_erase(port_name);
+                return;
+            }
+            if (0 != strcmp(action, "add") && !(in_from_udev && 0 == strcmp(action, "change")))
+            {
+                return;
+            }
+            // The kernel's add comes before udev made the by-id link; udev's own add carries it in DEVLINKS
+            const ByIdLinks no_links;
+            port_index_insert(dev_name, &no_links);
+            const auto found = find_indexed_port(port_name);
+            if (nullptr == dev_links || s_port_index.m_ports.end() == found)
+            {
+                return;
+            }
+            if (const char *by_id = strstr(dev_links, "/dev/serial/by-id/"))
+            {
+                UNUSED(snprintf(found->m_by_id_path, sizeof(found->m_by_id_path), "%.*s", static_cast<int>(strcspn(by_id, " ")), by_id));
+            }
+        }
+
+        __internal__ void drain_uevents()
+        {
+            char message[8192];
+            while (true)
+            {
+                sockaddr_nl sender{};
+                socklen_t sender_size = sizeof(sender);
+                const ssize_t received = recvfrom(s_port_index.m_uevent_handle, message, sizeof(message) - 1, MSG_DONTWAIT, reinterpret_cast<sockaddr *>(&sender), &sender_size);
+                if (-1 == received)
+                {
+                    if (ENOBUFS == errno)
+                    {
+                        std::lock_guard lock{s_port_index.m_mutex};
+                        port_index_rescan();
+                        continue;
+                    }
+                    return;
+                }
+                message[received] = '\0';
+                // Sending to either group takes CAP_NET_ADMIN, so the kernel (port 0) and udev are the only senders
+                UdevMessageHeader header{};
+                if (sizeof(header) <= static_cast<size_t>(received) && 0 == memcmp(message, "libudev", 8))
+                {
+                    memcpy(&header, message, sizeof(header));
+                    if (htonl(UDEV_MESSAGE_MAGIC) != header.magic || header.properties_offset + header.properties_size > static_cast<size_t>(received))
+                    {
+                        continue;
+                    }
+                    std::lock_guard lock{s_port_index.m_mutex};
+                    on_uevent(message + header.properties_offset, header.properties_size, true);
+                }
+                else if (0 == sender.nl_pid)
+                {
+                    // The kernel's "action@devpath" summary line comes first
+                    const size_t summary_size = strlen(message) + 1;
+                    std::lock_guard lock{s_port_index.m_mutex};
+                    on_uevent(message + summary_size, received - std::min<size_t>(summary_size, received), false);
+                }
+            }
+        }
+
+        __internal__ void drain_inotify()
+        {
+            alignas(inotify_event) char events[4096];
+            ssize_t received = 0;
+            while (0 < (received = ::read(s_port_index.m_inotify_handle, events, sizeof(events))))
+            {
+                std::lock_guard lock{s_port_index.m_mutex};
+                for (const char *cursor = events; cursor < events + received;)
+                {
+                    const auto *event = reinterpret_cast<const inotify_event *>(cursor);
+                    cursor += sizeof(inotify_event) + event->len;
+                    if (0 != (event->mask & IN_Q_OVERFLOW))
+                    {
+                        port_index_rescan();
+                    }
+                    else if (0 != (event->mask & (IN_CREATE | IN_MOVED_TO)) && 0 != event->len)
+                    {
+                        port_index_insert(event->name, nullptr);
+                    }
+                    else if (0 != (event->mask & (IN_DELETE | IN_MOVED_FROM)) && 0 != event->len)
+                    {
+                        char port_name[PORT_NAME_SIZE + 1]{0};
+                        UNUSED(snprintf(port_name, sizeof(port_name), "/dev/%s", event->name));
+                        port_index_erase(port_name);
+                    }
+                }
+            }
+        }
+
+        __internal__ void dispatch_port_events()
+        {
+            std::vector<std::pair<PortEvent, EnumeratedUARTPort>> events;
+            {
+                std::lock_guard lock{s_port_index.m_mutex};
+                events.swap(s_port_index.m_pending_events);
+            }
+            if (events.empty())
+            {
+                return;
+            }
+            std::lock_guard dispatch_lock{s_port_index.m_dispatch_mutex};
+            std::vector<std::shared_ptr<PortIndexCallback>> callbacks;
+            {
+                std::lock_guard lock{s_port_index.m_callback_mutex};
+                callbacks = s_port_index.m_callbacks;
+            }
+            for (const auto &[event, uart_port] : events)
+            {
+                for (const auto &callback : callbacks)
+                {
+                    if (callback->m_active.load(std::memory_order_acquire))
+                    {
+                        callback->m_callback(event, uart_port);
+                    }
+                }
+            }
+        }
+
+        __internal__ void port_index_loop()
+        {
+            t_on_port_monitor = true;
+            epoll_event events[3]{};
+            while (s_port_index.m_running.load(std::memory_order_acquire))
+            {
+                const int event_count = epoll_wait(s_port_index.m_epoll_handle, events, 3, -1);
+                if (-1 == event_count)
+                {
+                    if (EINTR == errno)
+                    {
+                        continue;
+                    }
+                    OMEGA_LOGE("epoll_wait failed with %s", strerror(errno));
+                    return;
+                }
+                for (int idx = 0; idx < event_count; ++idx)
+                {
+                    switch (events[idx].data.u64)
+                    {
+                    case PORT_INDEX_UEVENT_EVENT:
+                        drain_uevents();
+                        break;
+                    case PORT_INDEX_INOTIFY_EVENT:
+                        drain_inotify();
+                        break;
+                    default:
+                        eventfd_t value{};
+                        UNUSED(eventfd_read(s_port_index.m_wakeup_handle, &value));
+                        break;
+                    }
+                }
+                dispatch_port_events();
+            }
+        }
+
+        __internal__ void port_index_wake()
+        {
+            if (-1 != s_port_index.m_wakeup_handle)
+            {
+                UNUSED(eventfd_write(s_port_index.m_wakeup_handle, 1));
+            }
+        }
+
+        __internal__ void port_index_close()
+        {
+            for (int *handle : {&s_port_index.m_uevent_handle, &s_port_index.m_inotify_handle, &s_port_index.m_wakeup_handle, &s_port_index.m_epoll_handle})
+            {
+                if (-1 != *handle)
+                {
+                    close(*handle);
+                    *handle = -1;
+                }
+            }
+        }
+
+        // Expects s_port_index.m_mutex to be held. Either event source is enough: uevents do not reach containers outside
+        // the initial network namespace, and inotify misses nodes in a /dev that is not the host's devtmpfs
+        __internal__ bool port_index_open()
+        {
+            if (nullptr != s_port_index.m_thread || s_port_index.m_open_attempted)
+            {
+                return nullptr != s_port_index.m_thread;
+            }
+            s_port_index.m_open_attempted = true;
+            if (s_port_index.m_epoll_handle = epoll_create1(EPOLL_CLOEXEC); -1 == s_port_index.m_epoll_handle)
+            {
+                OMEGA_LOGE("epoll_create1 failed with %s", strerror(errno));
+                return false;
+            }
+            if (s_port_index.m_wakeup_handle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC); -1 == s_port_index.m_wakeup_handle)
+            {
+                OMEGA_LOGE("eventfd failed with %s", strerror(errno));
+                port_index_close();
+                return false;
+            }
+            epoll_event wakeup_event{.events = EPOLLIN, .data = {.u64 = PORT_INDEX_WAKEUP_EVENT}};
+            UNUSED(epoll_ctl(s_port_index.m_epoll_handle, EPOLL_CTL_ADD, s_port_index.m_wakeup_handle, &wakeup_event));
+
+            if (s_port_index.m_uevent_handle = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT); -1 != s_port_index.m_uevent_handle)
+            {
+                // Kernel uevents on group 1, udev's processed ones on group 2
+                const sockaddr_nl address{.nl_family = AF_NETLINK, .nl_pad = 0, .nl_pid = 0, .nl_groups = 1 | 2};
+                epoll_event uevent_event{.events = EPOLLIN, .data = {.u64 = PORT_INDEX_UEVENT_EVENT}};
+                if (-1 == bind(s_port_index.m_uevent_handle, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) ||
+                    -1 == epoll_ctl(s_port_index.m_epoll_handle, EPOLL_CTL_ADD, s_port_index.m_uevent_handle, &uevent_event))
+                {
+                    OMEGA_LOGW("Kernel uevents are unavailable: %s", strerror(errno));
+                    close(s_port_index.m_uevent_handle);
+                    s_port_index.m_uevent_handle = -1;
+                }
+            }
+            if (s_port_index.m_inotify_handle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC); -1 != s_port_index.m_inotify_handle)
+            {
+                epoll_event inotify_event{.events = EPOLLIN, .data = {.u64 = PORT_INDEX_INOTIFY_EVENT}};
+                if (-1 == inotify_add_watch(s_port_index.m_inotify_handle, "/dev", IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR) ||
+                    -1 == epoll_ctl(s_port_index.m_epoll_handle, EPOLL_CTL_ADD, s_port_index.m_inotify_handle, &inotify_event))
+                {
+                    OMEGA_LOGW("Watching /dev is unavailable: %s", strerror(errno));
+                    close(s_port_index.m_inotify_handle);
+                    s_port_index.m_inotify_handle = -1;
+                }
+            }
+            if (-1 == s_port_index.m_uevent_handle && -1 == s_port_index.m_inotify_handle)
+            {
+                OMEGA_LOGW("No hotplug source available, ports are enumerated by scanning /dev");
+                port_index_close();
+                return false;
+            }
+            // Both sources are live before the first scan, so nothing plugged in meanwhile is lost
+            port_index_rescan();
+            s_port_index.m_pending_events.clear();
+            s_port_index.m_running.store(true, std::memory_order_release);
+            s_port_index.m_thread = new std::thread{port_index_loop};
+            return true;
+        }
+
+        PortIndex::~PortIndex()
+        {
+            if (nullptr == m_thread)
+            {
+                return;
+            }
+            m_running.store(false, std::memory_order_release);
+            port_index_wake();
+            m_thread->join();
+            delete m_thread;
+            port_index_close();
+        }
+        /* END: PORT INDEX */
+
+        // Expects s_port_index.m_mutex to be held. Without a monitor the index is only as fresh as the last call
+        __internal__ void port_index_refresh()
+        {
+            if (!port_index_open())
+            {
+                port_index_rescan();
+                s_port_index.m_pending_events.clear();
+            }
+        }
+
+        __internal__ std::string identity_key(u16 in_vid, u16 in_pid, const char *in_serial_number)
+        {
+            char key[sizeof("vvvv:pppp:") + USB_STRING_SIZE]{0};
+            if (nullptr == in_serial_number)
+            {
+                UNUSED(snprintf(key, sizeof(key), "%04x:%04x", in_vid, in_pid));
+            }
+            else
+            {
+                UNUSED(snprintf(key, sizeof(key), "%04x:%04x:%s", in_vid, in_pid, in_serial_number));
+            }
+            return key;
+        }
+
+        std::vector<EnumeratedUARTPort> get_available_ports()
+        {
+            std::lock_guard lock{s_port_index.m_mutex};
+            port_index_refresh();
+            return s_port_index.m_ports;
+        }
+
+        OmegaStatus find_port(const PortIdentity &in_identity, EnumeratedUARTPort &out_port)
+        {
+            std::lock_guard lock{s_port_index.m_mutex};
+            port_index_refresh();
+            if (s_port_index.m_identity_stale)
+            {
+                s_port_index.m_by_identity.clear();
+                for (size_t idx = 0; idx < s_port_index.m_ports.size(); ++idx)
+                {
+                    const auto &uart_port = s_port_index.m_ports[idx];
+                    if (0 != uart_port.m_vid)
+                    {
+                        s_port_index.m_by_identity[identity_key(uart_port.m_vid, uart_port.m_pid, nullptr)].push_back(idx);
+                        s_port_index.m_by_identity[identity_key(uart_port.m_vid, uart_port.m_pid, uart_port.m_serial_number)].push_back(idx);
+                    }
+                }
+                s_port_index.m_identity_stale = false;
+            }
+            const auto found = s_port_index.m_by_identity.find(identity_key(in_identity.vid, in_identity.pid, in_identity.serial_number));
+            if (s_port_index.m_by_identity.end() == found)
+            {
+                OMEGA_LOGE("No port matches %04x:%04x", in_identity.vid, in_identity.pid);
+                return eFAILED;
+            }
+            const EnumeratedUARTPort *match = nullptr;
+            for (const size_t idx : found->second)
+            {
+                const auto &uart_port = s_port_index.m_ports[idx];
+                if (-1 != in_identity.interface_number && in_identity.interface_number != uart_port.m_interface_number)
+                {
+                    continue;
+                }
+                if (nullptr != match)
+                {
+                    OMEGA_LOGE("More than one port matches %04x:%04x, narrow it down by serial number or interface", in_identity.vid, in_identity.pid);
+                    return eFAILED;
+                }
+                match = &uart_port;
+            }
+            if (nullptr == match)
+            {
+                OMEGA_LOGE("No port matches %04x:%04x on interface %d", in_identity.vid, in_identity.pid, in_identity.interface_number);
+                return eFAILED;
+            }
+            out_port = *match;
+            return eSUCCESS;
+        }
+
+        u64 add_on_port_event_callback(std::function<void(PortEvent, const EnumeratedUARTPort &)> in_callback)
+        {
+            if (nullptr == in_callback)
+            {
+                OMEGA_LOGE("Invalid callback");
+                return 0;
+            }
+            {
+                std::lock_guard lock{s_port_index.m_mutex};
+                if (!port_index_open())
+                {
+                    OMEGA_LOGE("Port hotplug monitoring is unavailable");
+                    return 0;
+                }
+            }
+            std::lock_guard lock{s_port_index.m_callback_mutex};
+            auto callback = std::make_shared<PortIndexCallback>();
+            callback->m_id = s_port_index.m_next_callback_id++;
+            callback->m_callback = std::move(in_callback);
+            s_port_index.m_callbacks.push_back(callback);
+            return callback->m_id;
+        }
+
+        OmegaStatus remove_on_port_event_callback(u64 in_callback_id)
+        {
+            {
+                std::lock_guard lock{s_port_index.m_callback_mutex};
+                const auto found = std::find_if(s_port_index.m_callbacks.begin(), s_port_index.m_callbacks.end(), [in_callback_id](const auto &in_callback)
+                                                { return in_callback_id == in_callback->m_id; });
+                if (s_port_index.m_callbacks.end() == found)
+                {
+                    OMEGA_LOGE("Unknown port event callback");
+                    return eFAILED;
+                }
+                (*found)->m_active.store(false, std::memory_order_release);
+                s_port_index.m_callbacks.erase(found);
+            }
+            if (!t_on_port_monitor)
+            {
+                // The monitor may be calling it right now; wait until it is done
+                std::lock_guard dispatch_lock{s_port_index.m_dispatch_mutex};
+            }
+            return eSUCCESS;
+        }
+
+        OmegaStatus add_port_pattern(const char *in_prefix)
+        {
+            if (nullptr == in_prefix || 0 == std::strlen(in_prefix))
+            {
+                OMEGA_LOGE("Invalid port pattern");
+                return eFAILED;
+            }
+            std::lock_guard lock{s_port_index.m_mutex};
+            if (s_port_index.m_patterns.end() != std::find(s_port_index.m_patterns.begin(), s_port_index.m_patterns.end(), in_prefix))
+            {
+                return eSUCCESS;
+            }
+            s_port_index.m_patterns.emplace_back(in_prefix);
+            if (nullptr != s_port_index.m_thread)
+            {
+                port_index_rescan();
+                port_index_wake();
+            }
+            return eSUCCESS;
+        }
+
+        OmegaStatus remove_port_pattern(const char *in_prefix)
+        {
+            if (nullptr == in_prefix)
+            {
+                OMEGA_LOGE("Invalid port pattern");
+                return eFAILED;
+            }
+            std::lock_guard lock{s_port_index.m_mutex};
+            const auto found = std::find(s_port_index.m_patterns.begin(), s_port_index.m_patterns.end(), in_prefix);
+            if (s_port_index.m_patterns.end() == found)
+            {
+                OMEGA_LOGE("Unknown port pattern %s", in_prefix);
+                return eFAILED;
+            }
+            s_port_index.m_patterns.erase(found);
+            if (nullptr != s_port_index.m_thread)
+            {
+                port_index_rescan();
+                port_index_wake();
+            }
+            return eSUCCESS;
+        }
+
+        Handle init(const PortIdentity &in_identity, Baudrate in_baudrate, DataBits in_databits, Parity in_parity, StopBits in_stopbits)
+        {
+            EnumeratedUARTPort uart_port{};
+            if (eSUCCESS != find_port(in_identity, uart_port))
+            {
+                return 0;
+            }
+            return init(uart_port.m_port_name, in_baudrate, in_databits, in_parity, in_stopbits);
+        }
+
+        Handle init(const char *in_port, Baudrate in_baudrate, DataBits in_databits, Parity in_parity, StopBits in_stopbits)
+        {
+            if (nullptr == in_port || 0 == std::strlen(in_port))
+            {
+                OMEGA_LOGE("Invalid serial port path");
+                return 0;
+            }
+
+            int termios_baudrate_index = -1;
+            for (size_t idx = 0; idx < TERMIOS_BAUDRATE_COUNT; ++idx)
+            {
+                if (in_baudrate == termios_baudrates[idx].m_user_baurdare)
+                {
+                    termios_baudrate_index = idx;
+                    break;
+                }
+            }
+            if (0 == in_baudrate)
+            {
+                OMEGA_LOGE("Invalid baudrate");
+                return 0;
+            }
+            // Rates missing from the table are programmed through termios2/BOTHER once the rest of the line settings are applied
+            const bool custom_baudrate = -1 == termios_baudrate_index;
+            const speed_t termios_baudrate = custom_baudrate ? B38400 : termios_baudrates[termios_baudrate_index].m_termios_baudrate;
+
+            int serial_handle = 0;
+            if (serial_handle = open(in_port, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC); -1 == serial_handle)
+            {
+                OMEGA_LOGE("Opening serial port failed with %s", strerror(errno));
+                return 0;
+            }
+
+            struct termios termios_config{};
+            if (tcgetattr(serial_handle, &termios_config) != 0)
+            {
+                OMEGA_LOGE("tcgetattr failed with %s", strerror(errno));
+                close(serial_handle);
+                return 0;
+            }
+            if (const auto status = cfsetospeed(&termios_config, termios_baudrate); -1 == status)
+            {
+                OMEGA_LOGE("cfsetospeed failed for %d", in_baudrate);
+                close(serial_handle);
+                return 0;
+            }
+            if (const auto status = cfsetispeed(&termios_config, termios_baudrate); -1 == status)
+            {
+                OMEGA_LOGE("cfsetispeed failed for %d", in_baudrate);
+                close(serial_handle);
+                return 0;
+            }
+
+            termios_config.c_cflag &= ~CSIZE;
+            switch (in_databits)
+            {
+            case DataBits::eDATA_BITS_5:
+            {
+                termios_config.c_cflag |= CS5;
+                break;
+            }
+            case DataBits::eDATA_BITS_6:
+            {
+                termios_config.c_cflag |= CS6;
+                break;
+            }
+            case DataBits::eDATA_BITS_7:
+            {
+                termios_config.c_cflag |= CS7;
+                break;
+            }
+            case DataBits::eDATA_BITS_8:
+            {
+                termios_config.c_cflag |= CS8;
+                break;
+            }
+            }
+            switch (in_parity)
+            {
+            case Parity::ePARITY_DISABLE:
+            {
+                termios_config.c_cflag &= ~PARENB;
+                break;
+            }
+            case Parity::ePARITY_ODD:
+            {
+                termios_config.c_cflag |= PARENB;
+                termios_config.c_cflag &= ~PARODD;
+                break;
+            }
+            case Parity::ePARITY_EVEN:
+            {
+                termios_config.c_cflag |= PARENB;
+                termios_config.c_cflag |= PARODD;
+                break;
+            }
+            }
+
+            switch (in_stopbits)
+            {
+            case StopBits::eSTOP_BITS_1:
+            {
+                termios_config.c_cflag &= ~CSTOPB;
+                break;
+            }
+            case StopBits::eSTOP_BITS_1_5:
+            {
+                // UARTs send 1.5 stop bits for CSTOPB with 5 data bits, termios has no other way to ask for them
+                if (DataBits::eDATA_BITS_5 != in_databits)
+                {
+                    OMEGA_LOGE("1.5 stop bits need 5 data bits");
+                    close(serial_handle);
+                    return 0;
+                }
+                termios_config.c_cflag |= CSTOPB;
+                break;
+            }
+            case StopBits::eSTOP_BITS_2:
+            {
+                termios_config.c_cflag |= CSTOPB;
+                break;
+            }
+            }
+            // Raw input/output (no canonical mode, no echo, no signal chars)
+            termios_config.c_lflag = 0;
+            termios_config.c_oflag = 0;
+            termios_config.c_iflag &= ~(IXON | IXOFF | IXANY); // Disable software flow control
+
+            // No blocking on read, unless at least 1 byte available
+            termios_config.c_cc[VMIN] = 1;
+            termios_config.c_cc[VTIME] = 0;
+
+            if (tcsetattr(serial_handle, TCSANOW, &termios_config) != 0)
+            {
+                OMEGA_LOGE("tcsetattr failed with %s", strerror(errno));
+                close(serial_handle);
+                return 0;
+            }
+            if (custom_baudrate && eSUCCESS != set_custom_baudrate(serial_handle, in_baudrate))
+            {
+                OMEGA_LOGE("Baudrate %u is not supported by %s", in_baudrate, in_port);
+                close(serial_handle);
+                return 0;
+            }
+
+            tcflush(serial_handle, TCIOFLUSH);
+
+            const int closing_handle = eventfd(0, EFD_CLOEXEC);
+            if (-1 == closing_handle)
+            {
+                OMEGA_LOGE("eventfd failed with %s", strerror(errno));
+                close(serial_handle);
+                return 0;
+            }
+            const Handle user_serial_handle = s_com_ports.emplace(serial_handle, in_port, in_baudrate, in_databits, in_stopbits, in_parity, closing_handle);
+            if (INVALID_UART_HANDLE == user_serial_handle)
+            {
+                OMEGA_LOGE("No free handle left for %s", in_port);
+                close(closing_handle);
+                close(serial_handle);
+                return 0;
+            }
+            return user_serial_handle;
+        }
+
+        enum class WaitResult
+        {
+            eREADY,
+            eTIMED_OUT,
+            eCLOSED,
+        };
+
+        // Waits until in_events is signalled on the port's tty, in_deadline passes or deinit() is called on the port
+        __internal__ WaitResult wait_for(const UARTPort &in_uart_port, short in_events, std::chrono::steady_clock::time_point in_deadline)
+        {
+            for (;;)
+            {
+                const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(in_deadline - std::chrono::steady_clock::now()).count();
+                if (0 >= remaining)
+                {
+                    return WaitResult::eTIMED_OUT;
+                }
+                pollfd poll_fds[2]{
+                    {.fd = in_uart_port.m_handle, .events = in_events, .revents = 0},
+                    {.fd = in_uart_port.m_closing_handle, .events = POLLIN, .revents = 0},
+                };
+                if (const int ready = poll(poll_fds, 2, static_cast<int>(std::min<i64>(remaining, INT_MAX))); 0 < ready)
+                {
+                    return 0 != poll_fds[1].revents ? WaitResult::eCLOSED : WaitResult::eREADY;
+                }
+                else if (-1 == ready && EINTR != errno)
+                {
+                    return WaitResult::eREADY; // let the following read()/write() surface the error
+                }
+            }
+        }
+
+        Response read(Handle in_handle, u8 *out_buffer, const size_t in_read_bytes, u32 in_timeout_ms)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{in_timeout_ms};
+                size_t read_bytes = 0;
+                while (read_bytes < in_read_bytes)
+                {
+                    const auto status = ::read(uart_port.m_handle, out_buffer + read_bytes, in_read_bytes - read_bytes);
+                    uart_port.m_profile.record_rx(status);
+                    if (0 < status)
+                    {
+                        read_bytes += status;
+                        continue;
+                    }
+                    if (-1 == status && EINTR == errno)
+                    {
+                        continue;
+                    }
+                    if (-1 == status && EAGAIN != errno && EWOULDBLOCK != errno)
+                    {
+                        OMEGA_LOGE("read failed with %s", strerror(errno));
+                        return {eFAILED, read_bytes};
+                    }
+                    if (0 == in_timeout_ms)
+                    {
+                        break;
+                    }
+                    if (const auto waited = wait_for(uart_port, POLLIN, deadline); WaitResult::eREADY != waited)
+                    {
+                        return WaitResult::eCLOSED == waited ? Response{eFAILED, read_bytes} : Response{eSUCCESS, read_bytes, true};
+                    }
+                }
+                return {eSUCCESS, read_bytes};
+            }
+            OMEGA_LOGE("Invalid handle");
+            return {eFAILED, 0};
+        }
+
+        Response write(Handle in_handle, const u8 *in_buffer, const size_t in_write_bytes, u32 in_timeout_ms)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                const auto deadline = 0 == in_timeout_ms ? std::chrono::steady_clock::time_point::max() : std::chrono::steady_clock::now() + std::chrono::milliseconds{in_timeout_ms};
+                size_t written_bytes = 0;
+                while (written_bytes < in_write_bytes)
+                {
+                    const auto status = ::write(uart_port.m_handle, in_buffer + written_bytes, in_write_bytes - written_bytes);
+                    uart_port.m_profile.record_tx(status);
+                    if (0 < status)
+                    {
+                        written_bytes += status;
+                        continue;
+                    }
+                    if (-1 == status && EINTR == errno)
+                    {
+                        continue;
+                    }
+                    if (-1 == status && EAGAIN != errno && EWOULDBLOCK != errno)
+                    {
+                        OMEGA_LOGE("write failed with %s", strerror(errno));
+                        return {eFAILED, written_bytes};
+                    }
+                    const auto block_started = PortProfile::now();
+                    const auto waited = wait_for(uart_port, POLLOUT, deadline);
+                    uart_port.m_profile.record_write_block(block_started);
+                    if (WaitResult::eREADY != waited)
+                    {
+                        return WaitResult::eCLOSED == waited ? Response{eFAILED, written_bytes} : Response{eSUCCESS, written_bytes, true};
+                    }
+                }
+                return {eSUCCESS, written_bytes};
+            }
+            OMEGA_LOGE("Invalid handle");
+            return {eFAILED, 0};
+        }
+
+        OmegaStatus write_batch(std::span<WriteRequest> io_requests, u32 in_timeout_ms)
+        {
+            const auto deadline = 0 == in_timeout_ms ? std::chrono::steady_clock::time_point::max() : std::chrono::steady_clock::now() + std::chrono::milliseconds{in_timeout_ms};
+            std::vector<WriteRequest *> sequential_requests;
+#if defined(CONFIG_OMEGA_UART_CONTROLLER_IO_URING)
+            std::vector<WriteRequest *> uring_requests;
+            for (auto &request : io_requests)
+            {
+                request.response = {eSUCCESS, 0};
+                const auto found = s_com_ports.pin(request.handle);
+                auto &target = found && found->m_registered_to_uring ? uring_requests : sequential_requests;
+                target.push_back(&request);
+            }
+            uring_write_batch(uring_requests, deadline);
+#else
+            for (auto &request : io_requests)
+            {
+                sequential_requests.push_back(&request);
+            }
+#endif
+            for (auto *request : sequential_requests)
+            {
+                u32 timeout_ms = 0;
+                if (0 != in_timeout_ms)
+                {
+                    const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+                    if (0 >= remaining)
+                    {
+                        request->response = {eSUCCESS, 0, true};
+                        continue;
+                    }
+                    timeout_ms = static_cast<u32>(remaining);
+                }
+                request->response = write(request->handle, request->buffer, request->size, timeout_ms);
+            }
+            for (const auto &request : io_requests)
+            {
+                if (eSUCCESS != request.response.status)
+                {
+                    return eFAILED;
+                }
+            }
+            return eSUCCESS;
+        }
+
+        /* START: COROUTINES */
+        // One epoll thread finishes every pending async operation and resumes the coroutines waiting on them
+        struct AsyncLoop
+        {
+            // Guards the pending operations, the ports' async slots and the timers
+            std::mutex m_mutex;
+            int m_epoll_handle{-1};
+            int m_wakeup_handle{-1};
+            std::thread *m_thread{nullptr};
+            std::atomic<bool> m_running{false};
+            // Ticks are milliseconds since m_epoch
+            TimerWheel<> m_timers;
+            const std::chrono::steady_clock::time_point m_epoch{std::chrono::steady_clock::now()};
+            // Finished away from the loop thread by a cancellation or deinit(), resumed by the loop
+            std::vector<Async::Operation *> m_finished;
+
+            ~AsyncLoop();
+        };
+        __internal__ AsyncLoop s_async_loop;
+        __internal__ thread_local bool t_on_async_loop{false};
+        __internal__ constexpr size_t ASYNC_MAX_EVENTS{64};
+
+        __internal__ u64 async_tick(std::chrono::steady_clock::time_point in_time)
+        {
+            return std::chrono::floor<std::chrono::milliseconds>(in_time - s_async_loop.m_epoch).count();
+        }
+
+        __internal__ Async::Operation *&async_slot(UARTPort &in_uart_port, const Async::Operation &in_operation)
+        {
+            return Async::OperationKind::eWRITE == in_operation.m_kind ? in_uart_port.m_async_writer : in_uart_port.m_async_reader;
+        }
+
+        // Hands out stashed bytes first. Returns true once the operation has nothing left to wait for
+        __internal__ bool async_perform(Async::Operation &io_operation, UARTPort &in_uart_port)
+        {
+            const bool until = Async::OperationKind::eREAD_UNTIL == io_operation.m_kind;
+            if (Async::OperationKind::eWRITE != io_operation.m_kind && !in_uart_port.m_async_stash.empty())
+            {
+                auto &stash = in_uart_port.m_async_stash;
+                size_t taken = std::min(stash.size(), io_operation.m_size - io_operation.m_done);
+                if (until)
+                {
+                    taken = Framing::find_byte(stash.data(), stash.data() + taken, io_operation.m_delimiter) - stash.data() + 1;
+                    taken = std::min(taken, std::min(stash.size(), io_operation.m_size - io_operation.m_done));
+                }
+                std::memcpy(io_operation.m_buffer + io_operation.m_done, stash.data(), taken);
+                stash.erase(stash.begin(), stash.begin() + taken);
+                io_operation.m_done += taken;
+                if (until && 0 < taken && io_operation.m_delimiter == io_operation.m_buffer[io_operation.m_done - 1])
+                {
+                    return true;
+                }
+            }
+            while (io_operation.m_done < io_operation.m_size)
+            {
+                u8 *position = io_operation.m_buffer + io_operation.m_done;
+                ssize_t status;
+                if (Async::OperationKind::eWRITE == io_operation.m_kind)
+                {
+                    status = ::write(in_uart_port.m_handle, position, io_operation.m_size - io_operation.m_done);
+                    in_uart_port.m_profile.record_tx(status);
+                }
+                else
+                {
+                    status = ::read(in_uart_port.m_handle, position, io_operation.m_size - io_operation.m_done);
+                    in_uart_port.m_profile.record_rx(status);
+                }
+                if (0 < status)
+                {
+                    io_operation.m_done += status;
+                    if (!until)
+                    {
+                        continue;
+                    }
+                    if (const u8 *delimiter = Framing::find_byte(position, position + status, io_operation.m_delimiter); position + status != delimiter)
+                    {
+                        const u8 *end = io_operation.m_buffer + io_operation.m_done;
+                        in_uart_port.m_async_stash.assign(delimiter + 1, end);
+                        io_operation.m_done -= end - (delimiter + 1);
+                        return true;
+                    }
+                    continue;
+                }
+                if (-1 == status && EINTR == errno)
+                {
+                    continue;
+                }
+                if (-1 == status && EAGAIN != errno && EWOULDBLOCK != errno)
+                {
+                    OMEGA_LOGE("%s failed with %s", Async::OperationKind::eWRITE == io_operation.m_kind ? "write" : "read", strerror(errno));
+                    io_operation.m_response.status = eFAILED;
+                    return true;
+                }
+                return false;
+            }
+            return true;
+        }
+
+        // Expects s_async_loop.m_mutex to be held. Interest is only dropped when in_narrow is set, which the loop does once an
+        // event turns up with nobody waiting for it, so back to back operations in one direction cost no epoll_ctl() at all
+        __internal__ void async_update_interest(Handle in_handle, UARTPort &in_uart_port, bool in_narrow)
+        {
+            const u32 events = (nullptr != in_uart_port.m_async_reader && in_uart_port.m_async_reader->m_armed ? static_cast<u32>(EPOLLIN) : 0) |
+                               (nullptr != in_uart_port.m_async_writer && in_uart_port.m_async_writer->m_armed ? static_cast<u32>(EPOLLOUT) : 0);
+            if (in_uart_port.m_async_registered && (in_narrow ? events == in_uart_port.m_async_events : 0 == (events & ~in_uart_port.m_async_events)))
+            {
+                return;
+            }
+            epoll_event port_event{.events = events, .data = {.u64 = in_handle}};
+            if (-1 == epoll_ctl(s_async_loop.m_epoll_handle, in_uart_port.m_async_registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, in_uart_port.m_handle, &port_event))
+            {
+                OMEGA_LOGE("epoll_ctl failed with %s", strerror(errno));
+                return;
+            }
+            in_uart_port.m_async_registered = true;
+            in_uart_port.m_async_events = events;
+        }
+
+        // Expects s_async_loop.m_mutex to be held. in_uart_port is null once the port is gone
+        __internal__ void async_finish(Async::Operation &io_operation, UARTPort *in_uart_port)
+        {
+            if (nullptr != in_uart_port && &io_operation == async_slot(*in_uart_port, io_operation))
+            {
+                async_slot(*in_uart_port, io_operation) = nullptr;
+            }
+            io_operation.m_armed = false;
+            s_async_loop.m_timers.cancel(io_operation);
+            io_operation.m_response.size = io_operation.m_done;
+        }
+
+        __internal__ void async_wake()
+        {
+            UNUSED(eventfd_write(s_async_loop.m_wakeup_handle, 1));
+        }
+
+        __internal__ void async_loop()
+        {
+            t_on_async_loop = true;
+            epoll_event events[ASYNC_MAX_EVENTS]{};
+            std::vector<std::coroutine_handle<>> ready;
+            while (s_async_loop.m_running.load(std::memory_order_acquire))
+            {
+                int timeout_ms = -1;
+                {
+                    std::lock_guard lock{s_async_loop.m_mutex};
+                    if (const u64 next = s_async_loop.m_timers.next_expiry(); TimerWheel<>::NEVER != next)
+                    {
+                        const u64 now = async_tick(std::chrono::steady_clock::now());
+                        timeout_ms = next > now ? static_cast<int>(std::min<u64>(next - now, INT_MAX)) : 0;
+                    }
+                }
+                const int event_count = epoll_wait(s_async_loop.m_epoll_handle, events, ASYNC_MAX_EVENTS, timeout_ms);
+                if (-1 == event_count && EINTR != errno)
+                {
+                    OMEGA_LOGE("epoll_wait failed with %s", strerror(errno));
+                    return;
+                }
+                {
+                    std::lock_guard lock{s_async_loop.m_mutex};
+                    for (int idx = 0; idx < event_count; ++idx)
+                    {
+                        if (INVALID_UART_HANDLE == events[idx].data.u64)
+                        {
+                            eventfd_t value{};
+                            UNUSED(eventfd_read(s_async_loop.m_wakeup_handle, &value));
+                            continue;
+                        }
+                        const Handle handle = events[idx].data.u64;
+                        auto found = s_com_ports.pin(handle);
+                        if (!found)
+                        {
+                            continue;
+                        }
+                        bool unclaimed = false;
+                        for (auto *operation : {found->m_async_reader, found->m_async_writer})
+                        {
+                            if (nullptr == operation || !operation->m_armed)
+                            {
+                                unclaimed = true;
+                            }
+                            else if (async_perform(*operation, *found))
+                            {
+                                async_finish(*operation, found.get());
+                                ready.push_back(operation->m_continuation);
+                            }
+                        }
+                        if (unclaimed)
+                        {
+                            async_update_interest(handle, *found, true);
+                        }
+                    }
+                    s_async_loop.m_timers.advance(async_tick(std::chrono::steady_clock::now()), [&ready](TimerHook &in_timer)
+                                                  {
+                                                      auto &operation = static_cast<Async::Operation &>(in_timer);
+                                                      operation.m_response.timed_out = Async::OperationKind::eSLEEP != operation.m_kind;
+                                                      auto found = s_com_ports.pin(operation.m_handle);
+                                                      async_finish(operation, found.get());
+                                                      ready.push_back(operation.m_continuation); });
+                    for (auto *operation : s_async_loop.m_finished)
+                    {
+                        ready.push_back(operation->m_continuation);
+                    }
+                    s_async_loop.m_finished.clear();
+                }
+                // Resumed coroutines may start, finish or cancel operations, all of which take the lock
+                for (auto continuation : ready)
+                {
+                    continuation.resume();
+                }
+                ready.clear();
+            }
+        }
+
+        // Expects s_async_loop.m_mutex to be held
+        __internal__ bool async_loop_open()
+        {
+            if (nullptr != s_async_loop.m_thread)
+            {
+                return true;
+            }
+            if (s_async_loop.m_epoll_handle = epoll_create1(EPOLL_CLOEXEC); -1 == s_async_loop.m_epoll_handle)
+            {
+                OMEGA_LOGE("epoll_create1 failed with %s", strerror(errno));
+                return false;
+            }
+            if (s_async_loop.m_wakeup_handle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC); -1 == s_async_loop.m_wakeup_handle)
+            {
+                OMEGA_LOGE("eventfd failed with %s", strerror(errno));
+                close(s_async_loop.m_epoll_handle);
+                s_async_loop.m_epoll_handle = -1;
+                return false;
+            }
+            epoll_event wakeup_event{.events = EPOLLIN, .data = {.u64 = INVALID_UART_HANDLE}};
+            UNUSED(epoll_ctl(s_async_loop.m_epoll_handle, EPOLL_CTL_ADD, s_async_loop.m_wakeup_handle, &wakeup_event));
+            s_async_loop.m_running.store(true, std::memory_order_release);
+            s_async_loop.m_thread = new std::thread{async_loop};
+            return true;
+        }
+
+        AsyncLoop::~AsyncLoop()
+        {
+            if (nullptr == m_thread)
+            {
+                return;
+            }
+            m_running.store(false, std::memory_order_release);
+            async_wake();
+            m_thread->join();
+            delete m_thread;
+            close(m_wakeup_handle);
+            close(m_epoll_handle);
+        }
+
+        // Called by deinit(): pending operations fail, and one still being started by its coroutine fails once it tries to suspend
+        __internal__ void async_abort(Handle in_handle, UARTPort &in_uart_port)
+        {
+            std::lock_guard lock{s_async_loop.m_mutex};
+            for (auto *operation : {in_uart_port.m_async_reader, in_uart_port.m_async_writer})
+            {
+                if (nullptr == operation)
+                {
+                    continue;
+                }
+                operation->m_closed = true;
+                if (operation->m_armed)
+                {
+                    operation->m_response.status = eFAILED;
+                    async_finish(*operation, &in_uart_port);
+                    s_async_loop.m_finished.push_back(operation);
+                }
+            }
+            in_uart_port.m_async_reader = nullptr;
+            in_uart_port.m_async_writer = nullptr;
+            if (in_uart_port.m_async_registered)
+            {
+                UNUSED(epoll_ctl(s_async_loop.m_epoll_handle, EPOLL_CTL_DEL, in_uart_port.m_handle, nullptr));
+                in_uart_port.m_async_registered = false;
+                async_wake();
+            }
+            UNUSED(in_handle);
+        }
+
+        namespace Async
+        {
+            void Canceller::operator()() const noexcept
+            {
+                std::lock_guard lock{s_async_loop.m_mutex};
+                if (!m_operation->m_armed)
+                {
+                    // not suspended yet, or already finished; await_suspend() looks at this before arming
+                    m_operation->m_cancel_requested = true;
+                    return;
+                }
+                m_operation->m_response.cancelled = true;
+                auto found = s_com_ports.pin(m_operation->m_handle);
+                async_finish(*m_operation, found.get());
+                s_async_loop.m_finished.push_back(m_operation);
+                async_wake();
+            }
+
+            bool Operation::await_ready()
+            {
+                if (OperationKind::eSLEEP == m_kind)
+                {
+                    m_response.cancelled = m_stop_token.stop_requested();
+                    if (m_response.cancelled || 0 == m_timeout_ms)
+                    {
+                        return true;
+                    }
+                    m_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{m_timeout_ms};
+                    return false;
+                }
+                auto found = s_com_ports.pin(m_handle);
+                if (!found || found->m_closing.load(std::memory_order_acquire))
+                {
+                    m_response.status = eFAILED;
+                    return true;
+                }
+                auto &uart_port = *found;
+                {
+                    std::lock_guard lock{s_async_loop.m_mutex};
+                    if (nullptr != async_slot(uart_port, *this))
+                    {
+                        OMEGA_LOGE("Another async %s is pending on this handle", OperationKind::eWRITE == m_kind ? "write" : "read");
+                        m_response.status = eFAILED;
+                        return true;
+                    }
+                    if (m_stop_token.stop_requested())
+                    {
+                        m_response.cancelled = true;
+                        return true;
+                    }
+                    async_slot(uart_port, *this) = this;
+                }
+                // The slot keeps other operations off the port, so the first attempt runs without the lock
+                const bool done = async_perform(*this, uart_port);
+                if (done || (OperationKind::eWRITE != m_kind && 0 == m_timeout_ms))
+                {
+                    std::lock_guard lock{s_async_loop.m_mutex};
+                    if (this == async_slot(uart_port, *this))
+                    {
+                        async_slot(uart_port, *this) = nullptr;
+                    }
+                    if (m_closed)
+                    {
+                        m_response.status = eFAILED;
+                    }
+                    m_response.size = m_done;
+                    return true;
+                }
+                if (0 != m_timeout_ms)
+                {
+                    m_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{m_timeout_ms};
+                }
+                return false;
+            }
+
+            bool Operation::await_suspend(std::coroutine_handle<> in_continuation)
+            {
+                m_continuation = in_continuation;
+                if (m_stop_token.stop_possible())
+                {
+                    m_stop_callback.emplace(m_stop_token, Canceller{this});
+                }
+                std::lock_guard lock{s_async_loop.m_mutex};
+                auto found = s_com_ports.pin(m_handle);
+                const bool sleeping = OperationKind::eSLEEP == m_kind;
+                const bool owned = sleeping || (found && this == async_slot(*found, *this));
+                if (!owned || m_closed || m_cancel_requested || !async_loop_open())
+                {
+                    if (owned && !sleeping)
+                    {
+                        async_slot(*found, *this) = nullptr;
+                    }
+                    m_response.cancelled = m_cancel_requested && !m_closed;
+                    m_response.status = m_response.cancelled ? eSUCCESS : eFAILED;
+                    m_response.size = m_done;
+                    return false;
+                }
+                m_armed = true;
+                if (std::chrono::steady_clock::time_point::max() != m_deadline)
+                {
+                    const u64 next = s_async_loop.m_timers.next_expiry();
+                    s_async_loop.m_timers.schedule(*this, std::chrono::ceil<std::chrono::milliseconds>(m_deadline - s_async_loop.m_epoch).count());
+                    if (s_async_loop.m_timers.next_expiry() < next && !t_on_async_loop)
+                    {
+                        async_wake();
+                    }
+                }
+                if (!sleeping)
+                {
+                    async_update_interest(m_handle, *found, false);
+                }
+                return true;
+            }
+        } // namespace Async
+        /* END: COROUTINES */
+
+        OmegaStatus add_on_read_callback(Handle in_handle, std::function<void(const Handle, const u8 *, const size_t)> in_callback)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                std::lock_guard lock{uart_port.m_control_mutex};
+                // the delivery thread walks the callbacks without a lock
+                if (is_started(uart_port))
+                {
+                    OMEGA_LOGE("Read callbacks cannot be added while the handle is started");
+                    return eFAILED;
+                }
+                uart_port.m_read_callbacks.push_back(in_callback);
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        OmegaStatus add_on_read_buffer_callback(Handle in_handle, std::function<void(const Handle, const RxBuffer &)> in_callback)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                std::lock_guard lock{uart_port.m_control_mutex};
+                // the delivery thread walks the callbacks without a lock
+                if (is_started(uart_port))
+                {
+                    OMEGA_LOGE("Read callbacks cannot be added while the handle is started");
+                    return eFAILED;
+                }
+                uart_port.m_read_buffer_callbacks.push_back(in_callback);
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        OmegaStatus add_on_read_chunk_callback(Handle in_handle, std::function<void(const Handle, const RxChunk &)> in_callback)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                std::lock_guard lock{uart_port.m_control_mutex};
+                // the delivery thread walks the callbacks without a lock
+                if (is_started(uart_port))
+                {
+                    OMEGA_LOGE("Read callbacks cannot be added while the handle is started");
+                    return eFAILED;
+                }
+                uart_port.m_read_chunk_callbacks.push_back(in_callback);
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        OmegaStatus set_rx_buffer_pool(Handle in_handle, size_t in_block_size, size_t in_block_count)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                std::lock_guard lock{uart_port.m_control_mutex};
+                if (is_started(uart_port))
+                {
+                    OMEGA_LOGE("RX buffer pool cannot be changed while the handle is started");
+                    return eFAILED;
+                }
+                auto *rx_pool = BufferPool::create(in_block_size, in_block_count);
+                if (nullptr == rx_pool)
+                {
+                    OMEGA_LOGE("RX buffer pool creation failed");
+                    return eFAILED;
+                }
+                if (nullptr != uart_port.m_rx_pool)
+                {
+                    uart_port.m_rx_pool->retire();
+                }
+                uart_port.m_rx_pool = rx_pool;
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        OmegaStatus set_rx_delivery_policy(Handle in_handle, const RxDeliveryPolicy &in_policy)
+        {
+            if (0 == in_policy.buffer_size || 0 == in_policy.min_bytes || !(0 <= in_policy.gap_characters))
+            {
+                OMEGA_LOGE("Invalid RX delivery policy");
+                return eFAILED;
+            }
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                std::lock_guard lock{uart_port.m_control_mutex};
+                if (is_started(uart_port))
+                {
+                    OMEGA_LOGE("RX delivery policy cannot be changed while the handle is started");
+                    return eFAILED;
+                }
+                if (nullptr != uart_port.m_rx_pool && uart_port.m_rx_pool->block_size() != in_policy.buffer_size)
+                {
+                    uart_port.m_rx_pool->retire();
+                    uart_port.m_rx_pool = nullptr;
+                }
+                uart_port.m_rx_policy = in_policy;
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        RxDeliveryPolicy get_rx_delivery_policy(Handle in_handle)
+        {
+            if (const auto found = s_com_ports.pin(in_handle))
+            {
+                std::lock_guard lock{found->m_control_mutex};
+                return found->m_rx_policy;
+            }
+            return {};
+        }
+
+        OmegaStatus set_rx_ring(Handle in_handle, size_t in_capacity)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                std::lock_guard lock{uart_port.m_control_mutex};
+                if (is_started(uart_port))
+                {
+                    OMEGA_LOGE("RX ring cannot be changed while the handle is started");
+                    return eFAILED;
+                }
+                uart_port.m_rx_ring = 0 == in_capacity ? nullptr : std::make_unique<RingBuffer>(in_capacity);
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        std::span<const u8> rx_peek(Handle in_handle)
+        {
+            if (const auto found = s_com_ports.pin(in_handle); found && nullptr != found->m_rx_ring)
+            {
+                return found->m_rx_ring->peek();
+            }
+            return {};
+        }
+
+        OmegaStatus rx_commit(Handle in_handle, size_t in_size)
+        {
+            if (const auto found = s_com_ports.pin(in_handle); found && nullptr != found->m_rx_ring)
+            {
+                found->m_rx_ring->commit(in_size);
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        RxRingStatistics get_rx_ring_statistics(Handle in_handle)
+        {
+            if (const auto found = s_com_ports.pin(in_handle); found && nullptr != found->m_rx_ring)
+            {
+                const auto &rx_ring = *found->m_rx_ring;
+                return {rx_ring.capacity(), rx_ring.size(), rx_ring.overrun_bytes(), rx_ring.overrun_events()};
+            }
+            return {};
+        }
+
+#if CONFIG_OMEGA_UART_CONTROLLER_PROFILE
+        ProfileSnapshot get_profile(Handle in_handle)
+        {
+            if (const auto found = s_com_ports.pin(in_handle))
+            {
+                return found->m_profile.snapshot();
+            }
+            return {};
+        }
+#endif
+
+        OmegaStatus start(Handle in_handle)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                std::lock_guard lock{uart_port.m_control_mutex};
+                if (uart_port.m_closing.load(std::memory_order_acquire))
+                {
+                    return eFAILED;
+                }
+                if (is_started(uart_port))
+                {
+                    OMEGA_LOGE("Handle is already started");
+                    return eFAILED;
+                }
+                if (nullptr == uart_port.m_rx_ring && nullptr == uart_port.m_rx_pool)
+                {
+                    if (uart_port.m_rx_pool = BufferPool::create(uart_port.m_rx_policy.buffer_size, RX_POOL_BLOCK_COUNT); nullptr == uart_port.m_rx_pool)
+                    {
+                        OMEGA_LOGE("RX buffer pool creation failed");
+                        return eFAILED;
+                    }
+                }
+                if (eSUCCESS != apply_rx_delivery_policy(uart_port))
+                {
+                    return eFAILED;
+                }
+                uart_port.m_rx_character_ns = character_time_ns(uart_port);
+                uart_port.m_rx_gap_threshold_us = static_cast<u64>(uart_port.m_rx_policy.gap_characters * uart_port.m_rx_character_ns / 1000);
+                uart_port.m_rx_last_us = Timers::now();
+                const auto io_model = s_io_model.load(std::memory_order_acquire);
+#if defined(CONFIG_OMEGA_UART_CONTROLLER_IO_URING)
+                if (IOModel::eIO_URING == io_model)
+                {
+                    if (const auto status = uring_register(in_handle, uart_port); eSUCCESS != status)
+                    {
+                        release_rx_timer(uart_port);
+                        return status;
+                    }
+                    return eSUCCESS;
+                }
+#endif
+                if (IOModel::eREACTOR == io_model)
+                {
+                    if (const auto status = reactor_register(in_handle, uart_port); eSUCCESS != status)
+                    {
+                        release_rx_timer(uart_port);
+                        return status;
+                    }
+                    return eSUCCESS;
+                }
+                if (uart_port.m_stop_handle = eventfd(0, EFD_CLOEXEC); -1 == uart_port.m_stop_handle)
+                {
+                    OMEGA_LOGE("eventfd failed with %s", strerror(errno));
+                    release_rx_timer(uart_port);
+                    return eFAILED;
+                }
+                // A stop() issued from one of the thread's own callbacks detaches it and leaves the stop eventfd to it. Its pin
+                // keeps the port alive until it is back from the callback, even if the callback also deinitialised the handle
+                auto uart_read_thread = [in_handle, stop_handle = uart_port.m_stop_handle](SlotMap<UARTPort>::Pin in_pinned)
+                {
+                    t_on_rx_thread = true;
+                    auto &in_uart_port = *in_pinned;
+                    // -1 once the tty failed, the thread then only waits for stop()
+                    int serial_handle = in_uart_port.m_handle;
+                    for (;;)
+                    {
+                        // a negative fd is ignored by poll(), so a port without an RX timer just never reports it
+                        pollfd poll_fds[3]{
+                            {.fd = serial_handle, .events = POLLIN, .revents = 0},
+                            {.fd = stop_handle, .events = POLLIN, .revents = 0},
+                            {.fd = in_uart_port.m_rx_timer_handle, .events = POLLIN, .revents = 0},
+                        };
+                        if (-1 == poll(poll_fds, 3, -1))
+                        {
+                            if (EINTR == errno)
+                                continue;
+                            OMEGA_LOGE("poll failed with %s", strerror(errno));
+                            return;
+                        }
+                        if (0 != poll_fds[1].revents)
+                        {
+                            return;
+                        }
+                        if (0 != poll_fds[2].revents)
+                        {
+                            on_rx_timer_expired(in_handle, in_uart_port);
+                        }
+                        if (0 != poll_fds[0].revents && !t_reader_detached)
+                        {
+                            if (0 != (poll_fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) && 0 == (poll_fds[0].revents & POLLIN))
+                            {
+                                OMEGA_LOGE("Serial port hung up");
+                                serial_handle = -1;
+                            }
+                            else
+                            {
+                                drain_port(in_handle, in_uart_port);
+                            }
+                        }
+                        if (t_reader_detached)
+                        {
+                            break;
+                        }
+                    }
+                    close(stop_handle);
+                };
+                uart_port.m_uart_read_thread = new std::thread{uart_read_thread, s_com_ports.pin(in_handle)};
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        OmegaStatus start(Handle in_handle, const std::function<void(const Handle, const u8 *, const size_t)> in_callback)
+        {
+            if (nullptr == in_callback)
+                return eFAILED;
+            if (const auto status = add_on_read_callback(in_handle, in_callback); eSUCCESS != status)
+            {
+                return status;
+            }
+            return start(in_handle);
+        }
+
+        Configuration get_configuration(Handle in_handle)
+        {
+            if (const auto found = s_com_ports.pin(in_handle))
+            {
+                const auto &uart_port = *found;
+                const auto actual_baudrate = get_actual_baudrate(uart_port.m_handle);
+                return {0 == actual_baudrate ? uart_port.m_baudrate : actual_baudrate, uart_port.m_databits, uart_port.m_parity, uart_port.m_stopbits};
+            }
+            return {};
+        }
+
+        __internal__ TuningResult set_async_low_latency(int in_serial_handle)
+        {
+            struct serial_struct serial_info{};
+            if (-1 == ioctl(in_serial_handle, TIOCGSERIAL, &serial_info))
+            {
+                // ptys and some USB CDC drivers do not implement the legacy serial ioctls
+                return ENOTTY == errno || EINVAL == errno ? TuningResult::eSKIPPED : TuningResult::eFAILED;
+            }
+            if (0 != (serial_info.flags & ASYNC_LOW_LATENCY))
+            {
+                return TuningResult::eAPPLIED;
+            }
+            serial_info.flags |= ASYNC_LOW_LATENCY;
+            if (-1 == ioctl(in_serial_handle, TIOCSSERIAL, &serial_info))
+            {
+                OMEGA_LOGW("TIOCSSERIAL failed with %s", strerror(errno));
+                return TuningResult::eFAILED;
+            }
+            return TuningResult::eAPPLIED;
+        }
+
+        // FTDI style adapters expose their USB receive flush timer as <device>/latency_timer in sysfs
+        __internal__ TuningResult set_latency_timer(const char *in_port_name, u8 in_latency_timer_ms)
+        {
+            char device_path[PATH_MAX + 1]{0};
+            if (nullptr == realpath(in_port_name, device_path))
+            {
+                return TuningResult::eFAILED;
+            }
+            const char *device_name = std::strrchr(device_path, '/');
+            device_name = nullptr == device_name ? device_path : device_name + 1;
+            const std::string sysfs_path = std::string{"/sys/class/tty/"} + device_name + "/device/latency_timer";
+            const int sysfs_handle = open(sysfs_path.c_str(), O_WRONLY | O_CLOEXEC);
+            if (-1 == sysfs_handle)
+            {
+                return ENOENT == errno ? TuningResult::eSKIPPED : TuningResult::eFAILED;
+            }
+            char value[8]{0};
+            const int value_length = snprintf(value, sizeof(value), "%u", in_latency_timer_ms);
+            const auto written = ::write(sysfs_handle, value, value_length);
+            close(sysfs_handle);
+            if (value_length != written)
+            {
+                OMEGA_LOGW("Writing %s failed with %s", sysfs_path.c_str(), strerror(errno));
+                return TuningResult::eFAILED;
+            }
+            return TuningResult::eAPPLIED;
+        }
+
+        LowLatencyReport enable_low_latency(Handle in_handle, u8 in_latency_timer_ms)
+        {
+            if (const auto found = s_com_ports.pin(in_handle))
+            {
+                const auto &uart_port = *found;
+                return {set_async_low_latency(uart_port.m_handle), set_latency_timer(uart_port.m_port_name, in_latency_timer_ms)};
+            }
+            return {TuningResult::eFAILED, TuningResult::eFAILED};
+        }
+
+        // A read callback that stops a handle must not block on a stop() that is itself waiting for that callback to
+        // return, so on the delivery threads a stop() already in progress counts as done
+        __internal__ bool lock_for_stop(UARTPort &in_uart_port, std::unique_lock<std::mutex> &io_lock)
+        {
+            if (!t_on_rx_thread)
+            {
+                io_lock.lock();
+                return true;
+            }
+            while (!io_lock.try_lock())
+            {
+                if (in_uart_port.m_stopping.load(std::memory_order_acquire))
+                {
+                    return false;
+                }
+                std::this_thread::yield();
+            }
+            return true;
+        }
+
+        __internal__ OmegaStatus stop_port(Handle in_handle, UARTPort &in_uart_port)
+        {
+#if defined(CONFIG_OMEGA_UART_CONTROLLER_IO_URING)
+            if (in_uart_port.m_registered_to_uring)
+            {
+                uring_unregister(in_handle, in_uart_port);
+                flush_rx_pending(in_handle, in_uart_port);
+                release_rx_timer(in_uart_port);
+                return eSUCCESS;
+            }
+#endif
+            if (in_uart_port.m_registered_to_reactor)
+            {
+                reactor_unregister(in_handle, in_uart_port);
+                flush_rx_pending(in_handle, in_uart_port);
+                release_rx_timer(in_uart_port);
+                return eSUCCESS;
+            }
+            if (nullptr != in_uart_port.m_uart_read_thread)
+            {
+                if (std::this_thread::get_id() == in_uart_port.m_uart_read_thread->get_id())
+                {
+                    in_uart_port.m_uart_read_thread->detach();
+                    t_reader_detached = true;
+                }
+                else
+                {
+                    UNUSED(eventfd_write(in_uart_port.m_stop_handle, 1));
+                    in_uart_port.m_uart_read_thread->join();
+                    close(in_uart_port.m_stop_handle);
+                }
+                delete in_uart_port.m_uart_read_thread;
+                in_uart_port.m_uart_read_thread = nullptr;
+                in_uart_port.m_stop_handle = -1;
+                flush_rx_pending(in_handle, in_uart_port);
+                release_rx_timer(in_uart_port);
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        OmegaStatus stop(Handle in_handle)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                std::unique_lock lock{uart_port.m_control_mutex, std::defer_lock};
+                if (!lock_for_stop(uart_port, lock))
+                {
+                    return eSUCCESS;
+                }
+                uart_port.m_stopping.store(true, std::memory_order_release);
+                const auto status = stop_port(in_handle, uart_port);
+                uart_port.m_stopping.store(false, std::memory_order_release);
+                return status;
+            }
+            return eFAILED;
+        }
+
+        OmegaStatus deinit(const Handle in_handle)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                if (uart_port.m_closing.exchange(true, std::memory_order_acq_rel))
+                {
+                    // another deinit() got here first
+                    return eFAILED;
+                }
+                UNUSED(stop(in_handle));
+                // read() and write() calls still waiting on the port hold their own pins and give up once this is signalled
+                UNUSED(eventfd_write(uart_port.m_closing_handle, 1));
+                async_abort(in_handle, uart_port);
                 s_com_ports.erase(in_handle);
                 return eSUCCESS;
             }
@@ -4,11 +4,13 @@
 #include <fcntl.h>
 #include <functional>
 #include <iostream>
+#include <poll.h>
 #include <termios.h>
 #include <thread>
 #include <unistd.h>
 #include <vector>
 
+#include "OmegaUARTController/SlotMap.hpp"
 #include "OmegaUARTController/UARTController.hpp"
 #include "OmegaUtilityDriver/UtilityDriver.hpp"
 
@@ -36,11 +38,17 @@ namespace Omega
             Parity m_parity{Parity::ePARITY_DISABLE};
             std::function<void()> m_connected_callback;
 			std::function<void(const Handle, const u8 *, const size_t)> m_read_callback;
+            std::vector<std::function<void(const Handle, const RxBuffer &)>> m_read_buffer_callbacks;
+            BufferPool *m_rx_pool{nullptr};
 			std::function<void()> m_disconnected_callback;
             UARTStatus m_status{UARTStatus::eDEINITED};
             std::thread *m_uart_read_thread{nullptr};
+            // write end of the pipe stop() wakes the read thread through, the thread closes the read end on its way out
+            int m_wakeup_handle{-1};
         };
-        __internal__ std::unordered_map<Handle, UARTPort> s_com_ports;
+        __internal__ SlotMap<UARTPort> s_com_ports;
+        __internal__ constexpr size_t RX_CHUNK_SIZE{100};
+        __internal__ constexpr size_t RX_POOL_BLOCK_COUNT{32};
 
         std::string CFStringToString(CFStringRef cfString)
         {
@@ -109,8 +117,6 @@ namespace Omega
 
         Handle init(const char *in_port, Baudrate in_baudrate, DataBits in_databits, Parity in_parity, StopBits in_stopbits)
         {
-            __internal__ Handle user_serial_handle = 0;
-
             if (nullptr == in_port || 0 == std::strlen(in_port))
             {
                 OMEGA_LOGE("Invalid serial port path");
@@ -207,7 +213,6 @@ namespace Omega
                 return 0;
             }
 
-            user_serial_handle++;
             UARTPort serial_port{
                 .m_handle = serial_handle,
                 .m_baudrate = in_baudrate,
@@ -216,8 +221,13 @@ namespace Omega
                 .m_parity = in_parity,
             };
             UNUSED(std::strncpy(serial_port.m_port_name, in_port, PORT_NAME_SIZE));
-            UNUSED(s_com_ports.insert({user_serial_handle, serial_port}));
-
+            const Handle user_serial_handle = s_com_ports.emplace(serial_port);
+            if (INVALID_UART_HANDLE == user_serial_handle)
+            {
+                OMEGA_LOGE("No free handle left for %s", in_port);
+                close(serial_handle);
+                return 0;
+            }
             return user_serial_handle;
         }
 
@@ -229,32 +239,95 @@ namespace Omega
 
         bool is_connected(Handle in_handle)
         {
-            if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+            if (s_com_ports.pin(in_handle))
             {
                 return true;
             }
             return false;
         }
 
+        // Delivers what arrives on the tty until in_wakeup_handle becomes readable or the tty goes away
+        __internal__ void read_loop(Handle in_handle, UARTPort &in_uart_port, int in_wakeup_handle)
+        {
+            pollfd poll_fds[2]{
+                {.fd = in_uart_port.m_handle, .events = POLLIN, .revents = 0},
+                {.fd = in_wakeup_handle, .events = POLLIN, .revents = 0},
+            };
+            for (;;)
+            {
+                if (-1 == poll(poll_fds, 2, -1))
+                {
+                    if (EINTR == errno)
+                    {
+                        continue;
+                    }
+                    OMEGA_LOGE("poll failed with %s", strerror(errno));
+                    return;
+                }
+                if (0 != poll_fds[1].revents)
+                {
+                    return;
+                }
+                if (0 != (poll_fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)))
+                {
+                    OMEGA_LOGE("%s went away", in_uart_port.m_port_name);
+                    return;
+                }
+                auto rx_buffer = in_uart_port.m_rx_pool->acquire();
+                if (!rx_buffer)
+                {
+                    // Every block is still held by a consumer. Drop the bytes instead of stalling the tty
+                    u8 discard[RX_CHUNK_SIZE];
+                    UNUSED(read(in_handle, discard, sizeof(discard), 0));
+                    continue;
+                }
+                const auto response = read(in_handle, BufferPool::writable_data(rx_buffer), in_uart_port.m_rx_pool->block_size(), 0);
+                if (0 < response.size)
+                {
+                    BufferPool::set_size(rx_buffer, response.size);
+                    if (nullptr != in_uart_port.m_read_callback)
+                        in_uart_port.m_read_callback(in_handle, rx_buffer.data(), rx_buffer.size());
+                    for (const auto &user_callback : in_uart_port.m_read_buffer_callbacks)
+                    {
+                        user_callback(in_handle, rx_buffer);
+                    }
+                }
+            }
+        }
+
         OmegaStatus start(Handle in_handle,const std::function<void(const Handle, const u8 *, const size_t)> in_callback)
         {
-            if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+            if (auto found = s_com_ports.pin(in_handle))
             {
-                auto &uart_port = s_com_ports.at(in_handle);
+                auto &uart_port = *found;
+                if (nullptr != uart_port.m_uart_read_thread)
+                {
+                    OMEGA_LOGE("Handle is already started");
+                    return eFAILED;
+                }
                 uart_port.m_read_callback = in_callback;
-                auto uart_read_thread = [in_handle, &uart_port](const UARTPort &in_uart_port)
+                if (nullptr == uart_port.m_rx_pool)
                 {
-                    for (;;)
+                    if (uart_port.m_rx_pool = BufferPool::create(RX_CHUNK_SIZE, RX_POOL_BLOCK_COUNT); nullptr == uart_port.m_rx_pool)
                     {
-                        char buffer[100 + 1]{0};
-                        const auto response = read(in_handle, (u8 *)buffer, 100, 0);
-                        if (0 < response.size)
-                        {
-                                uart_port.m_read_callback(in_handle, (const u8 *)buffer, response.size);
-                        }
+                        OMEGA_LOGE("RX buffer pool creation failed");
+                        return eFAILED;
                     }
+                }
+                int wakeup_handles[2]{-1, -1};
+                if (-1 == pipe(wakeup_handles))
+                {
+                    OMEGA_LOGE("pipe failed with %s", strerror(errno));
+                    return eFAILED;
+                }
+                uart_port.m_wakeup_handle = wakeup_handles[1];
+                // The pin keeps the port alive until the thread is back from its callbacks, even one that deinitialised it
+                auto uart_read_thread = [in_handle](SlotMap<UARTPort>::Pin in_pinned, int in_wakeup_handle)
+                {
+                    read_loop(in_handle, *in_pinned, in_wakeup_handle);
+                    close(in_wakeup_handle);
                 };
-                uart_port.m_uart_read_thread = new std::thread{uart_read_thread, uart_port};
+                uart_port.m_uart_read_thread = new std::thread{uart_read_thread, s_com_ports.pin(in_handle), wakeup_handles[0]};
                 return eSUCCESS;
             }
             return eFAILED;
@@ -262,9 +335,9 @@ namespace Omega
 
         Response read(Handle in_handle, u8 *out_buffer, const size_t in_read_bytes, u32 in_timeout_ms)
         {
-            if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+            if (auto found = s_com_ports.pin(in_handle))
             {
-                auto &uart_port = s_com_ports.at(in_handle);
+                auto &uart_port = *found;
                 unsigned long read_bytes = 0;
                 if (read_bytes = ::read(uart_port.m_handle, out_buffer, in_read_bytes); -1 == read_bytes)
                 {
@@ -278,9 +351,9 @@ namespace Omega
 
         Response write(Handle in_handle, const u8 *in_buffer, const size_t in_write_bytes, u32 in_timeout_ms)
         {
-            if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+            if (auto found = s_com_ports.pin(in_handle))
             {
-                auto &uart_port = s_com_ports.at(in_handle);
+                auto &uart_port = *found;
                 unsigned long written_bytes = 0;
                 if (written_bytes = ::write(uart_port.m_handle, in_buffer, in_write_bytes); -1 == written_bytes)
                 {
@@ -304,14 +377,37 @@ namespace Omega
             return {};
         }
 
-        void set_configuration(Handle in_handle, Configuration in_configuration)
+        void set_configuration(Handle in_handle, const Configuration &in_configuration)
         {
             OMEGA_LOGE("Not implemented");
         }
 
         OmegaStatus stop(Handle in_handle)
         {
-            OMEGA_LOGE("Not implemented");
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                if (nullptr == uart_port.m_uart_read_thread)
+                {
+                    return eSUCCESS;
+                }
+                const u8 wakeup{1};
+                UNUSED(::write(uart_port.m_wakeup_handle, &wakeup, sizeof(wakeup)));
+                close(uart_port.m_wakeup_handle);
+                uart_port.m_wakeup_handle = -1;
+                if (std::this_thread::get_id() == uart_port.m_uart_read_thread->get_id())
+                {
+                    // stopped from one of its own callbacks, it returns once the callback does
+                    uart_port.m_uart_read_thread->detach();
+                }
+                else
+                {
+                    uart_port.m_uart_read_thread->join();
+                }
+                delete uart_port.m_uart_read_thread;
+                uart_port.m_uart_read_thread = nullptr;
+                return eSUCCESS;
+            }
             return eFAILED;
         }
 
@@ -323,15 +419,65 @@ namespace Omega
 
         OmegaStatus deinit(Handle in_handle)
         {
-            OMEGA_LOGE("Not implemented");
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                UNUSED(stop(in_handle));
+                close(uart_port.m_handle);
+                // RxBuffers still held by consumers keep the pool alive until they are released
+                if (nullptr != uart_port.m_rx_pool)
+                {
+                    uart_port.m_rx_pool->retire();
+                    uart_port.m_rx_pool = nullptr;
+                }
+                s_com_ports.erase(in_handle);
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        OmegaStatus add_on_read_buffer_callback(Handle in_handle, std::function<void(const Handle, const RxBuffer &)> in_callback)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                uart_port.m_read_buffer_callbacks.push_back(in_callback);
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        OmegaStatus set_rx_buffer_pool(Handle in_handle, size_t in_block_size, size_t in_block_count)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                if (nullptr != uart_port.m_uart_read_thread)
+                {
+                    OMEGA_LOGE("RX buffer pool cannot be changed while the handle is started");
+                    return eFAILED;
+                }
+                auto *rx_pool = BufferPool::create(in_block_size, in_block_count);
+                if (nullptr == rx_pool)
+                {
+                    OMEGA_LOGE("RX buffer pool creation failed");
+                    return eFAILED;
+                }
+                if (nullptr != uart_port.m_rx_pool)
+                {
+                    uart_port.m_rx_pool->retire();
+                }
+                uart_port.m_rx_pool = rx_pool;
+                return eSUCCESS;
+            }
             return eFAILED;
         }
 
         OmegaStatus add_on_connected_callback(Handle in_handle, std::function<void(void)> in_callback)
         {
-            if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+            if (auto found = s_com_ports.pin(in_handle))
             {
-                auto &uart_port = s_com_ports.at(in_handle);
+                auto &uart_port = *found;
                 
                 uart_port.m_connected_callback = in_callback;
                 return eSUCCESS;
@@ -341,9 +487,9 @@ namespace Omega
 
         OmegaStatus add_on_disconnected_callback(Handle in_handle, std::function<void(void)> in_callback)
         {
-            if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+            if (auto found = s_com_ports.pin(in_handle))
             {
-                auto &uart_port = s_com_ports.at(in_handle);
+                auto &uart_port = *found;
                 
                 uart_port.m_disconnected_callback = in_callback;
                 return eSUCCESS;
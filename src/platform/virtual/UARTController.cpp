@@ -0,0 +1,860 @@
+/**
+ * @file UARTController.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 8:41:07 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: UARTController.cpp
+ * File Created: Saturday, 17th October 2026 8:41:07 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 8:41:07 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "OmegaUtilityDriver/UtilityDriver.hpp"
+#include "OmegaUARTController/BufferPool.hpp"
+#include "OmegaUARTController/SlotMap.hpp"
+#include "OmegaUARTController/UARTController.hpp"
+
+namespace Omega
+{
+    namespace UART
+    {
+        using Clock = std::chrono::steady_clock;
+
+        __internal__ constexpr size_t RX_CHUNK_SIZE{100};
+        __internal__ constexpr size_t RX_POOL_BLOCK_COUNT{32};
+        // Bytes a line holds between write() and the reader, the size of a tty's input buffer
+        __internal__ constexpr size_t LINE_CAPACITY{4096};
+
+        /* START: LINES */
+        // Bytes that went onto the wire back to back. Byte n of the run has fully arrived at m_first_arrival + n * m_byte_time
+        struct Segment
+        {
+            Clock::time_point m_first_arrival;
+            std::chrono::nanoseconds m_byte_time;
+            size_t m_size;
+        };
+
+        // One direction of a pair: everything written towards a port that the port has not read yet
+        struct VirtualLine
+        {
+            std::mutex m_mutex;
+            // bytes queued or taken, or a port on either end closing
+            std::condition_variable m_changed;
+            u8 m_bytes[LINE_CAPACITY];
+            size_t m_head{0};
+            size_t m_size{0};
+            std::deque<Segment> m_segments;
+            Clock::time_point m_wire_free_at{};
+            VirtualFaults m_faults{};
+            std::mt19937 m_random{1};
+        };
+
+        struct Pending
+        {
+            size_t m_arrived;
+            Clock::time_point m_next_arrival; // max when nothing is still on the wire
+        };
+
+        __internal__ Pending pending(const VirtualLine &in_line, Clock::time_point in_now)
+        {
+            Pending result{0, Clock::time_point::max()};
+            for (const auto &segment : in_line.m_segments)
+            {
+                if (in_now < segment.m_first_arrival)
+                {
+                    result.m_next_arrival = segment.m_first_arrival;
+                    break;
+                }
+                const size_t arrived = 0 == segment.m_byte_time.count() ? segment.m_size : std::min<size_t>(segment.m_size, 1 + (in_now - segment.m_first_arrival) / segment.m_byte_time);
+                result.m_arrived += arrived;
+                if (arrived < segment.m_size)
+                {
+                    result.m_next_arrival = segment.m_first_arrival + arrived * segment.m_byte_time;
+                    break;
+                }
+            }
+            return result;
+        }
+
+        __internal__ void push_bytes(VirtualLine &io_line, const u8 *in_data, size_t in_size)
+        {
+            const size_t tail = (io_line.m_head + io_line.m_size) % LINE_CAPACITY;
+            const size_t first = std::min(in_size, LINE_CAPACITY - tail);
+            std::memcpy(io_line.m_bytes + tail, in_data, first);
+            std::memcpy(io_line.m_bytes, in_data + first, in_size - first);
+            io_line.m_size += in_size;
+        }
+
+        __internal__ void take_bytes(VirtualLine &io_line, u8 *out_data, size_t in_size)
+        {
+            const size_t first = std::min(in_size, LINE_CAPACITY - io_line.m_head);
+            std::memcpy(out_data, io_line.m_bytes + io_line.m_head, first);
+            std::memcpy(out_data + first, io_line.m_bytes, in_size - first);
+            io_line.m_head = (io_line.m_head + in_size) % LINE_CAPACITY;
+            io_line.m_size -= in_size;
+            while (0 < in_size)
+            {
+                auto &segment = io_line.m_segments.front();
+                const size_t taken = std::min(in_size, segment.m_size);
+                segment.m_size -= taken;
+                segment.m_first_arrival += taken * segment.m_byte_time;
+                in_size -= taken;
+                if (0 == segment.m_size)
+                {
+                    io_line.m_segments.pop_front();
+                }
+            }
+        }
+
+        // Runs that follow each other on the wire, or that both arrived already, are kept as one so pending() stays short
+        __internal__ void append_segment(VirtualLine &io_line, const Segment &in_segment, Clock::time_point in_now)
+        {
+            if (!io_line.m_segments.empty())
+            {
+                auto &back = io_line.m_segments.back();
+                const bool contiguous = back.m_byte_time == in_segment.m_byte_time && back.m_first_arrival + back.m_size * back.m_byte_time == in_segment.m_first_arrival;
+                const bool arrived = 0 == back.m_byte_time.count() && 0 == in_segment.m_byte_time.count() && in_segment.m_first_arrival <= in_now;
+                if (contiguous || arrived)
+                {
+                    back.m_size += in_segment.m_size;
+                    return;
+                }
+            }
+            io_line.m_segments.push_back(in_segment);
+        }
+
+        __internal__ bool chance(VirtualLine &io_line, double in_probability)
+        {
+            return 0 < in_probability && std::uniform_real_distribution<double>{0, 1}(io_line.m_random) < in_probability;
+        }
+
+        // Puts in_size bytes on the wire after whatever is still in flight, applying the receiving end's faults
+        __internal__ void transmit(VirtualLine &io_line, const u8 *in_data, size_t in_size, std::chrono::nanoseconds in_byte_time, u8 in_data_bits)
+        {
+            auto &faults = io_line.m_faults;
+            const auto now = Clock::now();
+            auto start = std::max(now, io_line.m_wire_free_at);
+            if (chance(io_line, faults.stall_probability))
+            {
+                start += std::chrono::microseconds{faults.stall_us};
+            }
+            io_line.m_wire_free_at = start + in_size * in_byte_time;
+            Segment segment{start + in_byte_time, in_byte_time, 0};
+            if (0 == faults.drop_probability && 0 == faults.bit_flip_probability && 8 == in_data_bits)
+            {
+                push_bytes(io_line, in_data, in_size);
+                segment.m_size = in_size;
+                append_segment(io_line, segment, now);
+                return;
+            }
+            const u8 data_mask = static_cast<u8>((1u << in_data_bits) - 1);
+            for (size_t idx = 0; idx < in_size; ++idx)
+            {
+                if (chance(io_line, faults.drop_probability))
+                {
+                    // the byte still took its time on the wire, the ones after it arrive no earlier
+                    if (0 < segment.m_size)
+                    {
+                        append_segment(io_line, segment, now);
+                    }
+                    segment = {start + (idx + 2) * in_byte_time, in_byte_time, 0};
+                    continue;
+                }
+                u8 byte = in_data[idx] & data_mask;
+                if (chance(io_line, faults.bit_flip_probability))
+                {
+                    byte ^= static_cast<u8>(1u << (io_line.m_random() % in_data_bits));
+                }
+                push_bytes(io_line, &byte, 1);
+                segment.m_size++;
+            }
+            if (0 < segment.m_size)
+            {
+                append_segment(io_line, segment, now);
+            }
+        }
+
+        // Returns false once in_deadline passed. Without a deadline it waits for the next change
+        __internal__ bool wait_line(VirtualLine &io_line, std::unique_lock<std::mutex> &io_lock, Clock::time_point in_deadline)
+        {
+            if (Clock::time_point::max() == in_deadline)
+            {
+                io_line.m_changed.wait(io_lock);
+                return true;
+            }
+            return std::cv_status::no_timeout == io_line.m_changed.wait_until(io_lock, in_deadline) || Clock::now() < in_deadline;
+        }
+
+        // Wakes everything waiting on in_line so it re-checks state that was changed without holding its lock
+        __internal__ void wake(VirtualLine &io_line)
+        {
+            {
+                std::lock_guard lock{io_line.m_mutex};
+            }
+            io_line.m_changed.notify_all();
+        }
+        /* END: LINES */
+
+        /* START: PAIRS */
+        // Long enough for a port name, short enough that the peer's friendly name "Virtual UART (peer <name>)" fits whole
+        __internal__ constexpr size_t VIRTUAL_PORT_NAME_SIZE{std::min(PORT_NAME_SIZE, FRIENDLY_PORT_NAME_SIZE + 1 - sizeof("Virtual UART (peer )"))};
+
+        struct VirtualEndpoint
+        {
+            char m_name[VIRTUAL_PORT_NAME_SIZE + 1]{0};
+            VirtualLine m_rx;
+            VirtualEndpoint *m_peer{nullptr};
+            std::atomic<bool> m_line_rate{false};
+            std::atomic<bool> m_unplugged{false};
+            Handle m_handle{INVALID_UART_HANDLE}; // guarded by s_pairs_mutex
+        };
+
+        // Both ends live and die together, so each can point at its peer
+        struct VirtualPair
+        {
+            VirtualEndpoint m_ends[2];
+            // Cleared by disconnect() on either end: the cable between them is pulled until connect() plugs it back
+            std::atomic<bool> m_linked{true};
+        };
+
+        __internal__ std::mutex s_pairs_mutex;
+        __internal__ std::vector<std::shared_ptr<VirtualPair>> s_pairs;
+
+        __internal__ std::shared_ptr<VirtualPair> find_pair(const char *in_port, VirtualEndpoint **out_endpoint)
+        {
+            for (const auto &pair : s_pairs)
+            {
+                for (auto &end : pair->m_ends)
+                {
+                    if (0 == std::strncmp(end.m_name, in_port, PORT_NAME_SIZE))
+                    {
+                        *out_endpoint = &end;
+                        return pair;
+                    }
+                }
+            }
+            return nullptr;
+        }
+        /* END: PAIRS */
+
+        struct UARTPort
+        {
+            UARTPort(std::shared_ptr<VirtualPair> in_pair, VirtualEndpoint &in_endpoint, const Configuration &in_configuration)
+                : m_pair{std::move(in_pair)}, m_endpoint{in_endpoint}, m_configuration{in_configuration}
+            {
+                update_byte_time();
+            }
+            UARTPort(const UARTPort &) = delete;
+            UARTPort &operator=(const UARTPort &) = delete;
+            ~UARTPort()
+            {
+                if (nullptr != m_rx_pool)
+                {
+                    m_rx_pool->retire();
+                }
+            }
+
+            // start bit, data bits, parity bit and stop bits, counted in half bits for 1.5 stop bits
+            void update_byte_time()
+            {
+                const u64 half_bits = 2 * (1 + static_cast<u64>(m_configuration.databits) + (Parity::ePARITY_DISABLE == m_configuration.parity ? 0 : 1)) +
+                                      (StopBits::eSTOP_BITS_1 == m_configuration.stopbits ? 2 : StopBits::eSTOP_BITS_1_5 == m_configuration.stopbits ? 3 : 4);
+                const u64 baudrate = std::max<u64>(1, m_configuration.baudrate);
+                m_byte_time_ns.store(static_cast<i64>(half_bits * 1'000'000'000 / (2 * baudrate)), std::memory_order_relaxed);
+                m_data_bits.store(static_cast<u8>(m_configuration.databits), std::memory_order_relaxed);
+            }
+
+            bool is_closed() const { return m_closing.load(std::memory_order_acquire) || m_endpoint.m_unplugged.load(std::memory_order_acquire); }
+
+            std::shared_ptr<VirtualPair> m_pair;
+            VirtualEndpoint &m_endpoint;
+            // start(), stop() and the setters serialise on m_control_mutex; read(), write() and delivery never take it
+            std::mutex m_control_mutex;
+            Configuration m_configuration;
+            // what write() needs from m_configuration, readable without the lock
+            std::atomic<i64> m_byte_time_ns{0};
+            std::atomic<u8> m_data_bits{8};
+            std::function<void()> m_connected_callback;
+            std::function<void()> m_disconnected_callback;
+            std::function<void(const Handle, const u8 *, const size_t)> m_read_callback;
+            std::vector<std::function<void(const Handle, const RxBuffer &)>> m_read_buffer_callbacks;
+            BufferPool *m_rx_pool{nullptr};
+            std::thread *m_uart_read_thread{nullptr};
+            // set for the thread of one start(), which may outlive the stop() that detached it from its own callback
+            std::shared_ptr<std::atomic<bool>> m_stop_requested;
+            std::atomic<bool> m_stopping{false};
+            std::atomic<bool> m_closing{false};
+        };
+        __internal__ SlotMap<UARTPort> s_com_ports;
+        __internal__ thread_local bool t_on_rx_thread{false};
+
+        /* START: VIRTUAL PORTS */
+        __internal__ void call_link_callbacks(const Handle (&in_handles)[2], bool in_connected)
+        {
+            for (const Handle handle : in_handles)
+            {
+                if (auto found = s_com_ports.pin(handle))
+                {
+                    std::function<void()> link_callback;
+                    {
+                        std::lock_guard lock{found->m_control_mutex};
+                        link_callback = in_connected ? found->m_connected_callback : found->m_disconnected_callback;
+                    }
+                    if (nullptr != link_callback)
+                    {
+                        link_callback();
+                    }
+                }
+            }
+        }
+
+        // Plugs or pulls the cable of the pair in_handle is open on. Both ends' callbacks run when the state changes
+        __internal__ OmegaStatus set_linked(Handle in_handle, bool in_linked)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                Handle open_handles[2]{INVALID_UART_HANDLE, INVALID_UART_HANDLE};
+                {
+                    std::lock_guard lock{s_pairs_mutex};
+                    if (uart_port.is_closed())
+                    {
+                        OMEGA_LOGE("Virtual port %s is closed", uart_port.m_endpoint.m_name);
+                        return eFAILED;
+                    }
+                    if (in_linked == uart_port.m_pair->m_linked.exchange(in_linked, std::memory_order_acq_rel))
+                    {
+                        return eSUCCESS;
+                    }
+                    for (size_t idx = 0; idx < 2; ++idx)
+                    {
+                        open_handles[idx] = uart_port.m_pair->m_ends[idx].m_handle;
+                    }
+                }
+                // writers waiting for room on a full line drop the rest of their bytes
+                for (auto &end : uart_port.m_pair->m_ends)
+                {
+                    wake(end.m_rx);
+                }
+                call_link_callbacks(open_handles, in_linked);
+                return eSUCCESS;
+            }
+            OMEGA_LOGE("Invalid handle");
+            return eFAILED;
+        }
+
+        OmegaStatus create_virtual_pair(const char *in_first, const char *in_second)
+        {
+            const char *names[2]{in_first, in_second};
+            for (const char *name : names)
+            {
+                if (nullptr == name || 0 == std::strlen(name) || VIRTUAL_PORT_NAME_SIZE < std::strlen(name))
+                {
+                    OMEGA_LOGE("Invalid virtual port name, it needs 1 to %zu characters", VIRTUAL_PORT_NAME_SIZE);
+                    return eFAILED;
+                }
+            }
+            if (0 == std::strcmp(in_first, in_second))
+            {
+                OMEGA_LOGE("Both ends of a virtual pair need their own name");
+                return eFAILED;
+            }
+            std::lock_guard lock{s_pairs_mutex};
+            for (const char *name : names)
+            {
+                VirtualEndpoint *existing = nullptr;
+                if (nullptr != find_pair(name, &existing))
+                {
+                    OMEGA_LOGE("Virtual port %s already exists", name);
+                    return eFAILED;
+                }
+            }
+            auto pair = std::make_shared<VirtualPair>();
+            for (size_t idx = 0; idx < 2; ++idx)
+            {
+                UNUSED(std::strncpy(pair->m_ends[idx].m_name, names[idx], VIRTUAL_PORT_NAME_SIZE));
+                pair->m_ends[idx].m_peer = &pair->m_ends[1 - idx];
+            }
+            s_pairs.push_back(std::move(pair));
+            return eSUCCESS;
+        }
+
+        OmegaStatus destroy_virtual_pair(const char *in_port)
+        {
+            if (nullptr == in_port)
+            {
+                return eFAILED;
+            }
+            std::shared_ptr<VirtualPair> pair;
+            Handle open_handles[2]{INVALID_UART_HANDLE, INVALID_UART_HANDLE};
+            {
+                std::lock_guard lock{s_pairs_mutex};
+                VirtualEndpoint *endpoint = nullptr;
+                if (pair = find_pair(in_port, &endpoint); nullptr == pair)
+                {
+                    OMEGA_LOGE("Unknown virtual port %s", in_port);
+                    return eFAILED;
+                }
+                std::erase(s_pairs, pair);
+                for (size_t idx = 0; idx < 2; ++idx)
+                {
+                    pair->m_ends[idx].m_unplugged.store(true, std::memory_order_release);
+                    open_handles[idx] = pair->m_ends[idx].m_handle;
+                }
+            }
+            for (auto &end : pair->m_ends)
+            {
+                wake(end.m_rx);
+            }
+            call_link_callbacks(open_handles, false);
+            return eSUCCESS;
+        }
+
+        OmegaStatus set_virtual_line_rate(const char *in_port, bool in_enabled)
+        {
+            std::lock_guard lock{s_pairs_mutex};
+            VirtualEndpoint *endpoint = nullptr;
+            if (nullptr == in_port || nullptr == find_pair(in_port, &endpoint))
+            {
+                OMEGA_LOGE("Unknown virtual port %s", nullptr == in_port ? "" : in_port);
+                return eFAILED;
+            }
+            endpoint->m_line_rate.store(in_enabled, std::memory_order_relaxed);
+            return eSUCCESS;
+        }
+
+        OmegaStatus set_virtual_faults(const char *in_port, const VirtualFaults &in_faults)
+        {
+            std::lock_guard lock{s_pairs_mutex};
+            VirtualEndpoint *endpoint = nullptr;
+            if (nullptr == in_port || nullptr == find_pair(in_port, &endpoint))
+            {
+                OMEGA_LOGE("Unknown virtual port %s", nullptr == in_port ? "" : in_port);
+                return eFAILED;
+            }
+            std::lock_guard line_lock{endpoint->m_rx.m_mutex};
+            endpoint->m_rx.m_faults = in_faults;
+            endpoint->m_rx.m_random.seed(in_faults.seed);
+            return eSUCCESS;
+        }
+        /* END: VIRTUAL PORTS */
+
+        std::vector<EnumeratedUARTPort> get_available_ports()
+        {
+            std::vector<EnumeratedUARTPort> uart_ports;
+            std::lock_guard lock{s_pairs_mutex};
+            for (const auto &pair : s_pairs)
+            {
+                for (const auto &end : pair->m_ends)
+                {
+                    EnumeratedUARTPort uart_port{};
+                    UNUSED(std::strncpy(uart_port.m_port_name, end.m_name, PORT_NAME_SIZE));
+                    UNUSED(snprintf(uart_port.m_friendly_portname, sizeof(uart_port.m_friendly_portname), "Virtual UART (peer %s)", end.m_peer->m_name));
+                    uart_ports.push_back(uart_port);
+                }
+            }
+            return uart_ports;
+        }
+
+        Handle init(const char *in_port, Baudrate in_baudrate, DataBits in_databits, Parity in_parity, StopBits in_stopbits)
+        {
+            if (nullptr == in_port || 0 == std::strlen(in_port))
+            {
+                OMEGA_LOGE("Invalid serial port path");
+                return 0;
+            }
+            std::lock_guard lock{s_pairs_mutex};
+            VirtualEndpoint *endpoint = nullptr;
+            auto pair = find_pair(in_port, &endpoint);
+            if (nullptr == pair)
+            {
+                OMEGA_LOGE("Unknown virtual port %s", in_port);
+                return 0;
+            }
+            if (INVALID_UART_HANDLE != endpoint->m_handle)
+            {
+                OMEGA_LOGE("Virtual port %s is already open", in_port);
+                return 0;
+            }
+            const Handle user_serial_handle = s_com_ports.emplace(std::move(pair), *endpoint, Configuration{in_baudrate, in_databits, in_parity, in_stopbits});
+            if (INVALID_UART_HANDLE == user_serial_handle)
+            {
+                OMEGA_LOGE("No free handle left for %s", in_port);
+                return 0;
+            }
+            endpoint->m_handle = user_serial_handle;
+            return user_serial_handle;
+        }
+
+        OmegaStatus connect(Handle in_handle)
+        {
+            return set_linked(in_handle, true);
+        }
+
+        bool is_connected(Handle in_handle)
+        {
+            if (const auto found = s_com_ports.pin(in_handle))
+            {
+                return !found->m_endpoint.m_unplugged.load(std::memory_order_acquire) && found->m_pair->m_linked.load(std::memory_order_acquire);
+            }
+            return false;
+        }
+
+        Response read(Handle in_handle, u8 *out_buffer, const size_t in_read_bytes, u32 in_timeout_ms)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                auto &line = uart_port.m_endpoint.m_rx;
+                const auto deadline = Clock::now() + std::chrono::milliseconds{in_timeout_ms};
+                size_t read_bytes = 0;
+                std::unique_lock lock{line.m_mutex};
+                for (;;)
+                {
+                    if (uart_port.is_closed())
+                    {
+                        return {eFAILED, read_bytes};
+                    }
+                    const auto now = Clock::now();
+                    const auto arrived = pending(line, now);
+                    if (const size_t chunk = std::min(arrived.m_arrived, in_read_bytes - read_bytes); 0 < chunk)
+                    {
+                        take_bytes(line, out_buffer + read_bytes, chunk);
+                        read_bytes += chunk;
+                        line.m_changed.notify_all();
+                    }
+                    if (read_bytes == in_read_bytes || 0 == in_timeout_ms)
+                    {
+                        break;
+                    }
+                    if (deadline <= now)
+                    {
+                        return {eSUCCESS, read_bytes, true};
+                    }
+                    UNUSED(wait_line(line, lock, std::min(deadline, arrived.m_next_arrival)));
+                }
+                return {eSUCCESS, read_bytes};
+            }
+            return {eSUCCESS, 0};
+        }
+
+        Response write(Handle in_handle, const u8 *in_buffer, const size_t in_write_bytes, u32 in_timeout_ms)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                auto &line = uart_port.m_endpoint.m_peer->m_rx;
+                const auto deadline = 0 == in_timeout_ms ? Clock::time_point::max() : Clock::now() + std::chrono::milliseconds{in_timeout_ms};
+                const std::chrono::nanoseconds byte_time{uart_port.m_endpoint.m_line_rate.load(std::memory_order_relaxed) ? uart_port.m_byte_time_ns.load(std::memory_order_relaxed) : 0};
+                const u8 data_bits = uart_port.m_data_bits.load(std::memory_order_relaxed);
+                size_t written_bytes = 0;
+                std::unique_lock lock{line.m_mutex};
+                while (written_bytes < in_write_bytes)
+                {
+                    if (uart_port.is_closed())
+                    {
+                        return {eFAILED, written_bytes};
+                    }
+                    if (!uart_port.m_pair->m_linked.load(std::memory_order_acquire))
+                    {
+                        // the bytes leave the port and never reach the peer, as with a pulled cable
+                        return {eSUCCESS, in_write_bytes};
+                    }
+                    if (const size_t room = LINE_CAPACITY - line.m_size; 0 < room)
+                    {
+                        const size_t chunk = std::min(room, in_write_bytes - written_bytes);
+                        transmit(line, in_buffer + written_bytes, chunk, byte_time, data_bits);
+                        written_bytes += chunk;
+                        line.m_changed.notify_all();
+                        continue;
+                    }
+                    if (!wait_line(line, lock, deadline))
+                    {
+                        return {eSUCCESS, written_bytes, true};
+                    }
+                }
+                return {eSUCCESS, written_bytes};
+            }
+            return {eSUCCESS, 0};
+        }
+
+        OmegaStatus start(Handle in_handle, const std::function<void(const Handle, const u8 *, const size_t)> in_callback)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                std::lock_guard lock{uart_port.m_control_mutex};
+                if (uart_port.m_closing.load(std::memory_order_acquire))
+                {
+                    return eFAILED;
+                }
+                if (nullptr != uart_port.m_uart_read_thread)
+                {
+                    OMEGA_LOGE("Handle is already started");
+                    return eFAILED;
+                }
+                if (nullptr == uart_port.m_rx_pool)
+                {
+                    if (uart_port.m_rx_pool = BufferPool::create(RX_CHUNK_SIZE, RX_POOL_BLOCK_COUNT); nullptr == uart_port.m_rx_pool)
+                    {
+                        OMEGA_LOGE("RX buffer pool creation failed");
+                        return eFAILED;
+                    }
+                }
+                uart_port.m_read_callback = in_callback;
+                uart_port.m_stop_requested = std::make_shared<std::atomic<bool>>(false);
+                // The pin keeps the port alive until the thread is back from its callbacks, even one that deinitialised it
+                auto uart_read_thread = [in_handle](SlotMap<UARTPort>::Pin in_pinned, std::shared_ptr<std::atomic<bool>> in_stop_requested)
+                {
+                    t_on_rx_thread = true;
+                    auto &in_uart_port = *in_pinned;
+                    auto &line = in_uart_port.m_endpoint.m_rx;
+                    for (;;)
+                    {
+                        RxBuffer rx_buffer;
+                        {
+                            std::unique_lock lock{line.m_mutex};
+                            Pending arrived{};
+                            for (;;)
+                            {
+                                if (in_stop_requested->load(std::memory_order_acquire))
+                                {
+                                    return;
+                                }
+                                if (arrived = pending(line, Clock::now()); 0 < arrived.m_arrived)
+                                {
+                                    break;
+                                }
+                                UNUSED(wait_line(line, lock, arrived.m_next_arrival));
+                            }
+                            rx_buffer = in_uart_port.m_rx_pool->acquire();
+                            if (!rx_buffer)
+                            {
+                                // Every block is still held by a consumer. Drop the bytes instead of stalling the line
+                                u8 discard[RX_CHUNK_SIZE];
+                                take_bytes(line, discard, std::min(arrived.m_arrived, sizeof(discard)));
+                                line.m_changed.notify_all();
+                                continue;
+                            }
+                            const size_t size = std::min(arrived.m_arrived, in_uart_port.m_rx_pool->block_size());
+                            take_bytes(line, BufferPool::writable_data(rx_buffer), size);
+                            BufferPool::set_size(rx_buffer, size);
+                            line.m_changed.notify_all();
+                        }
+                        if (nullptr != in_uart_port.m_read_callback)
+                        {
+                            in_uart_port.m_read_callback(in_handle, rx_buffer.data(), rx_buffer.size());
+                        }
+                        for (const auto &user_callback : in_uart_port.m_read_buffer_callbacks)
+                        {
+                            user_callback(in_handle, rx_buffer);
+                        }
+                    }
+                };
+                uart_port.m_uart_read_thread = new std::thread{uart_read_thread, s_com_ports.pin(in_handle), uart_port.m_stop_requested};
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        Handle change_baudrate(Handle in_handle, Baudrate in_baudrate)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                std::lock_guard lock{found->m_control_mutex};
+                found->m_configuration.baudrate = in_baudrate;
+                found->update_byte_time();
+                return in_handle;
+            }
+            return INVALID_UART_HANDLE;
+        }
+
+        Configuration get_configuration(Handle in_handle)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                std::lock_guard lock{found->m_control_mutex};
+                return found->m_configuration;
+            }
+            return {};
+        }
+
+        void set_configuration(Handle in_handle, const Configuration &in_config)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                std::lock_guard lock{found->m_control_mutex};
+                found->m_configuration = in_config;
+                found->update_byte_time();
+            }
+        }
+
+        OmegaStatus stop(Handle in_handle)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                std::unique_lock lock{uart_port.m_control_mutex, std::defer_lock};
+                if (t_on_rx_thread)
+                {
+                    // whoever holds the lock may be joining this very thread
+                    while (!lock.try_lock())
+                    {
+                        if (uart_port.m_stopping.load(std::memory_order_acquire))
+                        {
+                            return eSUCCESS;
+                        }
+                        std::this_thread::yield();
+                    }
+                }
+                else
+                {
+                    lock.lock();
+                }
+                if (nullptr == uart_port.m_uart_read_thread)
+                {
+                    return eSUCCESS;
+                }
+                uart_port.m_stopping.store(true, std::memory_order_release);
+                uart_port.m_stop_requested->store(true, std::memory_order_release);
+                wake(uart_port.m_endpoint.m_rx);
+                if (std::this_thread::get_id() == uart_port.m_uart_read_thread->get_id())
+                {
+                    // stopped from one of its own callbacks, it returns once the callback does
+                    uart_port.m_uart_read_thread->detach();
+                }
+                else
+                {
+                    uart_port.m_uart_read_thread->join();
+                }
+                delete uart_port.m_uart_read_thread;
+                uart_port.m_uart_read_thread = nullptr;
+                uart_port.m_stopping.store(false, std::memory_order_release);
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        OmegaStatus disconnect(Handle in_handle)
+        {
+            return set_linked(in_handle, false);
+        }
+
+        OmegaStatus deinit(const Handle in_handle)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                if (uart_port.m_closing.exchange(true, std::memory_order_acq_rel))
+                {
+                    // another deinit() got here first
+                    return eFAILED;
+                }
+                UNUSED(stop(in_handle));
+                // read() and write() calls still waiting on either line hold their own pins and give up once woken
+                wake(uart_port.m_endpoint.m_rx);
+                wake(uart_port.m_endpoint.m_peer->m_rx);
+                {
+                    std::lock_guard lock{s_pairs_mutex};
+                    if (in_handle == uart_port.m_endpoint.m_handle)
+                    {
+                        uart_port.m_endpoint.m_handle = INVALID_UART_HANDLE;
+                    }
+                }
+                s_com_ports.erase(in_handle);
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        OmegaStatus add_on_read_buffer_callback(Handle in_handle, std::function<void(const Handle, const RxBuffer &)> in_callback)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                std::lock_guard lock{uart_port.m_control_mutex};
+                // the delivery thread walks the callbacks without a lock
+                if (nullptr != uart_port.m_uart_read_thread)
+                {
+                    OMEGA_LOGE("Read callbacks cannot be added while the handle is started");
+                    return eFAILED;
+                }
+                uart_port.m_read_buffer_callbacks.push_back(in_callback);
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        OmegaStatus set_rx_buffer_pool(Handle in_handle, size_t in_block_size, size_t in_block_count)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                auto &uart_port = *found;
+                std::lock_guard lock{uart_port.m_control_mutex};
+                if (nullptr != uart_port.m_uart_read_thread)
+                {
+                    OMEGA_LOGE("RX buffer pool cannot be changed while the handle is started");
+                    return eFAILED;
+                }
+                auto *rx_pool = BufferPool::create(in_block_size, in_block_count);
+                if (nullptr == rx_pool)
+                {
+                    OMEGA_LOGE("RX buffer pool creation failed");
+                    return eFAILED;
+                }
+                if (nullptr != uart_port.m_rx_pool)
+                {
+                    uart_port.m_rx_pool->retire();
+                }
+                uart_port.m_rx_pool = rx_pool;
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        OmegaStatus add_on_connected_callback(Handle in_handle, std::function<void(void)> in_callback)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                std::lock_guard lock{found->m_control_mutex};
+                found->m_connected_callback = in_callback;
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+
+        OmegaStatus add_on_disconnected_callback(Handle in_handle, std::function<void(void)> in_callback)
+        {
+            if (auto found = s_com_ports.pin(in_handle))
+            {
+                std::lock_guard lock{found->m_control_mutex};
+                found->m_disconnected_callback = in_callback;
+                return eSUCCESS;
+            }
+            return eFAILED;
+        }
+    } // namespace UART
+} // namespace Omega
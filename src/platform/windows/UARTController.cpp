@@ -34,6 +34,7 @@
 
 #include <initguid.h>
 
+#include "OmegaUARTController/SlotMap.hpp"
 #include "OmegaUARTController/UARTController.hpp"
 #include "OmegaUtilityDriver/UtilityDriver.hpp"
 
@@ -68,11 +69,10 @@ namespace Omega
 			std::thread *m_uart_read_thread{nullptr};
 		};
 
-		__internal__ std::unordered_map<Handle, UARTPort> s_com_ports;
+		__internal__ SlotMap<UARTPort> s_com_ports;
 
 		[[nodiscard]] Handle init(const char *in_port, Baudrate in_baudrate, DataBits in_databits, Parity in_parity, StopBits in_stopbits)
 		{
-			__internal__ Handle user_serial_handle = 0;
 			HANDLE serial_handle = 0;
 			char deviceName[PORT_NAME_SIZE + 1]{0};
 			sprintf(deviceName, "\\\\.\\%s", in_port);
@@ -81,7 +81,6 @@ namespace Omega
 				OMEGA_LOGE("Opening Serialport failed. Reason: %s", ERROR_FILE_NOT_FOUND == GetLastError() ? "COMPORT NOT FOUND" : "OPENING COMPORT FAILED");
 				return 0;
 			}
-			user_serial_handle++;
 			UARTPort serial_port{
 				.m_handle = serial_handle,
 				.m_baudrate = in_baudrate,
@@ -91,16 +90,21 @@ namespace Omega
 			};
 			UNUSED(std::strncpy(serial_port.m_port_name, in_port, PORT_NAME_SIZE));
 			serial_port.m_status = UARTStatus::eINITED;
-			UNUSED(s_com_ports.insert({user_serial_handle, serial_port}));
-
+			const Handle user_serial_handle = s_com_ports.emplace(serial_port);
+			if (INVALID_UART_HANDLE == user_serial_handle)
+			{
+				OMEGA_LOGE("No free handle left for %s", in_port);
+				CloseHandle(serial_handle);
+				return 0;
+			}
 			return user_serial_handle;
 		}
 
 		[[nodiscard]] OmegaStatus connect(Handle in_handle)
 		{
-			if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+			if (auto found = s_com_ports.pin(in_handle))
 			{
-				auto &uart_port = s_com_ports.at(in_handle);
+				auto &uart_port = *found;
 
 				DCB dcb_parameters{};
 				if (!GetCommState(uart_port.m_handle, &dcb_parameters))
@@ -160,9 +164,9 @@ namespace Omega
 
 		bool is_connected(Handle in_handle)
 		{
-			if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+			if (auto found = s_com_ports.pin(in_handle))
 			{
-				const auto &uart_port = s_com_ports.at(in_handle);
+				const auto &uart_port = *found;
 				return UARTStatus::eSTARTED == uart_port.m_status || UARTStatus::eCONNECTED == uart_port.m_status || UARTStatus::eSTOPPED == uart_port.m_status;
 			}
 			return false;
@@ -172,9 +176,9 @@ namespace Omega
 		{
 			if (nullptr == in_callback)
 				return eFAILED;
-			if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+			if (auto found = s_com_ports.pin(in_handle))
 			{
-				auto &uart_port = s_com_ports.at(in_handle);
+				auto &uart_port = *found;
 				auto uart_read_thread = [in_handle, in_callback](const UARTPort &in_uart_port)
 				{
 					while (UARTStatus::eSTARTED == in_uart_port.m_status)
@@ -196,9 +200,9 @@ namespace Omega
 
 		[[nodiscard]] Response read(Handle in_handle, u8 *out_buffer, const size_t in_read_bytes, u32 in_timeout_ms)
 		{
-			if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+			if (auto found = s_com_ports.pin(in_handle))
 			{
-				auto &uart_port = s_com_ports.at(in_handle);
+				auto &uart_port = *found;
 				if (UARTStatus::eCONNECTED != uart_port.m_status && UARTStatus::eSTARTED != uart_port.m_status)
 				{
 					OMEGA_LOGE("UART is in Invalid state");
@@ -229,9 +233,9 @@ namespace Omega
 
 		[[nodiscard]] Response write(Handle in_handle, const u8 *in_buffer, const size_t in_write_bytes, u32 in_timeout_ms)
 		{
-			if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+			if (auto found = s_com_ports.pin(in_handle))
 			{
-				auto &uart_port = s_com_ports.at(in_handle);
+				auto &uart_port = *found;
 				if (UARTStatus::eCONNECTED != uart_port.m_status && UARTStatus::eSTARTED != uart_port.m_status)
 				{
 					return {eFAILED, 0};
@@ -261,9 +265,9 @@ namespace Omega
 
 		Handle change_baudrate(Handle in_handle, Baudrate baudrate)
 		{
-			if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+			if (auto found = s_com_ports.pin(in_handle))
 			{
-				auto uart_port = s_com_ports.at(in_handle);
+				auto uart_port = *found;
 				if (const auto state = stop(in_handle); eSUCCESS != state)
 				{
 					OMEGA_LOGE("Stopping UART failed");
@@ -313,9 +317,9 @@ namespace Omega
 
 		Configuration get_configuration(Handle in_handle)
 		{
-			if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+			if (auto found = s_com_ports.pin(in_handle))
 			{
-				auto &uart_port = s_com_ports.at(in_handle);
+				auto &uart_port = *found;
 				return {uart_port.m_baudrate, uart_port.m_databits, uart_port.m_parity, uart_port.m_stopbits};
 			}
 			return {};
@@ -323,9 +327,9 @@ namespace Omega
 
 		void set_configuration(Handle in_handle, const Configuration &in_configuration)
 		{
-			if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+			if (auto found = s_com_ports.pin(in_handle))
 			{
-				auto &uart_port = s_com_ports.at(in_handle);
+				auto &uart_port = *found;
 				uart_port.m_baudrate = in_configuration.baudrate;
 				uart_port.m_databits = in_configuration.databits;
 				uart_port.m_parity = in_configuration.parity;
@@ -345,9 +349,9 @@ namespace Omega
 
 		OmegaStatus stop(Handle in_handle)
 		{
-			if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+			if (auto found = s_com_ports.pin(in_handle))
 			{
-				auto &uart_port = s_com_ports.at(in_handle);
+				auto &uart_port = *found;
 				if (nullptr != uart_port.m_uart_read_thread)
 				{
 					uart_port.m_status = UARTStatus::eSTOPPED;
@@ -362,9 +366,9 @@ namespace Omega
 
 		OmegaStatus disconnect(Handle in_handle)
 		{
-			if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+			if (auto found = s_com_ports.pin(in_handle))
 			{
-				auto &uart_port = s_com_ports.at(in_handle);
+				auto &uart_port = *found;
 				if (nullptr != uart_port.m_uart_read_thread)
 				{
 					uart_port.m_status = UARTStatus::eSTOPPED;
@@ -387,9 +391,9 @@ namespace Omega
 
 		OmegaStatus add_on_connected_callback(Handle in_handle, std::function<void()> in_callback)
 		{
-			if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+			if (auto found = s_com_ports.pin(in_handle))
 			{
-				auto &uart_port = s_com_ports.at(in_handle);
+				auto &uart_port = *found;
 				uart_port.m_connected_callback = in_callback;
 				return eSUCCESS;
 			}
@@ -398,9 +402,9 @@ namespace Omega
 
 		OmegaStatus add_on_disconnected_callback(Handle in_handle, std::function<void()> in_callback)
 		{
-			if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+			if (auto found = s_com_ports.pin(in_handle))
 			{
-				auto &uart_port = s_com_ports.at(in_handle);
+				auto &uart_port = *found;
 				uart_port.m_disconnected_callback = in_callback;
 				return eSUCCESS;
 			}
@@ -409,9 +413,9 @@ namespace Omega
 
 		OmegaStatus deinit(const Handle in_handle)
 		{
-			if (const auto found = s_com_ports.find(in_handle); s_com_ports.end() != found)
+			if (auto found = s_com_ports.pin(in_handle))
 			{
-				auto &uart_port = s_com_ports.at(in_handle);
+				auto &uart_port = *found;
 				if (nullptr != uart_port.m_uart_read_thread)
 				{
 					uart_port.m_status = UARTStatus::eSTOPPED;
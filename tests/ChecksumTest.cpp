@@ -0,0 +1,116 @@
+/**
+ * @file ChecksumTest.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 10:05:51 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: ChecksumTest.cpp
+ * File Created: Saturday, 17th October 2026 10:05:51 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 10:05:51 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "OmegaUARTController/Checksum.hpp"
+
+using namespace Omega::UART::Checksum;
+
+namespace
+{
+    constexpr u8 CHECK_INPUT[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    struct KnownAnswer
+    {
+        Algorithm algorithm;
+        u32 check;      // over "123456789"
+        u32 empty;      // over no bytes
+    };
+
+    // Check values from the CRC catalogue entries the algorithms are defined by
+    constexpr KnownAnswer KNOWN_ANSWERS[] = {
+        {Algorithm::eCRC8, 0xF4, 0x00},
+        {Algorithm::eCRC16_CCITT, 0x29B1, 0xFFFF},
+        {Algorithm::eCRC16_MODBUS, 0x4B37, 0xFFFF},
+        {Algorithm::eCRC32, 0xCBF43926, 0x00000000},
+        {Algorithm::eCRC32C, 0xE3069283, 0x00000000},
+    };
+
+    constexpr Kernel KERNELS[] = {Kernel::eAUTO, Kernel::eSLICING_BY_8, Kernel::ePCLMULQDQ, Kernel::eSSE42};
+
+    class ChecksumTest : public ::testing::TestWithParam<std::tuple<KnownAnswer, Kernel>>
+    {
+    protected:
+        void SetUp() override
+        {
+            if (!is_supported(std::get<0>(GetParam()).algorithm, std::get<1>(GetParam())))
+            {
+                GTEST_SKIP() << "kernel not available for the algorithm on this CPU";
+            }
+        }
+    };
+} // namespace
+
+TEST_P(ChecksumTest, MatchesCheckValue)
+{
+    const auto &[known_answer, kernel] = GetParam();
+    Crc crc{known_answer.algorithm, kernel};
+    EXPECT_EQ(known_answer.empty, crc.value());
+    crc.update(CHECK_INPUT, sizeof(CHECK_INPUT));
+    EXPECT_EQ(known_answer.check, crc.value());
+    crc.reset();
+    EXPECT_EQ(known_answer.empty, crc.value());
+}
+
+// Any split into chunks, at any alignment, gives the same value as the portable kernel over the whole buffer
+TEST_P(ChecksumTest, StreamsAcrossChunkBoundaries)
+{
+    const auto &[known_answer, kernel] = GetParam();
+    std::minstd_rand random{7};
+    std::vector<u8> storage(4096 + 64);
+    for (auto &byte : storage)
+    {
+        byte = static_cast<u8>(random());
+    }
+    for (size_t round = 0; round < 200; ++round)
+    {
+        const size_t offset = random() % 64;
+        const size_t size = random() % 4096;
+        const u8 *data = storage.data() + offset;
+        Crc reference{known_answer.algorithm, Kernel::eSLICING_BY_8};
+        reference.update(data, size);
+        Crc streamed{known_answer.algorithm, kernel};
+        for (size_t position = 0; position < size;)
+        {
+            const size_t chunk = std::min<size_t>(size - position, 1 + random() % 300);
+            streamed.update(data + position, chunk);
+            position += chunk;
+        }
+        ASSERT_EQ(reference.value(), streamed.value()) << "offset " << offset << " size " << size;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Kernels, ChecksumTest, ::testing::Combine(::testing::ValuesIn(KNOWN_ANSWERS), ::testing::ValuesIn(KERNELS)));
+
+// A read holding registers request as it goes on the wire, CRC low byte first
+TEST(ChecksumModbusTest, MatchesRequestOnTheWire)
+{
+    const u8 request[] = {0x01, 0x03, 0x00, 0x00, 0x00, 0x0A};
+    const u32 crc = compute(Algorithm::eCRC16_MODBUS, request, sizeof(request));
+    EXPECT_EQ(0xC5, crc & 0xFF);
+    EXPECT_EQ(0xCD, crc >> 8);
+}
@@ -0,0 +1,198 @@
+/**
+ * @file ConcurrencyStressTest.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 9:48:05 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: ConcurrencyStressTest.cpp
+ * File Created: Saturday, 17th October 2026 9:48:05 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 9:48:05 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "OmegaUARTController/UARTController.hpp"
+
+#include "PtyLoopback.hpp"
+
+using namespace Omega::UART;
+using Omega::UART::Bench::BackgroundLoop;
+using Omega::UART::Bench::PtyLoopback;
+
+namespace
+{
+    constexpr size_t PORT_COUNT{8};
+    constexpr auto STRESS_DURATION{std::chrono::seconds{2}};
+
+    // Ports that get deinitialised and initialised again while every other thread keeps using whatever handle it last saw
+    class ChurnedPorts
+    {
+    public:
+        ChurnedPorts()
+        {
+            for (size_t idx = 0; idx < PORT_COUNT; ++idx)
+            {
+                m_handles[idx].store(open(idx), std::memory_order_release);
+            }
+        }
+        ~ChurnedPorts()
+        {
+            for (auto &handle : m_handles)
+            {
+                if (const Handle closing = handle.exchange(0); 0 != closing)
+                {
+                    (void)deinit(closing);
+                }
+            }
+        }
+
+        Handle handle(size_t in_index) const { return m_handles[in_index % PORT_COUNT].load(std::memory_order_acquire); }
+        const PtyLoopback &pty(size_t in_index) const { return m_ptys[in_index % PORT_COUNT]; }
+        u64 received() const { return m_received.load(std::memory_order_relaxed); }
+
+        void reopen(size_t in_index)
+        {
+            if (const Handle closing = m_handles[in_index].exchange(0, std::memory_order_acq_rel); 0 != closing)
+            {
+                EXPECT_EQ(eSUCCESS, deinit(closing));
+            }
+            m_handles[in_index].store(open(in_index), std::memory_order_release);
+        }
+
+    private:
+        Handle open(size_t in_index)
+        {
+            const Handle handle = init(m_ptys[in_index].name(), 115200);
+            if (0 == handle)
+            {
+                return 0;
+            }
+            // Every read callback also starts or stops its neighbour now and then
+            (void)add_on_read_callback(handle, [this, in_index, calls = u64{0}](const Handle, const u8 *, const size_t in_size) mutable
+                                       {
+                                           m_received.fetch_add(in_size, std::memory_order_relaxed);
+                                           if (0 == ++calls % 4)
+                                           {
+                                               const Handle sibling = this->handle(in_index + 1);
+                                               (void)(0 == calls % 8 ? stop(sibling) : start(sibling));
+                                           } });
+            (void)start(handle);
+            return handle;
+        }
+
+        std::array<PtyLoopback, PORT_COUNT> m_ptys;
+        std::array<std::atomic<Handle>, PORT_COUNT> m_handles;
+        std::atomic<u64> m_received{0};
+    };
+
+    class ConcurrencyStressTest : public ::testing::TestWithParam<IOModel>
+    {
+    protected:
+        void SetUp() override
+        {
+            if (eSUCCESS != set_io_model(GetParam()) || GetParam() != get_io_model())
+            {
+                GTEST_SKIP() << "IO model not available in this build or kernel";
+            }
+        }
+        void TearDown() override
+        {
+            (void)set_io_model(IOModel::eTHREAD_PER_PORT);
+        }
+    };
+} // namespace
+
+// init/deinit, start/stop, read() and write() from several threads at once, with callbacks starting and stopping their
+// neighbours, while traffic flows both ways. Meant to run under -fsanitize=thread, see OMEGA_UART_CONTROLLER_SANITIZE
+TEST_P(ConcurrencyStressTest, ChurnsPortsWhileTrafficFlows)
+{
+    ChurnedPorts ports;
+    for (size_t idx = 0; idx < PORT_COUNT; ++idx)
+    {
+        ASSERT_TRUE(ports.pty(idx).valid());
+        ASSERT_NE(0, ports.handle(idx));
+    }
+    std::atomic<bool> running{true};
+    std::vector<std::thread> threads;
+    const auto spawn = [&threads, &running](u32 in_seed, auto in_body)
+    {
+        threads.emplace_back([&running, in_seed, in_body]() mutable
+                             {
+                                 std::minstd_rand random{in_seed};
+                                 while (running.load(std::memory_order_relaxed))
+                                 {
+                                     in_body(random() % PORT_COUNT);
+                                 } });
+    };
+    spawn(1, [&ports](size_t in_index)
+          {
+              ports.reopen(in_index);
+              std::this_thread::sleep_for(std::chrono::milliseconds{2}); });
+    spawn(2, [&ports](size_t in_index)
+          { (void)start(ports.handle(in_index)); });
+    spawn(3, [&ports](size_t in_index)
+          {
+              (void)stop(ports.handle(in_index));
+              std::this_thread::sleep_for(std::chrono::microseconds{500}); });
+    spawn(4, [&ports](size_t in_index)
+          {
+              u8 buffer[32];
+              (void)read(ports.handle(in_index), buffer, sizeof(buffer), 1); });
+    spawn(5, [&ports](size_t in_index)
+          {
+              const u8 frame[16]{0x5A};
+              (void)write(ports.handle(in_index), frame, sizeof(frame), 1); });
+    {
+        const u8 chunk[64]{0xA5};
+        BackgroundLoop traffic{[&ports, &chunk]
+                               {
+                                   for (size_t idx = 0; idx < PORT_COUNT; ++idx)
+                                   {
+                                       (void)::write(ports.pty(idx).master(), chunk, sizeof(chunk));
+                                       ports.pty(idx).drain();
+                                   }
+                                   std::this_thread::sleep_for(std::chrono::microseconds{200});
+                               }};
+        std::this_thread::sleep_for(STRESS_DURATION);
+        running.store(false, std::memory_order_relaxed);
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+    }
+    EXPECT_LT(0, ports.received());
+}
+
+INSTANTIATE_TEST_SUITE_P(IOModels, ConcurrencyStressTest, ::testing::Values(IOModel::eTHREAD_PER_PORT, IOModel::eREACTOR, IOModel::eIO_URING),
+                         [](const ::testing::TestParamInfo<IOModel> &in_info)
+                         {
+                             switch (in_info.param)
+                             {
+                             case IOModel::eTHREAD_PER_PORT:
+                                 return "ThreadPerPort";
+                             case IOModel::eREACTOR:
+                                 return "Reactor";
+                             case IOModel::eIO_URING:
+                                 return "IoUring";
+                             }
+                             return "Unknown";
+                         });
@@ -0,0 +1,212 @@
+/**
+ * @file FramingTest.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 10:05:51 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: FramingTest.cpp
+ * File Created: Saturday, 17th October 2026 10:05:51 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 10:05:51 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "OmegaUARTController/Framing.hpp"
+
+using namespace Omega::UART;
+using namespace Omega::UART::Framing;
+
+namespace
+{
+    std::vector<u8> encoded(const FrameEncoding &in_encoding, const std::vector<u8> &in_payload)
+    {
+        std::vector<u8> frame(max_encoded_size(in_encoding, in_payload.size()));
+        frame.resize(encode(in_encoding, in_payload.data(), in_payload.size(), frame.data()));
+        return frame;
+    }
+
+    std::vector<u8> counting(u8 in_first, size_t in_size)
+    {
+        std::vector<u8> bytes(in_size);
+        std::iota(bytes.begin(), bytes.end(), in_first);
+        return bytes;
+    }
+} // namespace
+
+TEST(FramingEncodeTest, Cobs)
+{
+    const FrameEncoding cobs{.format = FrameFormat::eCOBS};
+    EXPECT_EQ((std::vector<u8>{0x01, 0x00}), encoded(cobs, {}));
+    EXPECT_EQ((std::vector<u8>{0x01, 0x01, 0x00}), encoded(cobs, {0x00}));
+    EXPECT_EQ((std::vector<u8>{0x01, 0x01, 0x01, 0x00}), encoded(cobs, {0x00, 0x00}));
+    EXPECT_EQ((std::vector<u8>{0x03, 0x11, 0x22, 0x02, 0x33, 0x00}), encoded(cobs, {0x11, 0x22, 0x00, 0x33}));
+    EXPECT_EQ((std::vector<u8>{0x02, 0x11, 0x01, 0x01, 0x01, 0x00}), encoded(cobs, {0x11, 0x00, 0x00, 0x00}));
+    // 254 non-zero bytes fill one block exactly and close with an empty group, the 255th starts a real one
+    auto block = counting(0x01, 254);
+    auto expected = block;
+    expected.insert(expected.begin(), 0xFF);
+    expected.push_back(0x01);
+    expected.push_back(0x00);
+    EXPECT_EQ(expected, encoded(cobs, block));
+    block.push_back(0xFF);
+    expected[expected.size() - 2] = 0x02;
+    expected.back() = 0xFF;
+    expected.push_back(0x00);
+    EXPECT_EQ(expected, encoded(cobs, block));
+}
+
+TEST(FramingEncodeTest, Slip)
+{
+    const FrameEncoding slip{.format = FrameFormat::eSLIP};
+    EXPECT_EQ((std::vector<u8>{0xC0, 0xDB, 0xDC, 0xDB, 0xDD, 0x01, 0xC0}), encoded(slip, {0xC0, 0xDB, 0x01}));
+}
+
+TEST(FramingEncodeTest, DelimiterAndLengthPrefix)
+{
+    EXPECT_EQ((std::vector<u8>{'a', 'b', '\n'}), encoded({.format = FrameFormat::eDELIMITER}, {'a', 'b'}));
+    EXPECT_EQ((std::vector<u8>{0x00, 0x03, 0x01, 0x02, 0x03}), encoded({.format = FrameFormat::eLENGTH_PREFIXED}, {0x01, 0x02, 0x03}));
+    EXPECT_EQ((std::vector<u8>{0x03, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03}),
+              encoded({.format = FrameFormat::eLENGTH_PREFIXED, .length_size = 4, .big_endian = false}, {0x01, 0x02, 0x03}));
+}
+
+class FramingRoundTripTest : public ::testing::TestWithParam<FrameEncoding>
+{
+};
+
+// Frames encoded back to back and fed in random chunk sizes come out whole and in order
+TEST_P(FramingRoundTripTest, DecodesWhatWasEncoded)
+{
+    const FrameEncoding encoding = GetParam();
+    std::minstd_rand random{11};
+    std::vector<std::vector<u8>> sent;
+    std::vector<u8> stream;
+    for (size_t idx = 0; idx < 300; ++idx)
+    {
+        std::vector<u8> payload(1 + random() % 600);
+        for (auto &byte : payload)
+        {
+            byte = static_cast<u8>(random());
+            if (FrameFormat::eDELIMITER == encoding.format && encoding.delimiter == byte)
+            {
+                byte ^= 0x01;
+            }
+        }
+        const auto frame = encoded(encoding, payload);
+        ASSERT_FALSE(frame.empty());
+        stream.insert(stream.end(), frame.begin(), frame.end());
+        sent.push_back(std::move(payload));
+    }
+    std::vector<std::vector<u8>> received;
+    auto decoder = make_decoder(encoding, 1024, [&received](const u8 *in_frame, const size_t in_size)
+                                { received.emplace_back(in_frame, in_frame + in_size); });
+    ASSERT_NE(nullptr, decoder);
+    for (size_t position = 0; position < stream.size();)
+    {
+        const size_t chunk = std::min<size_t>(stream.size() - position, 1 + random() % 700);
+        decoder->feed(stream.data() + position, chunk);
+        position += chunk;
+    }
+    EXPECT_EQ(sent, received);
+    EXPECT_EQ(sent.size(), decoder->statistics().frames);
+}
+
+INSTANTIATE_TEST_SUITE_P(Formats, FramingRoundTripTest,
+                         ::testing::Values(FrameEncoding{.format = FrameFormat::eCOBS}, FrameEncoding{.format = FrameFormat::eSLIP},
+                                           FrameEncoding{.format = FrameFormat::eDELIMITER},
+                                           FrameEncoding{.format = FrameFormat::eLENGTH_PREFIXED},
+                                           FrameEncoding{.format = FrameFormat::eLENGTH_PREFIXED, .length_size = 3},
+                                           FrameEncoding{.format = FrameFormat::eLENGTH_PREFIXED, .length_size = 4, .big_endian = false}));
+
+TEST(FramingDecodeTest, DropsOversizedFrames)
+{
+    std::vector<size_t> sizes;
+    DelimiterDecoder decoder{'\n', 8, [&sizes](const u8 *, const size_t in_size)
+                             { sizes.push_back(in_size); }};
+    const std::string stream = "short\nmuch too long for it\nok\n";
+    decoder.feed(reinterpret_cast<const u8 *>(stream.data()), stream.size());
+    EXPECT_EQ((std::vector<size_t>{5, 2}), sizes);
+    EXPECT_EQ(1, decoder.statistics().oversized);
+}
+
+// COBS frames with zeros every few bytes encode to one byte over their payload, so only the decoded size catches them
+TEST(FramingDecodeTest, LimitsCobsPayloadNotEncodedSize)
+{
+    const FrameEncoding cobs{.format = FrameFormat::eCOBS};
+    std::vector<size_t> sizes;
+    auto decoder = make_decoder(cobs, 508, [&sizes](const u8 *, const size_t in_size)
+                                { sizes.push_back(in_size); });
+    for (const size_t size : {509, 508})
+    {
+        std::vector<u8> payload(size, 0x55);
+        for (size_t idx = 0; idx < size; idx += 100)
+        {
+            payload[idx] = 0x00;
+        }
+        const auto frame = encoded(cobs, payload);
+        decoder->feed(frame.data(), frame.size());
+    }
+    EXPECT_EQ((std::vector<size_t>{508}), sizes);
+    EXPECT_EQ(1, decoder->statistics().oversized);
+}
+
+TEST(FramingDecodeTest, RejectsPrefixWidthsEncodeRejects)
+{
+    for (const u8 length_size : {0, 5, 8})
+    {
+        const FrameEncoding encoding{.format = FrameFormat::eLENGTH_PREFIXED, .length_size = length_size};
+        const u8 payload[]{0x01};
+        u8 frame[16];
+        EXPECT_EQ(0, encode(encoding, payload, sizeof(payload), frame));
+        EXPECT_EQ(nullptr, make_decoder(encoding, 64, nullptr));
+    }
+}
+
+TEST(FramingDecodeTest, CountsMalformedFrames)
+{
+    std::vector<std::vector<u8>> received;
+    CobsDecoder decoder{64, [&received](const u8 *in_frame, const size_t in_size)
+                        { received.emplace_back(in_frame, in_frame + in_size); }};
+    // The first frame's code byte promises four data bytes but the delimiter arrives after one
+    const u8 stream[] = {0x05, 0x11, 0x00, 0x03, 0x11, 0x22, 0x00};
+    decoder.feed(stream, sizeof(stream));
+    EXPECT_EQ((std::vector<std::vector<u8>>{{0x11, 0x22}}), received);
+    EXPECT_EQ(1, decoder.statistics().malformed);
+}
+
+// The vector scanners agree with a plain loop for every alignment and match position
+TEST(FramingScanTest, MatchesScalarSearch)
+{
+    std::vector<u8> storage(512, 0x11);
+    for (size_t offset = 0; offset < 64; ++offset)
+    {
+        for (size_t size : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 200})
+        {
+            const u8 *begin = storage.data() + offset;
+            const u8 *end = begin + size;
+            EXPECT_EQ(end, find_byte(begin, end, 0x7E));
+            EXPECT_EQ(end, find_either(begin, end, 0x7E, 0x7D));
+            for (size_t match = 0; match < size; ++match)
+            {
+                storage[offset + match] = 0x7D;
+                ASSERT_EQ(begin + match, find_byte(begin, end, 0x7D));
+                ASSERT_EQ(begin + match, find_either(begin, end, 0x7E, 0x7D));
+                storage[offset + match] = 0x11;
+            }
+        }
+    }
+}
@@ -0,0 +1,287 @@
+/**
+ * @file IOModelTest.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 9:12:40 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: IOModelTest.cpp
+ * File Created: Saturday, 17th October 2026 9:12:40 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 9:12:40 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "OmegaUARTController/UARTController.hpp"
+
+#include "PtyLoopback.hpp"
+
+using namespace Omega::UART;
+using Omega::UART::Bench::PtyLoopback;
+
+namespace
+{
+    struct LoopbackPort
+    {
+        PtyLoopback pty;
+        Handle handle{pty.valid() ? init(pty.name(), 115200) : 0};
+
+        ~LoopbackPort()
+        {
+            if (0 != handle)
+            {
+                (void)deinit(handle);
+            }
+        }
+    };
+
+    size_t thread_count()
+    {
+        return std::distance(std::filesystem::directory_iterator{"/proc/self/task"}, std::filesystem::directory_iterator{});
+    }
+
+    size_t descriptor_count()
+    {
+        return std::distance(std::filesystem::directory_iterator{"/proc/self/fd"}, std::filesystem::directory_iterator{});
+    }
+
+    bool wait_for(const std::atomic<u64> &in_counter, u64 in_target)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (in_counter.load(std::memory_order_acquire) < in_target)
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    class IOModelTest : public ::testing::TestWithParam<IOModel>
+    {
+    protected:
+        void SetUp() override
+        {
+            if (eSUCCESS != set_io_model(GetParam()) || GetParam() != get_io_model())
+            {
+                GTEST_SKIP() << "IO model not available in this build or kernel";
+            }
+        }
+        void TearDown() override
+        {
+            (void)set_io_model(IOModel::eTHREAD_PER_PORT);
+        }
+    };
+} // namespace
+
+// A handle whose port was deinitialised, even one whose slot was taken by a new port, is rejected
+TEST(HandleTest, RejectsStaleHandle)
+{
+    PtyLoopback pty;
+    ASSERT_TRUE(pty.valid());
+    const Handle stale = init(pty.name(), 115200);
+    ASSERT_NE(0, stale);
+    ASSERT_EQ(eSUCCESS, deinit(stale));
+    LoopbackPort port;
+    ASSERT_NE(0, port.handle);
+    ASSERT_NE(stale, port.handle);
+
+    u8 buffer[4]{0};
+    const Response read_response = read(stale, buffer, sizeof(buffer), 0);
+    EXPECT_EQ(eFAILED, read_response.status);
+    EXPECT_EQ(0, read_response.size);
+    const Response write_response = write(stale, buffer, sizeof(buffer), 0);
+    EXPECT_EQ(eFAILED, write_response.status);
+    EXPECT_EQ(0, write_response.size);
+    EXPECT_EQ(eSUCCESS, write(port.handle, buffer, sizeof(buffer), 0).status);
+}
+
+// Each failure after the tty is opened closes it again
+TEST(HandleTest, FailedInitLeavesNoDescriptor)
+{
+    PtyLoopback pty;
+    ASSERT_TRUE(pty.valid());
+    const size_t descriptors = descriptor_count();
+    // not a tty, so tcgetattr() fails
+    EXPECT_EQ(0, init("/dev/null", 115200));
+    EXPECT_EQ(0, init(pty.name(), 115200, DataBits::eDATA_BITS_8, Parity::ePARITY_DISABLE, StopBits::eSTOP_BITS_1_5));
+    EXPECT_EQ(descriptors, descriptor_count());
+
+    const Handle handle = init(pty.name(), 115200, DataBits::eDATA_BITS_5, Parity::ePARITY_DISABLE, StopBits::eSTOP_BITS_1_5);
+    EXPECT_NE(0, handle);
+    EXPECT_EQ(eSUCCESS, deinit(handle));
+}
+
+TEST(ReactorTest, ServesEveryPortFromOneThread)
+{
+    ASSERT_EQ(eSUCCESS, set_io_model(IOModel::eREACTOR));
+    std::vector<std::unique_ptr<LoopbackPort>> ports;
+    std::atomic<u64> received{0};
+    size_t threads_with_one_port = 0;
+    for (size_t idx = 0; idx < 256; ++idx)
+    {
+        auto &port = *ports.emplace_back(std::make_unique<LoopbackPort>());
+        ASSERT_NE(0, port.handle);
+        ASSERT_EQ(eSUCCESS, start(port.handle, [&received](const Handle, const u8 *, const size_t in_size)
+                                  { received.fetch_add(in_size, std::memory_order_release); }));
+        if (0 == idx)
+        {
+            threads_with_one_port = thread_count();
+        }
+    }
+    EXPECT_EQ(threads_with_one_port, thread_count());
+    const u8 chunk[32]{0x55};
+    for (const auto &port : ports)
+    {
+        ASSERT_TRUE(port->pty.send(chunk, sizeof(chunk)));
+    }
+    EXPECT_TRUE(wait_for(received, ports.size() * sizeof(chunk)));
+    ports.clear();
+    EXPECT_EQ(eSUCCESS, set_io_model(IOModel::eTHREAD_PER_PORT));
+}
+
+// A read callback stopping another handle while its own handle is being stopped from outside
+TEST_P(IOModelTest, StopsAnotherHandleFromAReadCallback)
+{
+    for (size_t round = 0; round < 50; ++round)
+    {
+        LoopbackPort first;
+        LoopbackPort second;
+        ASSERT_NE(0, first.handle);
+        ASSERT_NE(0, second.handle);
+        std::atomic<u64> in_callback{0};
+        ASSERT_EQ(eSUCCESS, add_on_read_callback(first.handle, [&in_callback, &second](const Handle, const u8 *, const size_t)
+                                                 {
+                                                     in_callback.store(1, std::memory_order_release);
+                                                     std::this_thread::sleep_for(std::chrono::milliseconds{2});
+                                                     (void)stop(second.handle);
+                                                     in_callback.store(2, std::memory_order_release); }));
+        ASSERT_EQ(eSUCCESS, start(first.handle));
+        ASSERT_EQ(eSUCCESS, start(second.handle));
+        const u8 byte{0x01};
+        ASSERT_TRUE(first.pty.send(&byte, 1));
+        ASSERT_TRUE(wait_for(in_callback, 1));
+        EXPECT_EQ(eSUCCESS, stop(first.handle));
+        // stop() waits for the callback that was running
+        EXPECT_EQ(2, in_callback.load(std::memory_order_acquire));
+        EXPECT_EQ(eFAILED, stop(second.handle));
+    }
+}
+
+// The tty holds many callbacks' worth of bytes when the first one stops its own handle, and none of the rest is delivered
+TEST_P(IOModelTest, StopsItselfFromAReadCallback)
+{
+    LoopbackPort port;
+    ASSERT_NE(0, port.handle);
+    std::atomic<u64> callbacks{0};
+    ASSERT_EQ(eSUCCESS, add_on_read_callback(port.handle, [&callbacks](const Handle in_handle, const u8 *, const size_t)
+                                             {
+                                                 if (1 == callbacks.fetch_add(1, std::memory_order_acq_rel) + 1)
+                                                 {
+                                                     EXPECT_EQ(eSUCCESS, stop(in_handle));
+                                                 } }));
+    const u8 chunk[2048]{0x33};
+    ASSERT_TRUE(port.pty.send(chunk, sizeof(chunk)));
+    ASSERT_EQ(eSUCCESS, start(port.handle));
+    ASSERT_TRUE(wait_for(callbacks, 1));
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    EXPECT_EQ(1, callbacks.load());
+}
+
+// Restarting from the callback hands the rest of the tty to the new reader, and the old one delivers nothing more
+TEST_P(IOModelTest, RestartsItselfFromAReadCallback)
+{
+    LoopbackPort port;
+    ASSERT_NE(0, port.handle);
+    std::atomic<u64> received{0};
+    std::atomic<u64> restarts{0};
+    std::atomic<u64> overlaps{0};
+    std::atomic<bool> delivering{false};
+    ASSERT_EQ(eSUCCESS, add_on_read_callback(port.handle, [&](const Handle in_handle, const u8 *, const size_t in_size)
+                                             {
+                                                 if (delivering.exchange(true, std::memory_order_acq_rel))
+                                                 {
+                                                     overlaps.fetch_add(1, std::memory_order_relaxed);
+                                                 }
+                                                 received.fetch_add(in_size, std::memory_order_release);
+                                                 delivering.store(false, std::memory_order_release);
+                                                 // a per-port reader started here may deliver before this callback returns
+                                                 if (restarts.load(std::memory_order_relaxed) < 5)
+                                                 {
+                                                     restarts.fetch_add(1, std::memory_order_relaxed);
+                                                     EXPECT_EQ(eSUCCESS, stop(in_handle));
+                                                     std::this_thread::sleep_for(std::chrono::milliseconds{1});
+                                                     EXPECT_EQ(eSUCCESS, start(in_handle));
+                                                 } }));
+    const u8 chunk[2048]{0x44};
+    ASSERT_TRUE(port.pty.send(chunk, sizeof(chunk)));
+    ASSERT_EQ(eSUCCESS, start(port.handle));
+    EXPECT_TRUE(wait_for(received, sizeof(chunk)));
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    EXPECT_EQ(sizeof(chunk), received.load());
+    EXPECT_EQ(5, restarts.load());
+    EXPECT_EQ(0, overlaps.load());
+    EXPECT_EQ(eSUCCESS, stop(port.handle));
+}
+
+// Once stop() returns no callback runs for the handle, even for bytes that arrived right before it
+TEST_P(IOModelTest, NoCallbackAfterStop)
+{
+    LoopbackPort port;
+    ASSERT_NE(0, port.handle);
+    std::atomic<bool> stopped{false};
+    std::atomic<u64> late_callbacks{0};
+    std::atomic<u64> received{0};
+    ASSERT_EQ(eSUCCESS, add_on_read_callback(port.handle, [&](const Handle, const u8 *, const size_t in_size)
+                                             {
+                                                 if (stopped.load(std::memory_order_acquire))
+                                                 {
+                                                     late_callbacks.fetch_add(1, std::memory_order_relaxed);
+                                                 }
+                                                 received.fetch_add(in_size, std::memory_order_release); }));
+    const u8 chunk[64]{0x22};
+    for (size_t round = 0; round < 200; ++round)
+    {
+        ASSERT_EQ(eSUCCESS, start(port.handle));
+        ASSERT_TRUE(port.pty.send(chunk, sizeof(chunk)));
+        ASSERT_EQ(eSUCCESS, stop(port.handle));
+        stopped.store(true, std::memory_order_release);
+        std::this_thread::sleep_for(std::chrono::microseconds{200});
+        stopped.store(false, std::memory_order_release);
+    }
+    EXPECT_EQ(0, late_callbacks.load());
+}
+
+INSTANTIATE_TEST_SUITE_P(IOModels, IOModelTest, ::testing::Values(IOModel::eTHREAD_PER_PORT, IOModel::eREACTOR, IOModel::eIO_URING),
+                         [](const ::testing::TestParamInfo<IOModel> &in_info)
+                         {
+                             switch (in_info.param)
+                             {
+                             case IOModel::eTHREAD_PER_PORT:
+                                 return "ThreadPerPort";
+                             case IOModel::eREACTOR:
+                                 return "Reactor";
+                             case IOModel::eIO_URING:
+                                 return "IoUring";
+                             }
+                             return "Unknown";
+                         });
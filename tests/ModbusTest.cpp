@@ -0,0 +1,257 @@
+/**
+ * @file ModbusTest.cpp
+ * @author Omegaki113r
+ * @date Saturday, 17th October 2026 10:21:37 pm
+ * @copyright Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * */
+/*
+ * Project: OmegaUARTController
+ * File Name: ModbusTest.cpp
+ * File Created: Saturday, 17th October 2026 10:21:37 pm
+ * Author: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Last Modified: Saturday, 17th October 2026 10:21:37 pm
+ * Modified By: Omegaki113r (omegaki113r@gmail.com)
+ * -----
+ * Copyright 2024 - 2026 0m3g4ki113r, Xtronic
+ * -----
+ * HISTORY:
+ * Date      	By	Comments
+ * ----------	---	---------------------------------------------------------
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "OmegaUARTController/Modbus.hpp"
+
+#include "PtyLoopback.hpp"
+
+using namespace Omega::UART;
+using namespace Omega::UART::Modbus;
+using Omega::UART::Bench::BackgroundLoop;
+using Omega::UART::Bench::PtyLoopback;
+
+namespace
+{
+    constexpr u8 DEAD_ADDRESS{9};
+
+    // A master and a slave on two ptys whose masters are bridged like the two ends of a cable. Units 1 to 8 answer with
+    // four holding registers each, others stay silent
+    class ModbusTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            ASSERT_TRUE(m_master_pty.valid() && m_slave_pty.valid());
+            m_master_handle = init(m_master_pty.name(), 115200);
+            m_slave_handle = init(m_slave_pty.name(), 115200);
+            ASSERT_NE(0, m_master_handle);
+            ASSERT_NE(0, m_slave_handle);
+            m_slave = std::make_unique<Slave>(m_slave_handle, [this](u8 in_address, u8 in_function, const u8 *in_data, size_t in_size, std::vector<u8> &out_data)
+                                              { return handle(in_address, in_function, in_data, in_size, out_data); });
+            m_master = std::make_unique<Master>(m_master_handle, MasterConfiguration{.response_timeout_ms = 20, .retries = 1, .turnaround_delay_ms = 10, .backoff_after = 2, .max_backoff_ms = 400});
+            ASSERT_EQ(eSUCCESS, add_on_read_chunk_callback(m_master_handle, m_master->chunk_callback()));
+            ASSERT_EQ(eSUCCESS, add_on_read_chunk_callback(m_slave_handle, m_slave->chunk_callback()));
+            ASSERT_EQ(eSUCCESS, start(m_master_handle));
+            ASSERT_EQ(eSUCCESS, start(m_slave_handle));
+        }
+
+        void TearDown() override
+        {
+            (void)stop(m_master_handle);
+            (void)stop(m_slave_handle);
+            m_master.reset();
+            m_slave.reset();
+            (void)deinit(m_master_handle);
+            (void)deinit(m_slave_handle);
+        }
+
+        u8 handle(u8 in_address, u8 in_function, const u8 *in_data, size_t in_size, std::vector<u8> &out_data)
+        {
+            if (DEAD_ADDRESS <= in_address)
+            {
+                return NO_RESPONSE;
+            }
+            if (BROADCAST_ADDRESS == in_address)
+            {
+                ++m_broadcasts;
+                return 0;
+            }
+            if (static_cast<u8>(FunctionCode::eREAD_HOLDING_REGISTERS) == in_function && 4 == in_size)
+            {
+                out_data = {8};
+                for (const u16 reg : m_registers[in_address])
+                {
+                    out_data.push_back(reg >> 8);
+                    out_data.push_back(reg & 0xFF);
+                }
+                return 0;
+            }
+            if (static_cast<u8>(FunctionCode::eWRITE_SINGLE_REGISTER) == in_function && 4 == in_size)
+            {
+                m_registers[in_address][in_data[1] & 3] = (in_data[2] << 8) | in_data[3];
+                out_data.assign(in_data, in_data + in_size);
+                return 0;
+            }
+            return static_cast<u8>(ExceptionCode::eILLEGAL_FUNCTION);
+        }
+
+        void bridge()
+        {
+            pollfd poll_fds[2] = {{.fd = m_master_pty.master(), .events = POLLIN, .revents = 0}, {.fd = m_slave_pty.master(), .events = POLLIN, .revents = 0}};
+            if (0 >= ::poll(poll_fds, 2, 5))
+            {
+                return;
+            }
+            u8 buffer[512];
+            if (const ssize_t read_bytes = ::read(m_master_pty.master(), buffer, sizeof(buffer)); 0 < read_bytes)
+            {
+                if (0 < m_corrupt_requests.load())
+                {
+                    --m_corrupt_requests;
+                    buffer[read_bytes - 1] ^= 0x55;
+                }
+                m_slave_pty.send(buffer, read_bytes);
+            }
+            if (const ssize_t read_bytes = ::read(m_slave_pty.master(), buffer, sizeof(buffer)); 0 < read_bytes)
+            {
+                m_master_pty.send(buffer, read_bytes);
+            }
+        }
+
+        PtyLoopback m_master_pty;
+        PtyLoopback m_slave_pty;
+        std::atomic<int> m_corrupt_requests{0};
+        std::atomic<int> m_broadcasts{0};
+        u16 m_registers[DEAD_ADDRESS][4]{};
+        Handle m_master_handle{0};
+        Handle m_slave_handle{0};
+        std::unique_ptr<Slave> m_slave;
+        std::unique_ptr<Master> m_master;
+        BackgroundLoop m_bridge{[this]
+                                { bridge(); }};
+    };
+} // namespace
+
+TEST(ModbusFramingTest, TimingAndEncoding)
+{
+    Timing slow = timing(Configuration{9600, DataBits::eDATA_BITS_8, Parity::ePARITY_DISABLE, StopBits::eSTOP_BITS_1});
+    EXPECT_EQ(1042, slow.character_us);
+    EXPECT_EQ(1563, slow.t1_5_us);
+    EXPECT_EQ(3646, slow.t3_5_us);
+    Timing fast = timing(Configuration{115200, DataBits::eDATA_BITS_8, Parity::ePARITY_DISABLE, StopBits::eSTOP_BITS_1});
+    EXPECT_EQ(750, fast.t1_5_us);
+    EXPECT_EQ(1750, fast.t3_5_us);
+
+    u8 adu[MAX_ADU_SIZE];
+    const u8 pdu[] = {0x00, 0x00, 0x00, 0x0A};
+    ASSERT_EQ(8, encode(1, 3, pdu, sizeof(pdu), adu));
+    EXPECT_EQ(0xC5, adu[6]);
+    EXPECT_EQ(0xCD, adu[7]);
+    std::vector<u8> oversized(MAX_ADU_SIZE - 3);
+    EXPECT_EQ(0, encode(1, 16, oversized.data(), oversized.size(), adu));
+}
+
+TEST_F(ModbusTest, Transactions)
+{
+    Result result = m_master->submit(Request{3, 6, {0x00, 0x01, 0x12, 0x34}}).get();
+    ASSERT_EQ(eSUCCESS, result.status);
+    EXPECT_EQ(1, result.attempts);
+    result = m_master->submit(Request{3, 3, {0x00, 0x00, 0x00, 0x04}}).get();
+    ASSERT_EQ(eSUCCESS, result.status);
+    ASSERT_EQ(9, result.data.size());
+    EXPECT_EQ(0x12, result.data[3]);
+    EXPECT_EQ(0x34, result.data[4]);
+
+    result = m_master->submit(Request{3, 0x2B, {0x01}}).get();
+    EXPECT_EQ(eFAILED, result.status);
+    EXPECT_EQ(static_cast<u8>(ExceptionCode::eILLEGAL_FUNCTION), result.exception);
+    EXPECT_FALSE(result.timed_out);
+
+    const auto started = std::chrono::steady_clock::now();
+    result = m_master->submit(Request{DEAD_ADDRESS, 3, {0x00, 0x00, 0x00, 0x04}}).get();
+    EXPECT_EQ(eFAILED, result.status);
+    EXPECT_TRUE(result.timed_out);
+    EXPECT_EQ(2, result.attempts);
+    EXPECT_LE(std::chrono::milliseconds(40), std::chrono::steady_clock::now() - started);
+
+    // The slave drops the corrupted request on its CRC and the retry gets through
+    m_corrupt_requests = 1;
+    result = m_master->submit(Request{4, 3, {0x00, 0x00, 0x00, 0x04}}).get();
+    EXPECT_EQ(eSUCCESS, result.status);
+    EXPECT_EQ(2, result.attempts);
+
+    result = m_master->submit(Request{BROADCAST_ADDRESS, 6, {0x00, 0x00, 0x00, 0x01}}).get();
+    EXPECT_EQ(eSUCCESS, result.status);
+    EXPECT_TRUE(result.data.empty());
+    EXPECT_EQ(1, m_broadcasts.load());
+
+    EXPECT_LE(1, m_slave->statistics().crc_errors);
+    EXPECT_EQ(1, m_slave->statistics().exceptions);
+    EXPECT_EQ(0, m_master->statistics().unexpected);
+}
+
+// Polls of every unit keep going while submitted requests cut in, and the dead unit is backed off
+TEST_F(ModbusTest, PollsInterleaveWithRequests)
+{
+    std::atomic<u32> answered[DEAD_ADDRESS]{};
+    std::atomic<u32> missed{0};
+    std::vector<u64> poll_ids;
+    for (u8 address = 1; address <= DEAD_ADDRESS; ++address)
+    {
+        poll_ids.push_back(m_master->add_poll(Request{address, 3, {0x00, 0x00, 0x00, 0x04}}, 10, [&, address](const Result &in_result)
+                                              {
+                                                  if (eSUCCESS == in_result.status && 9 == in_result.data.size())
+                                                  {
+                                                      ++answered[address];
+                                                  }
+                                                  else if (DEAD_ADDRESS == address && in_result.timed_out)
+                                                  {
+                                                      ++missed;
+                                                  } }));
+        ASSERT_NE(0, poll_ids.back());
+    }
+    for (u8 value = 0; value < 20; ++value)
+    {
+        ASSERT_EQ(eSUCCESS, m_master->submit(Request{5, 6, {0x00, 0x02, 0x00, value}}).get().status);
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    for (const u64 poll_id : poll_ids)
+    {
+        EXPECT_EQ(eSUCCESS, m_master->remove_poll(poll_id));
+    }
+    EXPECT_EQ(eFAILED, m_master->remove_poll(poll_ids.front()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    for (u8 address = 1; address < DEAD_ADDRESS; ++address)
+    {
+        EXPECT_LT(20, answered[address].load()) << "unit " << static_cast<int>(address);
+    }
+    EXPECT_GT(15, missed.load());
+    EXPECT_EQ(19, m_registers[5][2]);
+    EXPECT_EQ(0, m_master->statistics().unexpected);
+    EXPECT_EQ(0, m_master->statistics().gap_errors);
+}
+
+TEST_F(ModbusTest, DestructionFailsOutstandingRequests)
+{
+    std::atomic<int> failed{0};
+    for (int idx = 0; idx < 5; ++idx)
+    {
+        ASSERT_EQ(eSUCCESS, m_master->submit(Request{DEAD_ADDRESS, 3, {0x00, 0x00, 0x00, 0x01}}, [&failed](const Result &in_result)
+                                             {
+                                                 if (eFAILED == in_result.status)
+                                                 {
+                                                     ++failed;
+                                                 } }));
+    }
+    ASSERT_EQ(eSUCCESS, stop(m_master_handle));
+    m_master.reset();
+    EXPECT_EQ(5, failed.load());
+}